@@ -0,0 +1,145 @@
+#include "pch.h"
+#include "exportmanifest.h"
+
+CExportManifest g_exportManifest;
+
+bool CExportManifest::IsUnchanged(const ExportManifestEntry_t& entry) const
+{
+	std::vector<std::string> outputs;
+
+	{
+		std::shared_lock<std::shared_mutex> lock(m_manifestMutex);
+
+		const auto it = m_entries.find(entry.guid);
+		if (it == m_entries.end() || !(it->second.entry == entry))
+			return false;
+
+		outputs = it->second.outputs;
+	}
+
+	// nothing we know of was written, so there's nothing to check against
+	if (outputs.empty())
+		return false;
+
+	// a file was deleted since, export it again
+	std::error_code error;
+	for (const std::string& output : outputs)
+	{
+		if (!std::filesystem::exists(output, error))
+			return false;
+	}
+
+	return true;
+}
+
+bool CExportManifest::SaveToFile(const std::string& path)
+{
+	std::shared_lock<std::shared_mutex> lock(m_manifestMutex);
+
+	ExportManifestHeader_t header = {};
+
+	header.fileVersion = EXPORT_MANIFEST_FILE_VERSION;
+	header.numEntries = static_cast<uint32_t>(m_entries.size());
+	header.settingsHash = m_settingsHash;
+
+	StreamIO manifestFile;
+	if (!manifestFile.open(path, eStreamIOMode::Write))
+	{
+		Log("MANIFEST: Failed to open export manifest file: \"%s\" for writing\n", path.c_str());
+		return false;
+	}
+
+	manifestFile.write(header);
+
+	for (auto& it : m_entries)
+	{
+		manifestFile.write(it.second.entry);
+
+		uint32_t numOutputs = static_cast<uint32_t>(it.second.outputs.size());
+		manifestFile.write(numOutputs);
+
+		for (const std::string& output : it.second.outputs)
+			manifestFile.writeString(output);
+	}
+
+	manifestFile.close();
+
+	return true;
+}
+
+bool CExportManifest::LoadFromFile(const std::string& path, const uint64_t settingsHash)
+{
+	Clear();
+
+	std::unique_lock<std::shared_mutex> lock(m_manifestMutex);
+	m_settingsHash = settingsHash;
+
+	if (!std::filesystem::exists(path))
+		return true;
+
+	StreamIO manifestFile;
+	if (!manifestFile.open(path, eStreamIOMode::Read))
+		return false;
+
+	ExportManifestHeader_t header = {};
+	if (manifestFile.size() < sizeof(ExportManifestHeader_t))
+		return false;
+
+	manifestFile.read(header);
+
+	if (header.fileVersion != EXPORT_MANIFEST_FILE_VERSION)
+	{
+		Log("MANIFEST: Failed to load export manifest file: \"%s\". Invalid version\n", path.c_str());
+		return false;
+	}
+
+	// export settings changed since the last export, so none of the previous files can be trusted
+	if (header.settingsHash != settingsHash)
+		return true;
+
+	// size() seeks around the stream, so only ask once
+	const size_t fileSize = manifestFile.size();
+
+	if (fileSize < sizeof(ExportManifestHeader_t) + ((sizeof(ExportManifestEntry_t) + sizeof(uint32_t)) * header.numEntries))
+	{
+		Log("MANIFEST: Failed to load export manifest file: \"%s\". File is truncated\n", path.c_str());
+		return false;
+	}
+
+	m_entries.reserve(header.numEntries);
+	for (uint32_t i = 0; i < header.numEntries; i++)
+	{
+		Record_t record = {};
+		manifestFile.read(record.entry);
+
+		uint32_t numOutputs = 0u;
+		manifestFile.read(numOutputs);
+
+		// every path takes at least its terminator, so this can't be more than the size of the file
+		if (numOutputs > fileSize)
+		{
+			Log("MANIFEST: Failed to load export manifest file: \"%s\". File is truncated\n", path.c_str());
+
+			m_entries.clear();
+			return false;
+		}
+
+		record.outputs.resize(numOutputs);
+		for (std::string& output : record.outputs)
+			manifestFile.readString(output);
+
+		if (manifestFile.eof())
+		{
+			Log("MANIFEST: Failed to load export manifest file: \"%s\". File is truncated\n", path.c_str());
+
+			m_entries.clear();
+			return false;
+		}
+
+		m_entries.emplace(record.entry.guid, std::move(record));
+	}
+
+	manifestFile.close();
+
+	return true;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+constexpr int EXPORT_MANIFEST_FILE_VERSION = 2;
+
+#pragma pack(push, 1)
+struct ExportManifestHeader_t
+{
+	uint32_t fileVersion;
+	uint32_t numEntries; // entries immediately follow the header, each one followed by its output count (uint32) and null terminated output paths
+
+	uint64_t settingsHash; // hash of the global export settings, if these change every asset has to be exported again
+};
+
+// everything that decides what an exported asset looks like, if all of these match the last export the files on disk are still valid
+struct ExportManifestEntry_t
+{
+	uint64_t guid;
+	uint64_t pakCrc; // crc of the pak the asset was loaded from
+
+	int64_t starpakOffset;
+	int64_t optStarpakOffset;
+
+	uint64_t dependencyHash; // guids and pak crcs of every asset this one depends on, exports like models also write out their dependencies
+
+	uint32_t type;
+	int32_t majorVer;
+	int32_t minorVer;
+	int32_t exportSetting;
+
+	bool operator==(const ExportManifestEntry_t& other) const
+	{
+		return guid == other.guid && pakCrc == other.pakCrc && starpakOffset == other.starpakOffset && optStarpakOffset == other.optStarpakOffset && dependencyHash == other.dependencyHash
+			&& type == other.type && majorVer == other.majorVer && minorVer == other.minorVer && exportSetting == other.exportSetting;
+	}
+};
+#pragma pack(pop)
+
+class CExportManifest
+{
+public:
+	bool SaveToFile(const std::string& path);
+	bool LoadFromFile(const std::string& path, const uint64_t settingsHash);
+
+	// true if this asset was exported with exactly the same inputs last time, and every file it wrote is still there
+	bool IsUnchanged(const ExportManifestEntry_t& entry) const;
+
+	void Update(const ExportManifestEntry_t& entry, const std::vector<std::string>& outputs)
+	{
+		std::unique_lock<std::shared_mutex> lock(m_manifestMutex);
+		m_entries[entry.guid] = { entry, outputs };
+	}
+
+	void Clear()
+	{
+		std::unique_lock<std::shared_mutex> lock(m_manifestMutex);
+		m_entries.clear();
+	}
+
+private:
+	struct Record_t
+	{
+		ExportManifestEntry_t entry;
+		std::vector<std::string> outputs;
+	};
+
+	std::unordered_map<uint64_t, Record_t> m_entries;
+	uint64_t m_settingsHash;
+
+	mutable std::shared_mutex m_manifestMutex;
+};
+
+extern CExportManifest g_exportManifest;
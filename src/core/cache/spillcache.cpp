@@ -0,0 +1,222 @@
+#include "pch.h"
+#include "spillcache.h"
+
+CSpillCache g_spillCache;
+
+bool CSpillFile::open()
+{
+	if (fileHandle)
+		return true;
+
+	const std::filesystem::path path = std::filesystem::temp_directory_path() / std::format("rsx_spill_{}.bin", GetCurrentProcessId());
+
+	// temporary so the os tries to keep it in cache, deleted as soon as we close it
+	const HANDLE file = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0ul, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		Log("SPILL: Failed to create scratch file \"%s\"\n", path.string().c_str());
+		return false;
+	}
+
+	fileHandle = file;
+	return true;
+}
+
+void CSpillFile::close()
+{
+	const size_t count = segmentCount;
+	for (size_t i = 0; i < count; i++)
+	{
+		UnmapViewOfFile(segments[i].view);
+		CloseHandle(static_cast<HANDLE>(segments[i].mappingHandle));
+	}
+
+	segmentCount = 0ull;
+	freeExtents.clear();
+
+	if (fileHandle)
+	{
+		CloseHandle(static_cast<HANDLE>(fileHandle));
+		fileHandle = nullptr;
+	}
+}
+
+bool CSpillFile::addSegment()
+{
+	const size_t segmentIdx = segmentCount;
+	if (segmentIdx >= maxSegments || !open())
+		return false;
+
+	// mapping past the end of the file grows it
+	const uint64_t fileSize = (segmentIdx + 1ull) * segmentSize;
+	const HANDLE mapping = CreateFileMappingW(static_cast<HANDLE>(fileHandle), nullptr, PAGE_READWRITE, static_cast<DWORD>(fileSize >> 32), static_cast<DWORD>(fileSize & 0xFFFFFFFF), nullptr);
+	if (!mapping)
+	{
+		Log("SPILL: Failed to grow scratch file to %llu bytes\n", fileSize);
+		return false;
+	}
+
+	const uint64_t offset = segmentIdx * segmentSize;
+	void* const view = MapViewOfFile(mapping, FILE_MAP_WRITE, static_cast<DWORD>(offset >> 32), static_cast<DWORD>(offset & 0xFFFFFFFF), segmentSize);
+	if (!view)
+	{
+		CloseHandle(mapping);
+		return false;
+	}
+
+	segments[segmentIdx].mappingHandle = mapping;
+	segments[segmentIdx].view = static_cast<char*>(view);
+
+	freeExtents.emplace(offset, segmentSize);
+	segmentCount++;
+
+	return true;
+}
+
+const uint64_t CSpillFile::Alloc(const size_t size)
+{
+	const size_t alignedSize = IALIGN(size, allocAlignment);
+	if (alignedSize == 0ull || alignedSize > segmentSize)
+		return invalidSpillOffset;
+
+	std::lock_guard<std::mutex> lock(fileMutex);
+
+	// first fit, extents never cross segments
+	auto it = std::find_if(freeExtents.begin(), freeExtents.end(), [alignedSize](const std::pair<const uint64_t, size_t>& extent) { return extent.second >= alignedSize; });
+	if (it == freeExtents.end())
+	{
+		if (!addSegment())
+			return invalidSpillOffset;
+
+		it = std::prev(freeExtents.end());
+	}
+
+	const uint64_t offset = it->first;
+	const size_t remaining = it->second - alignedSize;
+
+	freeExtents.erase(it);
+	if (remaining > 0ull)
+		freeExtents.emplace(offset + alignedSize, remaining);
+
+	return offset;
+}
+
+void CSpillFile::Free(const uint64_t offset, const size_t size)
+{
+	if (offset == invalidSpillOffset)
+		return;
+
+	std::lock_guard<std::mutex> lock(fileMutex);
+
+	uint64_t extentOffset = offset;
+	size_t extentSize = IALIGN(size, allocAlignment);
+
+	// merge with neighbours in the same segment
+	const auto next = freeExtents.find(extentOffset + extentSize);
+	if (next != freeExtents.end() && (next->first % segmentSize) != 0ull)
+	{
+		extentSize += next->second;
+		freeExtents.erase(next);
+	}
+
+	const auto prev = freeExtents.lower_bound(extentOffset);
+	if (prev != freeExtents.begin() && (extentOffset % segmentSize) != 0ull)
+	{
+		const auto before = std::prev(prev);
+		if (before->first + before->second == extentOffset)
+		{
+			extentOffset = before->first;
+			extentSize += before->second;
+			freeExtents.erase(before);
+		}
+	}
+
+	freeExtents.emplace(extentOffset, extentSize);
+}
+
+void CSpillCache::Touch(CRamen* const ramen, const size_t residentSize)
+{
+	std::lock_guard<std::mutex> lock(cacheMutex);
+
+	const auto it = entries.find(ramen);
+	if (it != entries.end())
+	{
+		residentTotal -= it->second.residentSize;
+		lru.splice(lru.begin(), lru, it->second.lruIt);
+
+		it->second.residentSize = residentSize;
+	}
+	else
+	{
+		lru.push_front(ramen);
+		entries.emplace(ramen, Entry_t{ lru.begin(), residentSize });
+	}
+
+	residentTotal += residentSize;
+
+	// spill from the cold end, ramens that are in use can't be spilled and get skipped
+	while (residentTotal > budget)
+	{
+		bool didSpill = false;
+		for (auto victimIt = lru.rbegin(); victimIt != lru.rend(); ++victimIt)
+		{
+			CRamen* const victim = *victimIt;
+			if (victim == ramen || !victim->trySpill())
+				continue;
+
+			const auto entry = entries.find(victim);
+			residentTotal -= entry->second.residentSize;
+
+			lru.erase(entry->second.lruIt);
+			entries.erase(entry);
+
+			didSpill = true;
+			break;
+		}
+
+		if (!didSpill)
+			break;
+	}
+}
+
+void CSpillCache::Remove(CRamen* const ramen)
+{
+	std::lock_guard<std::mutex> lock(cacheMutex);
+
+	const auto it = entries.find(ramen);
+	if (it == entries.end())
+		return;
+
+	residentTotal -= it->second.residentSize;
+
+	lru.erase(it->second.lruIt);
+	entries.erase(it);
+}
+
+void CSpillCache::Replace(CRamen* const from, CRamen* const to)
+{
+	std::lock_guard<std::mutex> lock(cacheMutex);
+
+	const auto it = entries.find(from);
+	if (it == entries.end())
+		return;
+
+	const Entry_t entry = it->second;
+	entries.erase(it);
+
+	*entry.lruIt = to;
+	entries.emplace(to, entry);
+}
+
+const SpillCacheStats_t CSpillCache::GetStats() const
+{
+	SpillCacheStats_t stats = {};
+
+	stats.hits = hits;
+	stats.faults = faults;
+	stats.bytesSpilled = bytesSpilled;
+	stats.bytesFaulted = bytesFaulted;
+	stats.faultTimeUs = faultTimeUs;
+
+	return stats;
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+class CRamen;
+
+// scratch file that cold parsed data gets written out to, mapped in fixed size segments so it can grow without remapping
+class CSpillFile
+{
+public:
+	static constexpr size_t segmentSize = 256ull * 1024ull * 1024ull; // nothing bigger than this can be spilled
+	static constexpr size_t maxSegments = 256ull;
+	static constexpr size_t allocAlignment = 16ull;
+
+	CSpillFile() : fileHandle(nullptr), segmentCount(0ull) {};
+	~CSpillFile()
+	{
+		close();
+	}
+
+	CSpillFile(const CSpillFile&) = delete;
+	CSpillFile& operator=(const CSpillFile&) = delete;
+
+	// returns invalidSpillOffset if there's no room, or the file couldn't be created
+	const uint64_t Alloc(const size_t size);
+	void Free(const uint64_t offset, const size_t size);
+
+	// allocations never cross segments, so the whole range is readable from this pointer
+	char* const Data(const uint64_t offset) const
+	{
+		return segments[offset / segmentSize].view + (offset % segmentSize);
+	}
+
+private:
+	struct Segment_t
+	{
+		void* mappingHandle; // HANDLE
+		char* view;
+	};
+
+	bool open();
+	void close();
+	bool addSegment();
+
+	std::mutex fileMutex;
+
+	void* fileHandle; // HANDLE
+	Segment_t segments[maxSegments];
+	std::atomic<size_t> segmentCount;
+
+	std::map<uint64_t, size_t> freeExtents; // offset, size
+};
+
+struct SpillCacheStats_t
+{
+	uint64_t hits; // accesses to spillable data that was resident
+	uint64_t faults; // accesses that had to read spilled data back in
+	uint64_t bytesSpilled;
+	uint64_t bytesFaulted;
+	uint64_t faultTimeUs; // total time spent faulting data back in
+
+	inline const float HitRate() const { return (hits + faults) > 0ull ? static_cast<float>(hits) / static_cast<float>(hits + faults) : 1.0f; };
+	inline const float AvgFaultTimeUs() const { return faults > 0ull ? static_cast<float>(faultTimeUs) / static_cast<float>(faults) : 0.0f; };
+};
+
+// keeps parsed data (CRamen) under a memory budget, spilling the least recently used ramens to disk
+// a ramen is only tracked if it was created while a budget was set
+class CSpillCache
+{
+public:
+	CSpillCache() : budget(0ull), residentTotal(0ull), hits(0ull), faults(0ull), bytesSpilled(0ull), bytesFaulted(0ull), faultTimeUs(0ull) {};
+
+	// in bytes, zero turns spilling off for ramens created after this
+	inline void SetBudget(const size_t bytes) { budget = bytes; };
+	inline const bool IsEnabled() const { return budget > 0ull; };
+
+	// marks the ramen as most recently used, spilling others if we're over budget
+	void Touch(CRamen* const ramen, const size_t residentSize);
+	void Remove(CRamen* const ramen);
+	void Replace(CRamen* const from, CRamen* const to);
+
+	inline void RecordHit() { hits++; };
+	inline void RecordSpill(const size_t size) { bytesSpilled += size; };
+	inline void RecordFault(const size_t size, const uint64_t timeUs)
+	{
+		faults++;
+		bytesFaulted += size;
+		faultTimeUs += timeUs;
+	}
+
+	const SpillCacheStats_t GetStats() const;
+	inline const size_t ResidentSize() const { return residentTotal; };
+
+	inline CSpillFile* const File() { return &file; };
+
+private:
+	struct Entry_t
+	{
+		std::list<CRamen*>::iterator lruIt;
+		size_t residentSize;
+	};
+
+	std::mutex cacheMutex;
+
+	std::list<CRamen*> lru; // most recently used at the front
+	std::unordered_map<CRamen*, Entry_t> entries;
+
+	std::atomic<size_t> budget;
+	std::atomic<size_t> residentTotal;
+
+	std::atomic<uint64_t> hits;
+	std::atomic<uint64_t> faults;
+	std::atomic<uint64_t> bytesSpilled;
+	std::atomic<uint64_t> bytesFaulted;
+	std::atomic<uint64_t> faultTimeUs;
+
+	CSpillFile file;
+};
+
+extern CSpillCache g_spillCache;
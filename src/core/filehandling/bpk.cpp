@@ -57,7 +57,7 @@ void HandleBPKLoad(std::vector<std::string> filePaths)
                 const std::string tmp = std::format("{}/0x{:X}", "bpkfile", file->GetAssetGUID());
                 file->SetAssetName(tmp);
 
-                g_assetData.v_assets.emplace_back(file->GetAssetGUID(), file);
+                g_assetData.AddAsset(file->GetAssetGUID(), file);
 
                 binding->second.loadFunc(pakfile, file);
             }
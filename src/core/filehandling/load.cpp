@@ -2,6 +2,8 @@
 #include <core/filehandling/load.h>
 #include <core/filehandling/export.h>
 #include <core/utils/cli_parser.h>
+#include <core/cache/spillcache.h>
+#include <thirdparty/imgui/misc/imgui_utility.h>
 
 extern CBufferManager g_BufferManager;
 
@@ -68,6 +70,351 @@ void HandleLoadFromCommandLine(const CCommandLine* const cli)
     CThread(HandleFileLoad, std::move(filePaths)).detach();
 }
 
+// parameters that take a value, any other "--" parameter is rejected and everything else is treated as a file to load
+static const char* const s_headlessValueParams[] = { "--export", "--format", "--out", "--threads", "--spill-budget" };
+static const char* const s_headlessUsage = "usage: rsx <files> --export <types|all> [--format <type=setting;...>] [--out <dir>] [--threads <n>] [--spill-budget <mb>]\n";
+
+static bool IsHeadlessValueParam(const char* const param)
+{
+    for (const char* const valueParam : s_headlessValueParams)
+    {
+        if (strcmp(param, valueParam) == 0)
+            return true;
+    }
+
+    return false;
+}
+
+static std::vector<std::string> SplitHeadlessParam(const char* const value, const char delim)
+{
+    std::vector<std::string> out;
+    if (!value)
+        return out;
+
+    std::stringstream ss(value);
+    std::string token;
+    while (std::getline(ss, token, delim))
+    {
+        if (!token.empty())
+            out.emplace_back(std::move(token));
+    }
+
+    return out;
+}
+
+static bool FindAssetTypeByName(const std::string& name, uint32_t* const outType)
+{
+    for (const auto& it : g_assetData.m_assetTypeBindings)
+    {
+        if (_stricmp(fourCCToString(it.first).c_str(), name.c_str()) == 0)
+        {
+            *outType = it.first;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// "txtr=PNG (All Mips);mdl_=2", settings can be given by name or by index into exportSettingArr
+static bool ParseHeadlessExportFormats(const char* const formats)
+{
+    for (const std::string& entry : SplitHeadlessParam(formats, ';'))
+    {
+        const size_t split = entry.find('=');
+        uint32_t type = 0u;
+        if (split == std::string::npos || !FindAssetTypeByName(entry.substr(0, split), &type))
+        {
+            fprintf(stderr, "invalid export format '%s'\n", entry.c_str());
+            return false;
+        }
+
+        AssetTypeBinding_t& binding = g_assetData.m_assetTypeBindings[type];
+        const std::string setting = entry.substr(split + 1);
+
+        int settingIdx = -1;
+        for (size_t i = 0; i < binding.e.exportSettingArrSize; ++i)
+        {
+            if (_stricmp(binding.e.exportSettingArr[i], setting.c_str()) == 0)
+            {
+                settingIdx = static_cast<int>(i);
+                break;
+            }
+        }
+
+        if (settingIdx == -1 && !setting.empty() && std::all_of(setting.begin(), setting.end(), [](const char c) { return isdigit(static_cast<unsigned char>(c)) != 0; }))
+            settingIdx = atoi(setting.c_str());
+
+        if (settingIdx < 0 || settingIdx >= static_cast<int>(binding.e.exportSettingArrSize))
+        {
+            fprintf(stderr, "invalid export setting '%s' for type '%s'\n", setting.c_str(), fourCCToString(type).c_str());
+            return false;
+        }
+
+        binding.e.exportSetting = settingIdx;
+    }
+
+    return true;
+}
+
+static std::string EscapeJsonString(const std::string& str)
+{
+    std::string out;
+    out.reserve(str.length());
+
+    for (const char c : str)
+    {
+        switch (c)
+        {
+        case '"':
+            out += "\\\"";
+            break;
+        case '\\':
+            out += "\\\\";
+            break;
+        case '\n':
+            out += "\\n";
+            break;
+        default:
+            out += c;
+            break;
+        }
+    }
+
+    return out;
+}
+
+struct HeadlessExportStats_t
+{
+    std::atomic<uint32_t> numExported;
+    std::atomic<uint32_t> numFailed;
+    uint64_t numBytesRead; // starpak data read from disk for assets of this type while exporting
+};
+
+// rsx.exe <files> --export <txtr,matl,...|all> [--format <type=setting;...>] [--out <dir>] [--threads <n>] [--spill-budget <mb>]
+// loads the given files, exports every asset of the requested types without any gui and writes a json summary to stdout and <out>/export_summary.json
+// settings saved from the gui are loaded beforehand, the options above override them for this run only
+int HandleHeadlessExport(const CCommandLine* const cli, const std::filesystem::path& launchDirectory)
+{
+    // release builds are a windows subsystem app, so there is no console to print the summary to unless we attach to the parent's
+    if (_fileno(stdout) < 0 && AttachConsole(ATTACH_PARENT_PROCESS))
+    {
+        FILE* stream = nullptr;
+        freopen_s(&stream, "CONOUT$", "w", stdout);
+        freopen_s(&stream, "CONOUT$", "w", stderr);
+    }
+
+    std::vector<std::string> filePaths;
+    std::vector<std::string> missingPaths;
+    for (int i = 1; i < cli->GetArgC(); ++i)
+    {
+        const char* const param = cli->GetParamValue(i);
+        if (IsHeadlessValueParam(param))
+        {
+            ++i;
+            continue;
+        }
+
+        if (strncmp(param, "--", 2) == 0)
+        {
+            fprintf(stderr, "unknown option '%s'\n", param);
+            fputs(s_headlessUsage, stderr);
+            return EXIT_FAILURE;
+        }
+
+        const std::filesystem::path path = launchDirectory / param;
+        if (std::filesystem::exists(path) && std::filesystem::is_regular_file(path))
+            filePaths.emplace_back(path.string());
+        else
+            missingPaths.emplace_back(param);
+    }
+
+    // types to export, "all" exports every type that has an export binding
+    std::unordered_set<uint32_t> exportTypes;
+    for (const std::string& filter : SplitHeadlessParam(cli->GetParamValue("--export"), ','))
+    {
+        if (_stricmp(filter.c_str(), "all") == 0)
+        {
+            for (const auto& it : g_assetData.m_assetTypeBindings)
+            {
+                if (it.second.e.exportFunc)
+                    exportTypes.insert(it.first);
+            }
+
+            continue;
+        }
+
+        uint32_t type = 0u;
+        if (!FindAssetTypeByName(filter, &type))
+        {
+            fprintf(stderr, "unknown asset type '%s'\n", filter.c_str());
+            return EXIT_FAILURE;
+        }
+
+        exportTypes.insert(type);
+    }
+
+    if (exportTypes.empty() || filePaths.empty())
+    {
+        fputs(s_headlessUsage, stderr);
+        return EXIT_FAILURE;
+    }
+
+    if (!ParseHeadlessExportFormats(cli->GetParamValue("--format")))
+        return EXIT_FAILURE;
+
+    if (const char* const threads = cli->GetParamValue("--threads"))
+    {
+        const uint32_t threadCount = std::max(static_cast<uint32_t>(atoi(threads)), 1u);
+        UtilsConfig->parseThreadCount = threadCount;
+        UtilsConfig->exportThreadCount = threadCount;
+    }
+
+    // has to be set before loading, parsed data only gets tracked if it was created with spilling on
+    if (const char* const spillBudget = cli->GetParamValue("--spill-budget"))
+    {
+        UtilsConfig->parsedDataSpillBudget = static_cast<uint32_t>(atoi(spillBudget));
+        g_spillCache.SetBudget(static_cast<size_t>(UtilsConfig->parsedDataSpillBudget) << 20ull);
+    }
+
+    // exports always go to EXPORT_DIRECTORY_NAME under the working directory
+    const char* const outParam = cli->GetParamValue("--out");
+    const std::filesystem::path outDirectory = outParam ? launchDirectory / outParam : launchDirectory;
+
+    std::error_code ec;
+    std::filesystem::create_directories(outDirectory, ec);
+    std::filesystem::current_path(outDirectory, ec);
+    if (ec)
+    {
+        fprintf(stderr, "failed to use output directory '%s'\n", outDirectory.string().c_str());
+        return EXIT_FAILURE;
+    }
+
+    const auto loadStart = std::chrono::high_resolution_clock::now();
+    HandleFileLoad(filePaths);
+    const auto loadEnd = std::chrono::high_resolution_clock::now();
+
+    std::map<uint32_t, HeadlessExportStats_t> typeStats;
+    for (const uint32_t type : exportTypes)
+        typeStats[type];
+
+    std::mutex failedMutex;
+    std::vector<const CAsset*> failedAssets;
+
+    // starpak reads are counted on the asset that owns the data, so dependencies read by another export land on their own type
+    std::vector<std::pair<const CPakAsset*, uint64_t>> pakAssetBytesRead;
+
+    CParallelTask parallelExportTask(UtilsConfig->exportThreadCount);
+    for (const CGlobalAssetData::AssetLookup_t& lookup : g_assetData.v_assets)
+    {
+        CAsset* const asset = lookup.m_asset;
+
+        const auto statIt = typeStats.find(asset->GetAssetType());
+        if (statIt == typeStats.end())
+            continue;
+
+        const AssetTypeBinding_t& binding = g_assetData.m_assetTypeBindings[asset->GetAssetType()];
+        HeadlessExportStats_t* const stats = &statIt->second;
+
+        if (asset->GetAssetContainerType() == CAsset::ContainerType::PAK)
+        {
+            const CPakAsset* const pakAsset = static_cast<const CPakAsset*>(asset);
+            pakAssetBytesRead.emplace_back(pakAsset, pakAsset->GetStarPakBytesRead());
+        }
+
+        parallelExportTask.addTask([asset, &binding, stats, &failedMutex, &failedAssets]
+            {
+                const bool exported = binding.e.exportFunc(asset, binding.e.exportSetting);
+                asset->SetExportedStatus(exported);
+
+                if (exported)
+                {
+                    stats->numExported++;
+                    return;
+                }
+
+                stats->numFailed++;
+
+                std::unique_lock<std::mutex> lock(failedMutex);
+                failedAssets.emplace_back(asset);
+            }, 1u);
+    }
+
+    g_starpakIOStats.Reset();
+
+    parallelExportTask.execute();
+    parallelExportTask.wait();
+
+    const auto exportEnd = std::chrono::high_resolution_clock::now();
+
+    for (const auto& it : pakAssetBytesRead)
+        typeStats[it.first->GetAssetType()].numBytesRead += it.first->GetStarPakBytesRead() - it.second;
+
+    uint32_t totalExported = 0u;
+    uint32_t totalFailed = 0u;
+
+    std::string summary = "{\n";
+    summary += std::format("  \"loadMs\": {},\n", std::chrono::duration_cast<std::chrono::milliseconds>(loadEnd - loadStart).count());
+    summary += std::format("  \"exportMs\": {},\n", std::chrono::duration_cast<std::chrono::milliseconds>(exportEnd - loadEnd).count());
+    summary += std::format("  \"containers\": {},\n", g_assetData.v_assetContainers.size());
+
+    summary += "  \"types\": {";
+    bool first = true;
+    for (const auto& it : typeStats)
+    {
+        const AssetTypeBinding_t& binding = g_assetData.m_assetTypeBindings[it.first];
+        const uint32_t exported = it.second.numExported;
+        const uint32_t failed = it.second.numFailed;
+
+        totalExported += exported;
+        totalFailed += failed;
+
+        summary += std::format("{}\n    \"{}\": {{ \"setting\": \"{}\", \"exported\": {}, \"failed\": {}, \"starpakBytesRead\": {} }}", first ? "" : ",",
+            EscapeJsonString(fourCCToString(it.first)), binding.e.exportSettingArr ? EscapeJsonString(binding.e.exportSettingArr[binding.e.exportSetting]) : "", exported, failed, it.second.numBytesRead);
+        first = false;
+    }
+    summary += "\n  },\n";
+
+    summary += "  \"missingFiles\": [";
+    first = true;
+    for (const std::string& path : missingPaths)
+    {
+        summary += std::format("{}\n    \"{}\"", first ? "" : ",", EscapeJsonString(path));
+        first = false;
+    }
+    summary += "\n  ],\n";
+
+    summary += "  \"failedAssets\": [";
+    first = true;
+    for (const CAsset* const asset : failedAssets)
+    {
+        summary += std::format("{}\n    {{ \"type\": \"{}\", \"guid\": \"0x{:X}\", \"name\": \"{}\" }}", first ? "" : ",",
+            EscapeJsonString(fourCCToString(asset->GetAssetType())), asset->GetAssetGUID(), EscapeJsonString(asset->GetAssetName()));
+        first = false;
+    }
+    summary += "\n  ],\n";
+
+    if (g_spillCache.IsEnabled())
+    {
+        const SpillCacheStats_t spillStats = g_spillCache.GetStats();
+        summary += std::format("  \"spill\": {{ \"hitRate\": {:.4f}, \"faults\": {}, \"bytesSpilled\": {}, \"bytesFaulted\": {}, \"avgFaultUs\": {:.1f} }},\n",
+            spillStats.HitRate(), spillStats.faults, spillStats.bytesSpilled, spillStats.bytesFaulted, spillStats.AvgFaultTimeUs());
+    }
+
+    summary += std::format("  \"starpakIO\": {{ \"opens\": {}, \"reads\": {}, \"bytesRead\": {}, \"bytesMapped\": {} }},\n", g_starpakIOStats.numOpens.load(), g_starpakIOStats.numReads.load(), g_starpakIOStats.numBytesRead.load(), g_starpakIOStats.numBytesMapped.load());
+    summary += std::format("  \"exported\": {},\n", totalExported);
+    summary += std::format("  \"failed\": {}\n", totalFailed);
+    summary += "}\n";
+
+    fputs(summary.c_str(), stdout);
+    fflush(stdout);
+
+    std::ofstream summaryFile(outDirectory / "export_summary.json", std::ios::out | std::ios::trunc);
+    summaryFile << summary;
+
+    return (totalFailed > 0u || !missingPaths.empty() || g_assetData.v_assetContainers.empty()) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
 void HandleOpenFileDialog(const HWND windowHandle)
 {
     // We are in pak load now.
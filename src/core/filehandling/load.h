@@ -3,6 +3,7 @@
 class CCommandLine;
 
 void HandleLoadFromCommandLine(const CCommandLine* const cli);
+int HandleHeadlessExport(const CCommandLine* const cli, const std::filesystem::path& launchDirectory);
 void HandlePakLoad(std::vector<std::string> filePaths);
 void HandleMBNKLoad(std::vector<std::string> filePaths);
 void HandleMDLLoad(std::vector<std::string> filePaths);
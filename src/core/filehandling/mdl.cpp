@@ -64,7 +64,7 @@ void HandleMDLLoad(std::vector<std::string> filePaths)
 
         srcMdlSource->SetFilePath(path);
 
-        g_assetData.v_assets.emplace_back(srcMdlAsset->GetAssetGUID(), srcMdlAsset);
+        g_assetData.AddAsset(srcMdlAsset->GetAssetGUID(), srcMdlAsset);
         g_assetData.v_assetContainers.emplace_back(srcMdlSource);
         guids.push_back(srcMdlAsset->GetAssetGUID());
 
@@ -96,7 +96,7 @@ void HandleMDLLoad(std::vector<std::string> filePaths)
                 CSourceSequenceAsset* srcSeqAsset = new CSourceSequenceAsset(srcMdlAsset, pSeqdesc, seqPath);
 
                 const uint64_t guid = srcSeqAsset->GetAssetGUID();
-                g_assetData.v_assets.emplace_back(guid, srcSeqAsset);
+                g_assetData.AddAsset(guid, srcSeqAsset);
                 guids.push_back(guid);
 
                 sequences[i] = guid;
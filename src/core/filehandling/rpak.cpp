@@ -6,6 +6,106 @@
 #include <core/filehandling/export.h>
 
 #include <game/rtech/cpakfile.h>
+#include <core/cache/exportmanifest.h>
+
+extern ExportSettings_t g_ExportSettings;
+
+// limits how much pak data and how many paks are being loaded at once, so loading a whole directory doesn't run out of memory.
+// acquire is only called by the thread handing out the loads, never from a pool task, so a task is never stuck waiting on budget held further up its own stack
+class CPakLoadBudget
+{
+public:
+    CPakLoadBudget(const uint64_t budget, const uint32_t maxLoads) : budgetBytes(budget), usedBytes(0ull), maxActiveLoads(std::max(maxLoads, 1u)), activeLoads(0u) {};
+
+    void acquire(const uint64_t numBytes)
+    {
+        std::unique_lock<std::mutex> lock(budgetMutex);
+
+        // a pak bigger than the whole budget still has to load, it just loads on its own
+        budgetCondition.wait(lock, [this, numBytes]() { return activeLoads < maxActiveLoads && (usedBytes == 0ull || usedBytes + numBytes <= budgetBytes); });
+        usedBytes += numBytes;
+        activeLoads++;
+    }
+
+    void release(const uint64_t numBytes)
+    {
+        {
+            std::unique_lock<std::mutex> lock(budgetMutex);
+            usedBytes -= numBytes;
+            activeLoads--;
+        }
+
+        budgetCondition.notify_all();
+    }
+
+private:
+    std::mutex budgetMutex;
+    std::condition_variable budgetCondition;
+
+    const uint64_t budgetBytes;
+    uint64_t usedBytes;
+
+    const uint32_t maxActiveLoads;
+    uint32_t activeLoads;
+};
+
+// claims the pak's crc before anything is loaded, so two copies of the same pak never load at the same time
+static const bool ClaimPakFileLoad(const std::filesystem::path& path)
+{
+    CPakFile::FileHeaderInfo_t info = {};
+    if (!CPakFile::ReadFileHeaderInfo(path.string(), &info))
+        return true; // let the load fail and report it
+
+    if (info.crc == 0ull || g_assetData.ClaimPakLoad(info.crc))
+        return true;
+
+    Log("Pakfile '%s' failed to load because its CRC was already recorded as being loaded.\n", path.string().c_str());
+    return false;
+}
+
+static const uint64_t GetPakLoadMemoryBudget()
+{
+    MEMORYSTATUSEX memoryStatus = {};
+    memoryStatus.dwLength = sizeof(MEMORYSTATUSEX);
+
+    // half of what is free right now, loaded paks stay in memory so we can't use all of it
+    if (GlobalMemoryStatusEx(&memoryStatus))
+        return memoryStatus.ullAvailPhys >> 1;
+
+    return 0x100000000ull; // 4GB
+}
+
+// rough peak size of a pak while it is loading: every file in its patch chain gets decompressed, then they are all combined into one more buffer.
+// compressed data is only read through a small window, so it isn't counted
+static const uint64_t EstimatePakLoadSize(const std::filesystem::path& path)
+{
+    CPakFile::FileHeaderInfo_t info = {};
+    if (!CPakFile::ReadFileHeaderInfo(path.string(), &info))
+        return 0ull;
+
+    uint64_t chainSize = info.dcmpSize;
+
+    // the header only has the number of patch files under this one, not which, so count the newest ones that exist
+    const std::string pakStem = GetPakFileStemNoPatchNum(path);
+    const std::string fileStem = path.stem().string();
+    const int patchNum = fileStem.length() > pakStem.length() ? atoi(fileStem.c_str() + pakStem.length() + 1) : 0;
+
+    int numPatchFiles = 0;
+    for (int i = patchNum - 1; i >= 0 && numPatchFiles < info.patchCount; --i)
+    {
+        const std::string patchSuffix = i == 0 ? "" : std::format("({:02})", i);
+        const std::filesystem::path patchPath = std::filesystem::path(path).replace_filename(std::format("{}{}.rpak", pakStem, patchSuffix));
+
+        CPakFile::FileHeaderInfo_t patchInfo = {};
+        if (!CPakFile::ReadFileHeaderInfo(patchPath.string(), &patchInfo))
+            continue;
+
+        chainSize += patchInfo.dcmpSize;
+        numPatchFiles++;
+    }
+
+    return chainSize * 2ull;
+}
 
 void HandlePakLoad(std::vector<std::string> filePaths)
 {
@@ -18,6 +118,10 @@ void HandlePakLoad(std::vector<std::string> filePaths)
     g_assetData.m_patchMasterEntries.clear();
     g_assetData.m_pakLoadStatusMap.clear();
 
+    // resolve patch_master and the highest patch for every pak first, this has to happen before any pak is loaded
+    std::vector<std::filesystem::path> pakPaths;
+    pakPaths.reserve(filePaths.size());
+
     for (const std::string& path : filePaths)
     {
         std::filesystem::path fsPath = path;
@@ -32,14 +136,7 @@ void HandlePakLoad(std::vector<std::string> filePaths)
             {
                 // [rika]: prevent double load on patch_master and catch if it fails to load
                 g_assetData.m_pakPatchMaster = new CPakFile();
-                if (static_cast<CPakFile*>(g_assetData.m_pakPatchMaster)->ParseFileBuffer(patchMasterPath.string()))
-                {
-                    const CPakFile* const pak = static_cast<CPakFile*>(g_assetData.m_pakPatchMaster);
-
-                    if (pak->header()->crc != 0)
-                        g_assetData.m_pakLoadStatusMap.emplace(pak->header()->crc, true);
-                }
-                else
+                if (!ClaimPakFileLoad(patchMasterPath) || !static_cast<CPakFile*>(g_assetData.m_pakPatchMaster)->ParseFileBuffer(patchMasterPath.string()))
                 {
                     assertm(false, "Parsing patch_master from file failed.");
                     delete g_assetData.m_pakPatchMaster;
@@ -69,20 +166,72 @@ void HandlePakLoad(std::vector<std::string> filePaths)
             }
         }
 
-        if (CPakFile* const pak = new CPakFile(); pak->ParseFileBuffer(fsPath.string()))
+        // several requested files can resolve to the same top patch, only load it once
+        if (std::ranges::find(pakPaths, fsPath) != pakPaths.end())
         {
-            if(pak->header()->crc != 0)
-                g_assetData.m_pakLoadStatusMap.emplace(pak->header()->crc, true);
-
-            g_assetData.v_assetContainers.emplace_back(pak);
+            ++pakLoadingProgress;
+            continue;
         }
-        else
+
+        pakPaths.emplace_back(std::move(fsPath));
+    }
+
+    // paks don't depend on each other, so load them in parallel. the crc map de-duplicates anything that is still loaded twice
+    std::vector<CPakFile*> loadedPaks(pakPaths.size(), nullptr);
+    CPakLoadBudget loadBudget(GetPakLoadMemoryBudget(), UtilsConfig->parseThreadCount);
+
+    // loads are handed out from here as budget frees up, so the pool tasks themselves never wait for it
+    CTaskGroup loadGroup;
+    for (size_t i = 0; i < pakPaths.size(); ++i)
+    {
+        if (!ClaimPakFileLoad(pakPaths[i]))
         {
-            //assertm(false, "Parsing pak from file failed.");
-            delete pak;
+            ++pakLoadingProgress;
+            continue;
         }
-        ++pakLoadingProgress;
+
+        const uint64_t loadSize = EstimatePakLoadSize(pakPaths[i]);
+        loadBudget.acquire(loadSize);
+
+        loadGroup.run([i, loadSize, &pakPaths, &loadedPaks, &loadBudget, &pakLoadingProgress]
+            {
+                const std::filesystem::path& fsPath = pakPaths[i];
+
+                const auto loadStart = std::chrono::high_resolution_clock::now();
+
+                if (CPakFile* const pak = new CPakFile(); pak->ParseFileBuffer(fsPath.string()))
+                {
+                    const double loadTime = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - loadStart).count();
+                    const PakLoadTimes_t& times = pak->loadTimes();
+
+                    // anything that isn't reading, decompressing or processing assets is patching
+                    const double patchTime = std::max(loadTime - times.readMs - times.decompressMs - times.processMs, 0.0);
+
+                    Log("loaded pak '%s' in %.3fms (read %.3fms, decompress %.3fms, patch %.3fms, process %.3fms)\n",
+                        fsPath.filename().string().c_str(), loadTime, times.readMs, times.decompressMs, patchTime, times.processMs);
+
+                    loadedPaks[i] = pak;
+                }
+                else
+                {
+                    //assertm(false, "Parsing pak from file failed.");
+                    delete pak;
+                }
+
+                loadBudget.release(loadSize);
+                ++pakLoadingProgress;
+            });
+    }
+
+    loadGroup.wait();
+
+    // add in the order the paks were requested
+    for (CPakFile* const pak : loadedPaks)
+    {
+        if (pak)
+            g_assetData.v_assetContainers.emplace_back(pak);
     }
+
     g_pImGuiHandler->FinishProgressBarEvent(pakLoadProgress);
 }
 
@@ -114,19 +263,127 @@ static void TraverseAssetDependencies(CPakAsset* const asset, std::deque<CPakAss
         cpyAssets.emplace_back(asset);
 }
 
-static void HandleExportBindingForAssetEx(CAsset* const asset)
+// folds the guid and pak crc of every asset this one depends on (and what those depend on) into a hash.
+// dependencies that aren't loaded still add their guid, so loading them later changes the hash
+static void HashAssetDependencies(CPakAsset* const asset, std::unordered_set<uint64_t>& visited, uint64_t& hash)
+{
+    std::vector<AssetGuid_t> dependencies;
+    asset->getDependencies(dependencies);
+
+    for (const AssetGuid_t& guid : dependencies)
+    {
+        if (!visited.emplace(guid.guid).second)
+            continue;
+
+        CPakAsset* const depAsset = g_assetData.FindAssetByGUID<CPakAsset>(guid.guid);
+
+        const uint64_t values[] = {
+            guid.guid,
+            depAsset ? depAsset->getPakCRC() : 0ull,
+            depAsset ? static_cast<uint64_t>(depAsset->data()->starpakOffset) : 0ull,
+            depAsset ? static_cast<uint64_t>(depAsset->data()->optStarpakOffset) : 0ull,
+        };
+
+        for (const uint64_t value : values)
+        {
+            hash ^= value;
+            hash *= 0x100000001b3ull;
+        }
+
+        if (depAsset)
+            HashAssetDependencies(depAsset, visited, hash);
+    }
+}
+
+static ExportManifestEntry_t GetExportManifestEntry(CPakAsset* const asset, const int exportSetting)
+{
+    ExportManifestEntry_t entry = {};
+    entry.guid = asset->GetAssetGUID();
+    entry.pakCrc = asset->getPakCRC();
+    entry.starpakOffset = asset->data()->starpakOffset;
+    entry.optStarpakOffset = asset->data()->optStarpakOffset;
+
+    std::unordered_set<uint64_t> visited = { asset->GetAssetGUID() };
+    entry.dependencyHash = 0xcbf29ce484222325ull;
+    HashAssetDependencies(asset, visited, entry.dependencyHash);
+
+    entry.type = asset->GetAssetType();
+    entry.majorVer = asset->GetAssetVersion().majorVer;
+    entry.minorVer = asset->GetAssetVersion().minorVer;
+    entry.exportSetting = exportSetting;
+
+    return entry;
+}
+
+// hash of every global setting that changes what gets written for an asset
+static uint64_t GetExportSettingsHash()
+{
+    uint64_t hash = 0xcbf29ce484222325ull;
+    const auto hashValue = [&hash](const uint64_t value)
+        {
+            hash ^= value;
+            hash *= 0x100000001b3ull;
+        };
+
+    hashValue(g_ExportSettings.previewedSkinIndex);
+    hashValue(g_ExportSettings.exportNormalRecalcSetting);
+    hashValue(g_ExportSettings.exportTextureNameSetting);
+    hashValue(g_ExportSettings.exportModelLodSetting);
+    hashValue(g_ExportSettings.exportPngCompressionSetting);
+    hashValue(g_ExportSettings.exportPathsFull);
+    hashValue(g_ExportSettings.exportRigSequences);
+    hashValue(g_ExportSettings.exportModelSkin);
+    hashValue(g_ExportSettings.exportMaterialTextures);
+    hashValue(g_ExportSettings.exportPhysicsContentsFilter);
+    hashValue(g_ExportSettings.exportPhysicsFilterExclusive);
+    hashValue(g_ExportSettings.exportPhysicsFilterAND);
+
+    return hash;
+}
+
+// the manifest lives in the export directory so it is tied to the files that were actually written
+static const std::string GetExportManifestPath()
+{
+    return (std::filesystem::current_path() / EXPORT_DIRECTORY_NAME / "export_manifest.bin").string();
+}
+
+static void HandleExportBindingForAssetEx(CAsset* const asset, CExportManifest* const manifest)
 {
     if (auto it = g_assetData.m_assetTypeBindings.find(asset->GetAssetType()); it != g_assetData.m_assetTypeBindings.end())
     {
         if (it->second.e.exportFunc)
         {
-            const bool exported = it->second.e.exportFunc(asset, it->second.e.exportSetting);
+            // only pak assets can be tracked, anything else is always exported
+            const bool tracked = manifest && asset->GetAssetContainerType() == CAsset::ContainerType::PAK;
+
+            ExportManifestEntry_t entry = {};
+            if (tracked)
+            {
+                entry = GetExportManifestEntry(static_cast<CPakAsset*>(asset), it->second.e.exportSetting);
+                if (manifest->IsUnchanged(entry))
+                {
+                    asset->SetExportedStatus(true);
+                    return;
+                }
+            }
+
+            // keep track of every file the export writes, so it can be exported again if any of them are deleted
+            CExportOutputRecorder outputRecorder;
+            bool exported = false;
+            {
+                const CExportOutputScope outputScope(tracked ? &outputRecorder : nullptr);
+                exported = it->second.e.exportFunc(asset, it->second.e.exportSetting);
+            }
+
             asset->SetExportedStatus(exported);
+
+            if (tracked && exported)
+                manifest->Update(entry, outputRecorder.getOutputs());
         }
     }
 }
 
-FORCEINLINE void HandleExportBindingForAsset(CAsset* const asset, const bool exportDependencies)
+static void HandleExportBindingForAssetManifest(CAsset* const asset, const bool exportDependencies, CExportManifest* const manifest)
 {
     // only pak assets have dependencies so don't try to export them with other types
     if (asset->GetAssetContainerType() == CAsset::ContainerType::PAK && exportDependencies)
@@ -136,11 +393,16 @@ FORCEINLINE void HandleExportBindingForAsset(CAsset* const asset, const bool exp
 
         for (CPakAsset* const dependency : cpyAssets)
         {
-            HandleExportBindingForAssetEx(dependency);
+            HandleExportBindingForAssetEx(dependency, manifest);
         }
     }
     else
-        HandleExportBindingForAssetEx(asset);
+        HandleExportBindingForAssetEx(asset, manifest);
+}
+
+FORCEINLINE void HandleExportBindingForAsset(CAsset* const asset, const bool exportDependencies)
+{
+    HandleExportBindingForAssetManifest(asset, exportDependencies, nullptr);
 }
 
 void HandlePakAssetExportList(std::deque<CAsset*> selectedAssets, const bool exportDependencies)
@@ -158,9 +420,13 @@ void HandlePakAssetExportList(std::deque<CAsset*> selectedAssets, const bool exp
     }
 
     const ProgressBarEvent_t* const exportAssetListEvent = g_pImGuiHandler->AddProgressBarEvent("Exporting asset list..", parallelProcessTask.getRemainingTasks(), &parallelProcessTask, PB_FNCLASS_TO_VOID(&CParallelTask::getRemainingTasks));
+    g_starpakIOStats.Reset();
+
     parallelProcessTask.execute();
     parallelProcessTask.wait();
     g_pImGuiHandler->FinishProgressBarEvent(exportAssetListEvent);
+
+    g_starpakIOStats.LogStats(__FUNCTION__);
 }
 
 void HandleExportAllPakAssets(std::vector<CGlobalAssetData::AssetLookup_t>* const pakAssets, const bool exportDependencies)
@@ -168,20 +434,39 @@ void HandleExportAllPakAssets(std::vector<CGlobalAssetData::AssetLookup_t>* cons
     assertm(g_assetData.v_assetContainers.size() > 0, "No paks loaded.");
     assertm(pakAssets->size() > 0, "No assets?");
 
+    // skip anything that was exported from the same pak data with the same settings last time
+    CExportManifest* manifest = nullptr;
+    const std::string manifestPath = GetExportManifestPath();
+    if (g_ExportSettings.exportSkipUnchanged)
+    {
+        manifest = &g_exportManifest;
+
+        // files from the last export are gone, so nothing can be skipped
+        if (!manifest->LoadFromFile(manifestPath, GetExportSettingsHash()) || !std::filesystem::exists(std::filesystem::current_path() / EXPORT_DIRECTORY_NAME))
+            manifest->Clear();
+    }
+
     CParallelTask parallelProcessTask(UtilsConfig->exportThreadCount);
 
     for (auto& asset : *pakAssets)
     {
-        parallelProcessTask.addTask([asset, exportDependencies]
+        parallelProcessTask.addTask([asset, exportDependencies, manifest]
             {
-                HandleExportBindingForAsset(asset.m_asset, exportDependencies);
+                HandleExportBindingForAssetManifest(asset.m_asset, exportDependencies, manifest);
             }, 1u);
     }
 
     const ProgressBarEvent_t* const exportAllAssetsEvent = g_pImGuiHandler->AddProgressBarEvent("Exporting all assets..", parallelProcessTask.getRemainingTasks(), &parallelProcessTask, PB_FNCLASS_TO_VOID(&CParallelTask::getRemainingTasks));
+    g_starpakIOStats.Reset();
+
     parallelProcessTask.execute();
     parallelProcessTask.wait();
     g_pImGuiHandler->FinishProgressBarEvent(exportAllAssetsEvent);
+
+    if (manifest)
+        manifest->SaveToFile(manifestPath);
+
+    g_starpakIOStats.LogStats(__FUNCTION__);
 }
 
 void HandleExportSelectedAssetType(std::vector<CGlobalAssetData::AssetLookup_t> pakAssets, const bool exportDependencies)
@@ -156,6 +156,9 @@ int main(int argc, char* argv[])
 {
     CCommandLine cli(argc, argv);
 
+    // relative paths given on the command line are relative to where we were launched from, not the exe
+    const std::filesystem::path launchDirectory = std::filesystem::current_path();
+
     // we want the visual studio debugger to be able to control the working directory
 #if defined(NDEBUG)
     // this is needed to properly support drag'n'drop, it changes the current working directory to the file you drag into the exe
@@ -177,6 +180,29 @@ int main(int argc, char* argv[])
     // get max con-current threads.
     maxConcurrentThreads = std::max(1u, CThread::GetConCurrentThreads());
 
+    // batch export without creating a window or the gui, we still need a device for assets that create resources on load
+    if (cli.HasParam("--export") != -1)
+    {
+        g_dxHandler = new CDXParentHandler(nullptr);
+        if (!g_dxHandler->SetupDeviceHeadless())
+        {
+            delete g_dxHandler;
+            return EXIT_FAILURE;
+        }
+
+        // load the settings saved from the gui so headless exports match them, command line options override these.
+        // the ini is never written back, so overrides from the command line don't end up in the gui's settings
+        ImGui::CreateContext();
+        g_pImGuiHandler->SetupHandler();
+        ImGui::GetIO().IniFilename = nullptr;
+
+        const int exitCode = HandleHeadlessExport(&cli, launchDirectory);
+
+        ImGui::DestroyContext();
+        delete g_dxHandler;
+        return exitCode;
+    }
+
 #if defined(SPLASHSCREEN)
     DrawSplashScreen(); // draw splashscreen now for 2~ seconds
 #endif // #if defined(SPLASHSCREEN)
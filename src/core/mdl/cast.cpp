@@ -2,6 +2,8 @@
 
 #include <core/mdl/cast.h>
 
+extern CBufferManager g_BufferManager;
+
 namespace cast
 {
 	// CAST PROPERTY
@@ -315,7 +317,6 @@ namespace cast
 		CastNodeHeader* nodeHeader = reinterpret_cast<CastNodeHeader*>(buf);
 
 		nodeHeader->Identifier = nodeId;
-		nodeHeader->NodeSize = Size();
 		nodeHeader->NodeHash = hash;
 		nodeHeader->ChildCount = static_cast<uint32_t>(children.size());
 		nodeHeader->PropertyCount = static_cast<uint32_t>(properties.size());
@@ -332,6 +333,9 @@ namespace cast
 			buf = child.Write(buf);
 		}
 
+		// size from what was actually written, calling Size() here would walk every child again at each level
+		nodeHeader->NodeSize = static_cast<uint32_t>(buf - reinterpret_cast<char*>(nodeHeader));
+
 		return buf;
 	}
 
@@ -599,7 +603,15 @@ namespace cast
 	// export this cast to file
 	void CastExporter::ToFile() const
 	{
-		char* fileBuf = new char[castFileSize] {}; // it would be possible to get the file size before writing, but the cost probably does not outweight just allocating a big buffer
+		size_t fileSize = sizeof(CastHeader);
+		for (auto& root : rootNodes)
+			fileSize += root.Size();
+
+		// most casts (sequences especially) fit in a managed buffer, anything bigger gets a buffer of exactly its size
+		CManagedBuffer* const managedBuf = fileSize <= CBufferManager::MaxBufferSize() ? g_BufferManager.TryClaimBuffer() : nullptr;
+		std::unique_ptr<char[]> allocBuf = managedBuf ? nullptr : std::make_unique_for_overwrite<char[]>(fileSize);
+
+		char* const fileBuf = managedBuf ? managedBuf->Buffer() : allocBuf.get();
 		char* curpos = fileBuf;
 
 		CastHeader* castHeader = reinterpret_cast<CastHeader*>(curpos);
@@ -616,15 +628,19 @@ namespace cast
 			curpos = root.Write(curpos);
 		}
 
-		if (!CreateDirectories(path.parent_path()))
+		assertm(static_cast<size_t>(curpos - fileBuf) == fileSize, "cast size did not match what was written");
+
+		if (CreateDirectories(path.parent_path()))
+		{
+			StreamIO out(path.string(), eStreamIOMode::Write);
+			out.write(fileBuf, curpos - fileBuf);
+		}
+		else
 		{
 			assertm(false, "failed to create directory");
-			return;
 		}
 
-		StreamIO out(path.string(), eStreamIOMode::Write);
-		out.write(fileBuf, curpos - fileBuf);
-
-		delete[] fileBuf;
+		if (managedBuf)
+			g_BufferManager.RelieveBuffer(managedBuf);
 	}
 }
\ No newline at end of file
@@ -78,7 +78,6 @@ namespace cast
 
 	constexpr int castFileId = MAKEFOURCC('c', 'a', 's', 't');
 	constexpr int castFileVersion = 1;
-	constexpr size_t castFileSize = 1024 * 1024 * 32; // completely fake
 
 	struct CastHeader
 	{
@@ -409,6 +409,9 @@ void ParseModelAttachmentData_v16(ModelParsedData_t* const parsedData)
 
 void ParseModelDrawData(ModelParsedData_t* const parsedData, CDXDrawData* const drawData, const uint64_t lod)
 {
+	// meshes get decompressed into here, they were built in a managed buffer so they always fit
+	CManagedBuffer* const decompBuf = g_BufferManager.ClaimBuffer();
+
 	// [rika]: eventually parse through models
 	for (size_t i = 0; i < parsedData->lods.at(lod).meshes.size(); ++i)
 	{
@@ -423,8 +426,7 @@ void ParseModelDrawData(ModelParsedData_t* const parsedData, CDXDrawData* const
 
 		assertm(mesh.meshVertexDataIndex != invalidNoodleIdx, "mesh data hasn't been parsed ??");
 
-		std::unique_ptr<char[]> parsedVertexDataBuf = parsedData->meshVertexData.getIdx(mesh.meshVertexDataIndex);
-		const CMeshData* const parsedVertexData = reinterpret_cast<CMeshData*>(parsedVertexDataBuf.get());
+		const CMeshData* const parsedVertexData = reinterpret_cast<const CMeshData*>(parsedData->meshVertexData.getIdx(mesh.meshVertexDataIndex, decompBuf->Buffer(), CBufferManager::MaxBufferSize()));
 
 		if (!meshDrawData->vertexBuffer)
 		{
@@ -451,7 +453,7 @@ void ParseModelDrawData(ModelParsedData_t* const parsedData, CDXDrawData* const
 			D3D11_SUBRESOURCE_DATA srd{ vertexData };
 
 			if (FAILED(g_dxHandler->GetDevice()->CreateBuffer(&desc, &srd, &meshDrawData->vertexBuffer)))
-				return;
+				break;
 
 			meshDrawData->vertexStride = vertStride;
 
@@ -472,12 +474,14 @@ void ParseModelDrawData(ModelParsedData_t* const parsedData, CDXDrawData* const
 
 			D3D11_SUBRESOURCE_DATA srd = { parsedVertexData->GetIndices() };
 			if (FAILED(g_dxHandler->GetDevice()->CreateBuffer(&desc, &srd, &meshDrawData->indexBuffer)))
-				return;
+				break;
 
 			meshDrawData->numIndices = mesh.indexCount;
 		}
 	}
 
+	g_BufferManager.RelieveBuffer(decompBuf);
+
 	return;
 }
 
@@ -505,14 +509,14 @@ void ParseAnimDesc_Origin(animdesc_t* const animdesc, CAnimData& animData, bool(
 {
 	// [rika]: adjust the origin bone
 	// [rika]: do after we get anim data, so our rotation does not get overwritten
-	CAnimDataBone& originBone = animData.GetBone(0);
+	CAnimDataBone originBone = animData.GetBone(0);
 	originBone.SetFlags(CAnimDataBone::ANIMDATA_POS | CAnimDataBone::ANIMDATA_ROT); // make sure it has position and rotation
 
 	for (int frame = 0; frame < animdesc->numframes; frame++)
 	{
-		Vector pos(originBone.GetPosPtr()[frame]);
-		Quaternion q(originBone.GetRotPtr()[frame]);
-		const Vector& scale = originBone.GetSclPtr()[frame];
+		Vector pos(originBone.GetPos(frame));
+		Quaternion q(originBone.GetRot(frame));
+		const Vector scale(originBone.GetScl(frame));
 
 		QAngle vecAngleBase(q);
 
@@ -573,9 +577,11 @@ void ParseAnimDesc_R2(seqdesc_t* const seqdesc, animdesc_t* const animdesc, cons
 		}
 	}
 
+	// parsed straight into the memory format, then compressed
+	CManagedBuffer* buffer = g_BufferManager.ClaimBuffer();
+
 	// no point to allocate memory on empty animations!
-	CAnimData animData(boneCount, animdesc->numframes);
-	animData.ReserveVector();
+	CAnimData animData(boneCount, animdesc->numframes, buffer->Buffer(), CBufferManager::MaxBufferSize());
 
 	// [rika]: parse through the bone tracks here
 	for (int frame = 0; frame < animdesc->numframes; frame++)
@@ -631,7 +637,7 @@ void ParseAnimDesc_R2(seqdesc_t* const seqdesc, animdesc_t* const animdesc, cons
 				scale = scales[bone];
 			}
 
-			CAnimDataBone& animDataBone = animData.GetBone(bone);
+			CAnimDataBone animDataBone = animData.GetBone(bone);
 			animDataBone.SetFlags(boneFlags);
 			animDataBone.SetFrame(frame, pos, q, scale);
 		}
@@ -639,10 +645,7 @@ void ParseAnimDesc_R2(seqdesc_t* const seqdesc, animdesc_t* const animdesc, cons
 
 	ParseAnimDesc_Origin(animdesc, animData, &r1::Studio_AnimPosition);
 
-	// parse into memory and compress
-	CManagedBuffer* buffer = g_BufferManager.ClaimBuffer();
-
-	const size_t sizeInMem = animData.ToMemory(buffer->Buffer());
+	const size_t sizeInMem = animData.ToMemory();
 	animdesc->parsedBufferIndex = seqdesc->parsedData.addBack(buffer->Buffer(), sizeInMem);
 
 	g_BufferManager.RelieveBuffer(buffer);
@@ -705,12 +708,19 @@ void ParseAnimDesc_R5(seqdesc_t* const seqdesc, animdesc_t* const animdesc, cons
 		}
 	}
 
-	CAnimData animData(boneCount, animdesc->numframes);
-	animData.ReserveVector();
+	// parsed straight into the memory format, then compressed
+	CManagedBuffer* buffer = g_BufferManager.ClaimBuffer();
+
+	CAnimData animData(boneCount, animdesc->numframes, buffer->Buffer(), CBufferManager::MaxBufferSize());
 
 	// [rika]: parse through the bone tracks here
 	if (animdesc->flags & eStudioAnimFlags::ANIM_VALID && animdesc->flags & eStudioAnimFlags::ANIM_DATAPOINT)
 	{
+		// frames are decoded in order, so each bone keeps a cursor into its tracks and every section's datapoints only get walked once
+		r5::DatapointCursor_t rotCursors[256];
+		r5::DatapointCursor_t posCursors[256];
+		const uint8_t* lastSection = nullptr;
+
 		for (int frame = 0; frame < animdesc->numframes; frame++)
 		{
 			const float cycle = animdesc->GetCycle(frame);
@@ -726,6 +736,18 @@ void ParseAnimDesc_R5(seqdesc_t* const seqdesc, animdesc_t* const animdesc, cons
 			const uint8_t* boneFlagArray = reinterpret_cast<uint8_t*>(animdesc->pAnimdataStall_DP(&iLocalFrame, &sectionlength));
 			const r5::mstudio_rle_anim_t* panim = reinterpret_cast<const r5::mstudio_rle_anim_t*>(&boneFlagArray[ANIM_BONEFLAG_SIZE(boneCount)]);
 
+			// new section, cursors point into the old one's tracks
+			if (boneFlagArray != lastSection)
+			{
+				for (int bone = 0; bone < boneCount; bone++)
+				{
+					rotCursors[bone].Reset();
+					posCursors[bone].Reset();
+				}
+
+				lastSection = boneFlagArray;
+			}
+
 			for (int bone = 0; bone < boneCount; bone++)
 			{
 				Vector pos(positions[bone]);
@@ -741,14 +763,14 @@ void ParseAnimDesc_R5(seqdesc_t* const seqdesc, animdesc_t* const animdesc, cons
 				if (boneFlags & (r5::RleBoneFlags_t::STUDIO_ANIM_DATA)) // check if this bone has data
 				{
 					if (boneFlags & r5::RleBoneFlags_t::STUDIO_ANIM_ROT)
-						r5::CalcBoneQuaternion_DP(sectionlength, &panimtrack, fLocalFrame, q);
+						r5::CalcBoneQuaternion_DP(sectionlength, &panimtrack, fLocalFrame, q, &rotCursors[bone]);
 
 					if (boneFlags & r5::RleBoneFlags_t::STUDIO_ANIM_POS)
 					{
 						if (boneFlags & r5::RleBoneFlags_t::STUDIO_ANIM_UNK8)
 							r5::CalcBonePositionVirtual_DP(sectionlength, &panimtrack, fLocalFrame, pos);
 						else
-							r5::CalcBonePosition_DP(sectionlength, &panimtrack, fLocalFrame, pos);
+							r5::CalcBonePosition_DP(sectionlength, &panimtrack, fLocalFrame, pos, &posCursors[bone]);
 					}
 
 					if (boneFlags & r5::RleBoneFlags_t::STUDIO_ANIM_SCALE)
@@ -765,7 +787,7 @@ void ParseAnimDesc_R5(seqdesc_t* const seqdesc, animdesc_t* const animdesc, cons
 				assertm(pos.IsValid(), "invalid position");
 				assertm(q.IsValid(), "invalid quaternion");
 
-				CAnimDataBone& animDataBone = animData.GetBone(bone);
+				CAnimDataBone animDataBone = animData.GetBone(bone);
 				animDataBone.SetFlags(boneFlags);
 				animDataBone.SetFrame(frame, pos, q, scale);
 			}
@@ -808,7 +830,7 @@ void ParseAnimDesc_R5(seqdesc_t* const seqdesc, animdesc_t* const animdesc, cons
 					panim = panim->pNext();
 				}
 
-				CAnimDataBone& animDataBone = animData.GetBone(bone);
+				CAnimDataBone animDataBone = animData.GetBone(bone);
 				animDataBone.SetFlags(boneFlags);
 				animDataBone.SetFrame(frame, pos, q, scale);
 			}
@@ -822,7 +844,7 @@ void ParseAnimDesc_R5(seqdesc_t* const seqdesc, animdesc_t* const animdesc, cons
 
 		for (int bone = 0; bone < boneCount; bone++)
 		{
-			CAnimDataBone& animDataBone = animData.GetBone(bone);
+			CAnimDataBone animDataBone = animData.GetBone(bone);
 			
 			for (int frame = 0; frame < animdesc->numframes; frame++)
 			{
@@ -834,10 +856,7 @@ void ParseAnimDesc_R5(seqdesc_t* const seqdesc, animdesc_t* const animdesc, cons
 
 	ParseAnimDesc_Origin(animdesc, animData, &r5::Studio_AnimPosition);
 
-	// parse into memory and compress
-	CManagedBuffer* buffer = g_BufferManager.ClaimBuffer();
-
-	const size_t sizeInMem = animData.ToMemory(buffer->Buffer());
+	const size_t sizeInMem = animData.ToMemory();
 	animdesc->parsedBufferIndex = seqdesc->parsedData.addBack(buffer->Buffer(), sizeInMem);
 
 	g_BufferManager.RelieveBuffer(buffer);		
@@ -922,7 +941,38 @@ void CMeshData::AddTexcoords(const Vector2D* const texcoords, const size_t texco
 }
 
 // CAnimData
-CAnimData::CAnimData(char* const buf) : pBuffer(buf), memory(true)
+CAnimData::CAnimData(const int boneCount, const int frameCount, char* const buf, const size_t bufSize) : numBones(boneCount), numFrames(frameCount), memory(false), pBuffer(buf), pOffsets(nullptr), pFlags(nullptr),
+	pWriteBuffer(buf), writeCapacity(bufSize), writeSize(0ull), rest(std::make_unique<BoneRest_t[]>(boneCount))
+{
+	assertm(nullptr != pWriteBuffer, "invalid pointer provided");
+
+	char* curpos = pWriteBuffer;
+
+	memcpy(curpos, &numBones, sizeof(int) * 2);
+	curpos += sizeof(int) * 2;
+
+	const size_t offsetsSize = IALIGN16(sizeof(size_t) * numBones * ANIMDATA_CHANNELS);
+	memset(curpos, 0, offsetsSize);
+	pOffsets = reinterpret_cast<const size_t*>(curpos);
+	curpos += offsetsSize;
+
+	const size_t flagsSize = IALIGN16(sizeof(uint8_t) * numBones);
+	memset(curpos, 0, flagsSize);
+	pFlags = reinterpret_cast<const uint8_t*>(curpos);
+	curpos += flagsSize;
+
+	writeSize = static_cast<size_t>(curpos - pWriteBuffer);
+	assertm(writeSize <= writeCapacity, "animation data too large");
+
+	for (int i = 0; i < numBones; i++)
+	{
+		rest[i].pos.Init(0.0f, 0.0f, 0.0f);
+		rest[i].quat.Init(0.0f, 0.0f, 0.0f, 1.0f);
+		rest[i].scale.Init(1.0f, 1.0f, 1.0f);
+	}
+}
+
+CAnimData::CAnimData(const char* const buf) : memory(true), pBuffer(buf), pWriteBuffer(nullptr), writeCapacity(0ull), writeSize(0ull)
 {
 	assertm(nullptr != pBuffer, "invalid pointer provided");
 
@@ -932,94 +982,157 @@ CAnimData::CAnimData(char* const buf) : pBuffer(buf), memory(true)
 	curpos += sizeof(int) * 2;
 
 	pOffsets = reinterpret_cast<const size_t* const>(curpos);
-	curpos += IALIGN16(sizeof(size_t) * numBones);
+	curpos += IALIGN16(sizeof(size_t) * numBones * ANIMDATA_CHANNELS);
 
 	pFlags = reinterpret_cast<const uint8_t*>(curpos);
 	curpos += IALIGN16(sizeof(uint8_t) * numBones);
 };
 
-// access memory data
-const Vector* const CAnimData::GetBonePosForFrame(const int bone, const int frame) const
+// building
+static const size_t s_AnimDataChannelStride[CAnimData::ANIMDATA_CHANNELS] = { sizeof(Vector), sizeof(Quaternion), sizeof(Vector) };
+
+const bool CAnimData::AddChannel(const int bone, const AnimDataChannel_t channel)
 {
-	const uint8_t boneFlags = GetFlag(bone);
-	assertm(boneFlags & CAnimDataBone::ANIMDATA_POS, "bone did not have position");
+	const size_t offset = IALIGN16(writeSize);
+	const size_t size = s_AnimDataChannelStride[channel] * numFrames;
+
+	if (offset + size > writeCapacity)
+	{
+		assertm(false, "animation data too large");
+		return false;
+	}
 
-	const Vector* const tmp = reinterpret_cast<const Vector* const>(pBuffer + pOffsets[bone]);
+	char* const channelData = pWriteBuffer + offset;
 
-	return tmp + frame;
+	// [rika]: frames before this one had no data for this channel, so they get the value the bone had without it
+	const BoneRest_t& boneRest = rest[bone];
+	for (int frame = 0; frame < numFrames; frame++)
+	{
+		switch (channel)
+		{
+		case ANIMDATA_CHANNEL_POS:
+			reinterpret_cast<Vector*>(channelData)[frame] = boneRest.pos;
+			break;
+		case ANIMDATA_CHANNEL_ROT:
+			reinterpret_cast<Quaternion*>(channelData)[frame] = boneRest.quat;
+			break;
+		case ANIMDATA_CHANNEL_SCL:
+			reinterpret_cast<Vector*>(channelData)[frame] = boneRest.scale;
+			break;
+		}
+	}
+
+	const_cast<size_t*>(pOffsets)[(bone * ANIMDATA_CHANNELS) + channel] = offset;
+	writeSize = offset + size;
+
+	return true;
 }
 
-const Quaternion* const CAnimData::GetBoneQuatForFrame(const int bone, const int frame) const
+void CAnimData::SetBoneFlags(const int bone, const uint8_t flags)
 {
-	const uint8_t boneFlags = GetFlag(bone);
-	assertm(boneFlags & CAnimDataBone::ANIMDATA_ROT, "bone did not have rotation");
+	assertm(!memory, "can't change animation data in memory format");
 
-	const Quaternion* const tmp = reinterpret_cast<const Quaternion* const>(pBuffer + pOffsets[bone] + (s_AnimDataBoneSizeLUT[boneFlags & CAnimDataBone::ANIMDATA_POS] * numFrames));
+	uint8_t boneFlags = pFlags[bone] | flags;
+	const uint8_t added = flags & ~pFlags[bone];
 
-	return tmp + frame;
+	// only channels that are flagged get any storage
+	if (added & CAnimDataBone::ANIMDATA_POS && !AddChannel(bone, ANIMDATA_CHANNEL_POS))
+		boneFlags &= ~CAnimDataBone::ANIMDATA_POS;
+
+	if (added & CAnimDataBone::ANIMDATA_ROT && !AddChannel(bone, ANIMDATA_CHANNEL_ROT))
+		boneFlags &= ~CAnimDataBone::ANIMDATA_ROT;
+
+	if (added & CAnimDataBone::ANIMDATA_SCL && !AddChannel(bone, ANIMDATA_CHANNEL_SCL))
+		boneFlags &= ~CAnimDataBone::ANIMDATA_SCL;
+
+	const_cast<uint8_t*>(pFlags)[bone] = boneFlags;
 }
 
-const Vector* const CAnimData::GetBoneScaleForFrame(const int bone, const int frame) const
+void CAnimData::SetBoneFrame(const int bone, const int frame, const Vector& pos, const Quaternion& quat, const Vector& scale)
 {
-	const uint8_t boneFlags = GetFlag(bone);
-	assertm(boneFlags & CAnimDataBone::ANIMDATA_SCL, "bone did not have scale");
+	assertm(!memory, "can't change animation data in memory format");
+	assertm(frame < numFrames, "frame out of range");
 
-	const Vector* const tmp = reinterpret_cast<const Vector* const>(pBuffer + pOffsets[bone] + (s_AnimDataBoneSizeLUT[boneFlags & (CAnimDataBone::ANIMDATA_POS | CAnimDataBone::ANIMDATA_ROT)] * numFrames));
+	const uint8_t boneFlags = pFlags[bone];
+	BoneRest_t& boneRest = rest[bone];
 
-	return tmp + frame;
+	if (boneFlags & CAnimDataBone::ANIMDATA_POS)
+		reinterpret_cast<Vector*>(pWriteBuffer + GetChannelOffset(bone, ANIMDATA_CHANNEL_POS))[frame] = pos;
+	else
+		boneRest.pos = pos;
+
+	if (boneFlags & CAnimDataBone::ANIMDATA_ROT)
+		reinterpret_cast<Quaternion*>(pWriteBuffer + GetChannelOffset(bone, ANIMDATA_CHANNEL_ROT))[frame] = quat;
+	else
+		boneRest.quat = quat;
+
+	if (boneFlags & CAnimDataBone::ANIMDATA_SCL)
+		reinterpret_cast<Vector*>(pWriteBuffer + GetChannelOffset(bone, ANIMDATA_CHANNEL_SCL))[frame] = scale;
+	else
+		boneRest.scale = scale;
 }
 
-const size_t CAnimData::ToMemory(char* const buf)
+// access memory data
+const Vector* const CAnimData::GetBonePosForFrame(const int bone, const int frame) const
 {
-	char* curpos = buf;
-
-	// dumb
-	memcpy(curpos, &numBones, sizeof(int) * 2);
-	curpos += sizeof(int) * 2;
+	assertm(GetFlag(bone) & CAnimDataBone::ANIMDATA_POS, "bone did not have position");
 
-	size_t* offsets = reinterpret_cast<size_t*>(curpos);
-	curpos += IALIGN16(sizeof(size_t) * numBones);
+	const Vector* const tmp = reinterpret_cast<const Vector* const>(pBuffer + GetChannelOffset(bone, ANIMDATA_CHANNEL_POS));
 
-	uint8_t* flags = reinterpret_cast<uint8_t*>(curpos);
-	curpos += IALIGN16(sizeof(uint8_t) * numBones);
+	return tmp + frame;
+}
 
-	for (size_t i = 0; i < numBones; i++)
-	{
-		const CAnimDataBone& bone = bones.at(i);
+const Quaternion* const CAnimData::GetBoneQuatForFrame(const int bone, const int frame) const
+{
+	assertm(GetFlag(bone) & CAnimDataBone::ANIMDATA_ROT, "bone did not have rotation");
 
-		offsets[i] = static_cast<size_t>(curpos - buf);
+	const Quaternion* const tmp = reinterpret_cast<const Quaternion* const>(pBuffer + GetChannelOffset(bone, ANIMDATA_CHANNEL_ROT));
 
-		flags[i] = bone.GetFlags();
+	return tmp + frame;
+}
 
-		if (flags[i] & CAnimDataBone::ANIMDATA_POS)
-		{
-			memcpy(curpos, bone.GetPosPtr(), sizeof(Vector) * numFrames);
-			curpos += sizeof(Vector) * numFrames;
-		}
+const Vector* const CAnimData::GetBoneScaleForFrame(const int bone, const int frame) const
+{
+	assertm(GetFlag(bone) & CAnimDataBone::ANIMDATA_SCL, "bone did not have scale");
 
-		if (flags[i] & CAnimDataBone::ANIMDATA_ROT)
-		{
-			memcpy(curpos, bone.GetRotPtr(), sizeof(Quaternion) * numFrames);
-			curpos += sizeof(Quaternion) * numFrames;
-		}
+	const Vector* const tmp = reinterpret_cast<const Vector* const>(pBuffer + GetChannelOffset(bone, ANIMDATA_CHANNEL_SCL));
 
-		if (flags[i] & CAnimDataBone::ANIMDATA_SCL)
-		{
-			memcpy(curpos, bone.GetSclPtr(), sizeof(Vector) * numFrames);
-			curpos += sizeof(Vector) * numFrames;
-		}
-	}
+	return tmp + frame;
+}
 
-	const size_t size = static_cast<size_t>(curpos - buf);
-	assertm(size < CBufferManager::MaxBufferSize(), "animation data too large");
+const size_t CAnimData::ToMemory() const
+{
+	assertm(!memory, "animation data is already in memory format");
 
-	return size;
+	return writeSize;
 };
 
 
 //
 // EXPORT SETTINGS
 //
+uint8_t GetModelLODMask(const uint32_t setting, const size_t lodCount)
+{
+	if (lodCount == 0)
+		return 0;
+
+	const uint8_t highest = 1;
+	const uint8_t lowest = static_cast<uint8_t>(1 << (std::min(lodCount, static_cast<size_t>(8)) - 1));
+
+	switch (setting)
+	{
+	case eModelExportLod::MDL_LOD_HIGHEST:
+		return highest;
+	case eModelExportLod::MDL_LOD_LOWEST:
+		return lowest;
+	case eModelExportLod::MDL_LOD_HIGHEST_LOWEST:
+		return highest | lowest;
+	case eModelExportLod::MDL_LOD_ALL:
+	default:
+		return 0xff;
+	}
+}
+
 struct ModelMaterialExport_t
 {
 	ModelMaterialExport_t(MaterialAsset* const material, const int materialId) : asset(material), id(materialId) {}
@@ -1030,7 +1143,7 @@ struct ModelMaterialExport_t
 };
 
 // export materials from parsed data
-void HandleModelMaterials(const ModelParsedData_t* const parsedData, std::unordered_map<int, ModelMaterialExport_t>& materials, const std::filesystem::path& exportPath)
+void HandleModelMaterials(const ModelParsedData_t* const parsedData, const uint8_t lodMask, std::unordered_map<int, ModelMaterialExport_t>& materials, const std::filesystem::path& exportPath)
 {
 	// [rika]: this will decide if we want textures/materials local to the model, or to use full paths in the future.
 	const bool useFullPaths = false; // temp
@@ -1053,7 +1166,16 @@ void HandleModelMaterials(const ModelParsedData_t* const parsedData, std::unorde
 	// [rika]: we don't need to cycle through all the LODs here, any used mesh should be in the top LOD and cannot change per LOD
 	// this gets the data we need to export materials, and set them properly in meshes later
 	// keep track of the materials that are actually used by meshes, so we don't export unneeded ones (speeds up export)
-	for (const ModelMeshData_t& mesh : parsedData->lods.front().meshes)
+	// only the exported lods are guaranteed to be parsed, so use the first one of those
+	size_t materialLod = 0;
+	while (materialLod < parsedData->lods.size() && !(lodMask & (1 << materialLod)))
+		materialLod++;
+
+	// no lods get exported, so no materials are used either
+	if (materialLod == parsedData->lods.size())
+		return;
+
+	for (const ModelMeshData_t& mesh : parsedData->lods.at(materialLod).meshes)
 	{
 		// [rika]: no vertices, this mesh will not be exported.
 		if (!mesh.vertCount)
@@ -1114,7 +1236,7 @@ void HandleModelMaterials(const ModelParsedData_t* const parsedData, std::unorde
 
 // [rika]: todo also fix this up
 // export parsed data to rmax
-bool ExportModelRMAX(const ModelParsedData_t* const parsedData, std::filesystem::path& exportPath)
+bool ExportModelRMAX(const ModelParsedData_t* const parsedData, const uint8_t lodMask, std::filesystem::path& exportPath)
 {
 	std::string fileNameBase = exportPath.stem().string();
 	const std::filesystem::path filePath(exportPath.parent_path());
@@ -1139,11 +1261,17 @@ bool ExportModelRMAX(const ModelParsedData_t* const parsedData, std::filesystem:
 
 	const std::filesystem::path texturePath(std::format("{}/{}", filePath.string(), fileNameBase)); // todo, remove duplicate code
 	std::unordered_map<int, ModelMaterialExport_t> materials;
-	HandleModelMaterials(parsedData, materials, texturePath);
+	HandleModelMaterials(parsedData, lodMask, materials, texturePath);
+
+	// meshes get decompressed into here instead of a new allocation each
+	CManagedBuffer* const decompBuf = g_BufferManager.ClaimBuffer();
 
 	// [rika]: now we parse lods
 	for (size_t lodIdx = 0; lodIdx < parsedData->lods.size(); lodIdx++)
 	{
+		if (!(lodMask & (1 << lodIdx)))
+			continue;
+
 		const ModelLODData_t& lodData = parsedData->lods.at(lodIdx);
 
 		const std::string tmpName = std::format("{}_LOD{}.rmax", fileNameBase, lodIdx);
@@ -1215,8 +1343,7 @@ bool ExportModelRMAX(const ModelParsedData_t* const parsedData, std::filesystem:
 
 				assertm(meshData.meshVertexDataIndex != invalidNoodleIdx, "mesh data hasn't been parsed ??");
 
-				std::unique_ptr<char[]> parsedVertexDataBuf = parsedData->meshVertexData.getIdx(meshData.meshVertexDataIndex);
-				const CMeshData* const parsedVertexData = reinterpret_cast<CMeshData*>(parsedVertexDataBuf.get());
+				const CMeshData* const parsedVertexData = reinterpret_cast<const CMeshData*>(parsedData->meshVertexData.getIdx(meshData.meshVertexDataIndex, decompBuf->Buffer(), CBufferManager::MaxBufferSize()));
 
 				rmaxFile.AddMesh(static_cast<int16_t>(rmaxFile.CollectionCount() - 1), static_cast<int16_t>(material.id), meshData.texcoordCount, meshData.texcoodIndices, (meshData.rawVertexLayoutFlags & VERT_COLOR));
 
@@ -1254,12 +1381,14 @@ bool ExportModelRMAX(const ModelParsedData_t* const parsedData, std::filesystem:
 		rmaxFile.ResetMeshData();
 	}
 
+	g_BufferManager.RelieveBuffer(decompBuf);
+
 	return true;
 }
 
 // export parsed data to cast
 // [rika]: todo rewrite this soon tm (it is so bad)
-bool ExportModelCast(const ModelParsedData_t* const parsedData, std::filesystem::path& exportPath, const uint64_t guid)
+bool ExportModelCast(const ModelParsedData_t* const parsedData, const uint8_t lodMask, std::filesystem::path& exportPath, const uint64_t guid)
 {
 	std::string fileNameBase = exportPath.stem().string();
 
@@ -1306,10 +1435,16 @@ bool ExportModelCast(const ModelParsedData_t* const parsedData, std::filesystem:
 
 	const std::filesystem::path texturePath(std::format("{}/{}", exportPath.parent_path().string(), fileNameBase)); // todo, remove duplicate code
 	std::unordered_map<int, ModelMaterialExport_t> materials;
-	HandleModelMaterials(parsedData, materials, texturePath);
+	HandleModelMaterials(parsedData, lodMask, materials, texturePath);
+
+	// meshes get decompressed into here instead of a new allocation each
+	CManagedBuffer* const decompBuf = g_BufferManager.ClaimBuffer();
 
 	for (size_t lodIdx = 0; lodIdx < parsedData->lods.size(); lodIdx++)
 	{
+		if (!(lodMask & (1 << lodIdx)))
+			continue;
+
 		const ModelLODData_t& lodData = parsedData->lods.at(lodIdx);
 
 		std::string tmpName(std::format("{}_LOD{}.cast", fileNameBase, std::to_string(lodIdx)));
@@ -1445,8 +1580,7 @@ bool ExportModelCast(const ModelParsedData_t* const parsedData, std::filesystem:
 
 				assertm(meshData.meshVertexDataIndex != invalidNoodleIdx, "mesh data hasn't been parsed ??");
 
-				std::unique_ptr<char[]> parsedVertexDataBuf = parsedData->meshVertexData.getIdx(meshData.meshVertexDataIndex);
-				const CMeshData* const parsedVertexData = reinterpret_cast<CMeshData*>(parsedVertexDataBuf.get());
+				const CMeshData* const parsedVertexData = reinterpret_cast<const CMeshData*>(parsedData->meshVertexData.getIdx(meshData.meshVertexDataIndex, decompBuf->Buffer(), CBufferManager::MaxBufferSize()));
 
 				std::string matl = nullptr != meshData.materialAsset ? keepAfterLastSlashOrBackslash(meshData.GetMaterialAsset()->name) : std::to_string(materialGuid);
 				std::string meshName = std::format("{}_{}", modelData.name, matl);
@@ -1526,6 +1660,8 @@ bool ExportModelCast(const ModelParsedData_t* const parsedData, std::filesystem:
 		delete[] vertexData.indices;
 	}
 
+	g_BufferManager.RelieveBuffer(decompBuf);
+
 	return true;
 }
 
@@ -1555,7 +1691,7 @@ inline void ParseVertexIntoSMD(const Vertex_t* const srcVert, const VertexWeight
 	}
 }
 
-bool ExportModelSMD(const ModelParsedData_t* const parsedData, std::filesystem::path& exportPath)
+bool ExportModelSMD(const ModelParsedData_t* const parsedData, const uint8_t lodMask, std::filesystem::path& exportPath)
 {
 	std::string fileNameBase = exportPath.stem().string();
 	const std::filesystem::path filePath(exportPath.parent_path());
@@ -1583,12 +1719,18 @@ bool ExportModelSMD(const ModelParsedData_t* const parsedData, std::filesystem::
 
 	const std::filesystem::path texturePath(std::format("{}/{}", filePath.string(), fileNameBase)); // todo, remove duplicate code
 	std::unordered_map<int, ModelMaterialExport_t> materials;
-	HandleModelMaterials(parsedData, materials, texturePath);
+	HandleModelMaterials(parsedData, lodMask, materials, texturePath);
+
+	// meshes get decompressed into here instead of a new allocation each
+	CManagedBuffer* const decompBuf = g_BufferManager.ClaimBuffer();
 
 	const bool isStaticProp = parsedData->studiohdr.flags & STUDIOHDR_FLAGS_STATIC_PROP ? true : false;
 
 	for (size_t lodIdx = 0; lodIdx < parsedData->lods.size(); lodIdx++)
 	{
+		if (!(lodMask & (1 << lodIdx)))
+			continue;
+
 		const ModelLODData_t& lod = parsedData->lods.at(lodIdx);
 
 		for (const ModelModelData_t& model : lod.models)
@@ -1604,8 +1746,7 @@ bool ExportModelSMD(const ModelParsedData_t* const parsedData, std::filesystem::
 
 				assertm(meshData.meshVertexDataIndex != invalidNoodleIdx, "mesh data hasn't been parsed ??");
 
-				std::unique_ptr<char[]> parsedVertexDataBuf = parsedData->meshVertexData.getIdx(meshData.meshVertexDataIndex);
-				const CMeshData* const parsedVertexData = reinterpret_cast<CMeshData*>(parsedVertexDataBuf.get());
+				const CMeshData* const parsedVertexData = reinterpret_cast<const CMeshData*>(parsedData->meshVertexData.getIdx(meshData.meshVertexDataIndex, decompBuf->Buffer(), CBufferManager::MaxBufferSize()));
 
 				const uint16_t* const indices = parsedVertexData->GetIndices();
 				const Vertex_t* const vertices = parsedVertexData->GetVertices();
@@ -1647,10 +1788,34 @@ bool ExportModelSMD(const ModelParsedData_t* const parsedData, std::filesystem::
 
 	FreeAllocVar(smd);
 
+	g_BufferManager.RelieveBuffer(decompBuf);
+
 	return true;
 }
 
 // export a seqdesc to rmax
+// buffer parsed animations are read into for a whole sequence export.
+// the managed buffer pool is shared with every other export thread and can run dry, a heap buffer of the same size is used then
+class CAnimReadBuffer
+{
+public:
+	CAnimReadBuffer() : managedBuf(g_BufferManager.TryClaimBuffer()), allocBuf(managedBuf ? nullptr : std::make_unique_for_overwrite<char[]>(CBufferManager::MaxBufferSize())) {};
+	~CAnimReadBuffer()
+	{
+		if (managedBuf)
+			g_BufferManager.RelieveBuffer(managedBuf);
+	}
+
+	CAnimReadBuffer(const CAnimReadBuffer&) = delete;
+	CAnimReadBuffer& operator=(const CAnimReadBuffer&) = delete;
+
+	inline char* const Buffer() const { return managedBuf ? managedBuf->Buffer() : allocBuf.get(); };
+
+private:
+	CManagedBuffer* const managedBuf;
+	const std::unique_ptr<char[]> allocBuf;
+};
+
 bool ExportSeqDescRMAX(const seqdesc_t* const seqdesc, std::filesystem::path& exportPath, const char* const skelName, const std::vector<ModelBone_t>* const bones)
 {
 	const std::string fileNameBase = exportPath.stem().string();
@@ -1658,6 +1823,9 @@ bool ExportSeqDescRMAX(const seqdesc_t* const seqdesc, std::filesystem::path& ex
 
 	const size_t boneCount = bones->size();
 
+	// parsed animations are read into this, raw ones are used in place
+	const CAnimReadBuffer parsedBuf;
+
 	for (int animIdx = 0; animIdx < seqdesc->AnimCount(); animIdx++)
 	{
 		const std::string animName = std::format("{}{}", fileNameBase.c_str(), animIdx);
@@ -1693,8 +1861,12 @@ bool ExportSeqDescRMAX(const seqdesc_t* const seqdesc, std::filesystem::path& ex
 			continue;
 		}
 
-		const std::unique_ptr<char[]> noodle = seqdesc->parsedData.getIdx(animdesc->parsedBufferIndex);
-		CAnimData animData(noodle.get());
+		const char* const animBuf = seqdesc->parsedData.getIdx(animdesc->parsedBufferIndex, parsedBuf.Buffer(), CBufferManager::MaxBufferSize());
+		// nothing valid to write, don't leave an empty file behind
+		if (!animBuf)
+			continue;
+
+		CAnimData animData(animBuf);
 
 		for (int i = 0; i < boneCount; i++)
 		{
@@ -1736,6 +1908,9 @@ bool ExportSeqDescCast(const seqdesc_t* const seqdesc, std::filesystem::path& ex
 
 	const size_t boneCount = bones->size();
 
+	// parsed animations are read into this, raw ones are used in place
+	const CAnimReadBuffer parsedBuf;
+
 	for (int animIdx = 0; animIdx < seqdesc->AnimCount(); animIdx++)
 	{
 		const animdesc_t* const animdesc = &seqdesc->anims.at(animIdx);
@@ -1781,8 +1956,12 @@ bool ExportSeqDescCast(const seqdesc_t* const seqdesc, std::filesystem::path& ex
 			continue;
 		}
 
-		const std::unique_ptr<char[]> noodle = seqdesc->parsedData.getIdx(animdesc->parsedBufferIndex);
-		CAnimData animData(noodle.get());
+		const char* const animBuf = seqdesc->parsedData.getIdx(animdesc->parsedBufferIndex, parsedBuf.Buffer(), CBufferManager::MaxBufferSize());
+		// nothing valid to write, don't leave an empty file behind
+		if (!animBuf)
+			continue;
+
+		CAnimData animData(animBuf);
 
 		const cast::CastPropsCurveMode curveMode = animdesc->flags & eStudioAnimFlags::ANIM_DELTA ? cast::CastPropsCurveMode::MODE_ADDITIVE : cast::CastPropsCurveMode::MODE_ABSOLUTE;
 
@@ -1876,6 +2055,9 @@ bool ExportSeqDescSMD(const seqdesc_t* const seqdesc, std::filesystem::path& exp
 	const Vector deltaPos(0.0f, 0.0f, 0.0f);
 	const Quaternion deltaQuat(0.0f, 0.0f, 0.0f, 1.0f);
 
+	// parsed animations are read into this, raw ones are used in place
+	const CAnimReadBuffer parsedBuf;
+
 	for (int animIdx = 0; animIdx < seqdesc->AnimCount(); animIdx++)
 	{
 		const animdesc_t* const animdesc = &seqdesc->anims.at(animIdx);
@@ -1894,8 +2076,12 @@ bool ExportSeqDescSMD(const seqdesc_t* const seqdesc, std::filesystem::path& exp
 			continue;
 		}
 
-		const std::unique_ptr<char[]> noodle = seqdesc->parsedData.getIdx(animdesc->parsedBufferIndex);
-		CAnimData animData(noodle.get());
+		const char* const animBuf = seqdesc->parsedData.getIdx(animdesc->parsedBufferIndex, parsedBuf.Buffer(), CBufferManager::MaxBufferSize());
+		// nothing valid to write, don't leave an empty file behind
+		if (!animBuf)
+			continue;
+
+		CAnimData animData(animBuf);
 
 		for (int frame = 0; frame < animdesc->numframes; frame++)
 		{
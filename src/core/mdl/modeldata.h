@@ -422,24 +422,16 @@ private:
 	char* writer; // for writing only
 };
 
-// for parsing the animation data
+class CAnimData;
+
+// for parsing the animation data, a view of one bone while CAnimData is being built
 class CAnimDataBone
 {
 public:
-	CAnimDataBone(const size_t frameCount) : flags(0)
-	{
-		positions.resize(frameCount);
-		rotations.resize(frameCount);
-		scales.resize(frameCount);
-	};
+	CAnimDataBone(CAnimData* const animData, const int boneIdx) : data(animData), bone(boneIdx) {};
 
-	inline void SetFlags(const uint8_t& flagsIn) { flags |= flagsIn; };
-	inline void SetFrame(const int frameIdx, const Vector& pos, const Quaternion& quat, const Vector& scale)
-	{
-		positions.at(frameIdx) = pos;
-		rotations.at(frameIdx) = quat;
-		scales.at(frameIdx) = scale;
-	}
+	inline void SetFlags(const uint8_t& flagsIn);
+	inline void SetFrame(const int frameIdx, const Vector& pos, const Quaternion& quat, const Vector& scale);
 
 	enum BoneFlags
 	{
@@ -449,66 +441,93 @@ public:
 		ANIMDATA_DATA = (ANIMDATA_POS | ANIMDATA_ROT | ANIMDATA_SCL), // bone has animation data
 	};
 
-	inline const uint8_t GetFlags() const { return flags; };
-	inline const Vector* GetPosPtr() const { return positions.data(); };
-	inline const Quaternion* GetRotPtr() const { return rotations.data(); };
-	inline const Vector* GetSclPtr() const { return scales.data(); };
+	inline const uint8_t GetFlags() const;
 
-private:
-	uint8_t flags;
+	// values for bones without a channel are whatever was last set for it
+	inline const Vector& GetPos(const int frameIdx) const;
+	inline const Quaternion& GetRot(const int frameIdx) const;
+	inline const Vector& GetScl(const int frameIdx) const;
 
-	std::vector<Vector> positions;
-	std::vector<Quaternion> rotations;
-	std::vector<Vector> scales;
-};
-
-static const int s_AnimDataBoneSizeLUT[8] =
-{
-	0,
-	sizeof(Vector),								// ANIMDATA_POS
-	sizeof(Quaternion),							// ANIMDATA_ROT
-	sizeof(Vector) + sizeof(Quaternion),		// ANIMDATA_POS | ANIMDATA_ROT
-	sizeof(Vector),								// ANIMDATA_SCL
-	sizeof(Vector) * 2,							// ANIMDATA_POS | ANIMDATA_SCL
-	sizeof(Vector) + sizeof(Quaternion),		// ANIMDATA_ROT | ANIMDATA_SCL
-	(sizeof(Vector) * 2) + sizeof(Quaternion),	// ANIMDATA_POS | ANIMDATA_ROT | ANIMDATA_SCL
+private:
+	CAnimData* const data;
+	const int bone;
 };
 
+// memory layout:
+// int numBones, int numFrames
+// size_t offsets[numBones][ANIMDATA_CHANNELS] (aligned), zero if the bone does not have that channel
+// uint8_t flags[numBones] (aligned)
+// channel data, numFrames values per channel, only for channels a bone has flags for
 class CAnimData
 {
 public:
-	CAnimData(const int boneCount, const int frameCount) : numBones(boneCount), numFrames(frameCount), pBuffer(nullptr), pOffsets(nullptr), pFlags(nullptr) {};
-	CAnimData(char* const buf);
+	enum AnimDataChannel_t
+	{
+		ANIMDATA_CHANNEL_POS,
+		ANIMDATA_CHANNEL_ROT,
+		ANIMDATA_CHANNEL_SCL,
 
-	inline void ReserveVector() { bones.resize(numBones, numFrames); };
-	CAnimDataBone& GetBone(const size_t idx) { return bones.at(idx); };
+		ANIMDATA_CHANNELS,
+	};
+
+	// builds straight into buf, which ends up holding the memory format
+	CAnimData(const int boneCount, const int frameCount, char* const buf, const size_t bufSize);
+	CAnimData(const char* const buf);
+
+	inline CAnimDataBone GetBone(const size_t idx) { return CAnimDataBone(this, static_cast<int>(idx)); };
 
 	// mem
 	inline const uint8_t GetFlag(const size_t idx) const { return pFlags[idx]; };
 	inline const uint8_t GetFlag(const int idx) const { return pFlags[idx]; };
-	inline const char* const GetData(const size_t idx) const { return GetFlag(idx) & CAnimDataBone::ANIMDATA_DATA ? reinterpret_cast<const char* const>(pBuffer + pOffsets[idx]) : nullptr; }
 
 	const Vector* const GetBonePosForFrame(const int bone, const int frame) const;
 	const Quaternion* const GetBoneQuatForFrame(const int bone, const int frame) const;
 	const Vector* const GetBoneScaleForFrame(const int bone, const int frame) const;
 
-	// returns allocated buffer
-	const size_t ToMemory(char* const buf);
+	// data is already in the buffer passed in, returns its size
+	const size_t ToMemory() const;
 
 private:
+	friend class CAnimDataBone;
+
+	// per bone value for channels it doesn't have (yet), used to fill a channel that gets added partway through
+	struct BoneRest_t
+	{
+		Vector pos;
+		Quaternion quat;
+		Vector scale;
+	};
+
+	void SetBoneFlags(const int bone, const uint8_t flags);
+	void SetBoneFrame(const int bone, const int frame, const Vector& pos, const Quaternion& quat, const Vector& scale);
+	const bool AddChannel(const int bone, const AnimDataChannel_t channel);
+
+	inline const size_t GetChannelOffset(const int bone, const AnimDataChannel_t channel) const { return pOffsets[(bone * ANIMDATA_CHANNELS) + channel]; };
+
 	int numBones;
 	int numFrames;
 
 	bool memory; // memory format
 
 	// mem
-	char* const pBuffer;
+	const char* const pBuffer;
 	const size_t* pOffsets;
 	const uint8_t* pFlags;
 
-	std::vector<CAnimDataBone> bones;
+	// building
+	char* const pWriteBuffer;
+	size_t writeCapacity;
+	size_t writeSize;
+	std::unique_ptr<BoneRest_t[]> rest;
 };
 
+inline void CAnimDataBone::SetFlags(const uint8_t& flagsIn) { data->SetBoneFlags(bone, flagsIn); }
+inline void CAnimDataBone::SetFrame(const int frameIdx, const Vector& pos, const Quaternion& quat, const Vector& scale) { data->SetBoneFrame(bone, frameIdx, pos, quat, scale); }
+inline const uint8_t CAnimDataBone::GetFlags() const { return data->GetFlag(bone); }
+inline const Vector& CAnimDataBone::GetPos(const int frameIdx) const { return GetFlags() & ANIMDATA_POS ? *data->GetBonePosForFrame(bone, frameIdx) : data->rest[bone].pos; }
+inline const Quaternion& CAnimDataBone::GetRot(const int frameIdx) const { return GetFlags() & ANIMDATA_ROT ? *data->GetBoneQuatForFrame(bone, frameIdx) : data->rest[bone].quat; }
+inline const Vector& CAnimDataBone::GetScl(const int frameIdx) const { return GetFlags() & ANIMDATA_SCL ? *data->GetBoneScaleForFrame(bone, frameIdx) : data->rest[bone].scale; }
+
 //
 // EXPORT FORMATS
 //
@@ -572,9 +591,12 @@ static const char* s_AnimSeqExportSettingNames[] =
 	"SMD",
 };
 
-bool ExportModelRMAX(const ModelParsedData_t* const parsedData, std::filesystem::path& exportPath);
-bool ExportModelCast(const ModelParsedData_t* const parsedData, std::filesystem::path& exportPath, const uint64_t guid);
-bool ExportModelSMD(const ModelParsedData_t* const parsedData, std::filesystem::path& exportPath);
+// bit mask of the lods selected by an eModelExportLod setting
+uint8_t GetModelLODMask(const uint32_t setting, const size_t lodCount);
+
+bool ExportModelRMAX(const ModelParsedData_t* const parsedData, const uint8_t lodMask, std::filesystem::path& exportPath);
+bool ExportModelCast(const ModelParsedData_t* const parsedData, const uint8_t lodMask, std::filesystem::path& exportPath, const uint64_t guid);
+bool ExportModelSMD(const ModelParsedData_t* const parsedData, const uint8_t lodMask, std::filesystem::path& exportPath);
 
 bool ExportSeqDesc(const int setting, const seqdesc_t* const seqdesc, std::filesystem::path& exportPath, const char* const skelName, const std::vector<ModelBone_t>* const bones, const uint64_t guid);
 
@@ -1,6 +1,7 @@
 #include <pch.h>
 
 #include <core/mdl/smd.h>
+#include <core/utils/textwriter.h>
 
 namespace smd
 {
@@ -58,7 +59,7 @@ namespace smd
 		outPath.append(exportName);
 		outPath.replace_extension(".smd");
 
-		std::ofstream out(outPath, std::ios::out);
+		CTextWriter out(outPath, true);
 
 		out << "version 1\n";
 
@@ -114,6 +115,6 @@ namespace smd
 			out << "end\n";
 		}
 
-		out.close();
+		out.Close();
 	}
 }
\ No newline at end of file
@@ -13,6 +13,7 @@
 #include <core/input/input.h>
 
 #include <core/filehandling/export.h>
+#include <core/cache/spillcache.h>
 
 #include <game/rtech/cpakfile.h>
 #include <game/rtech/assets/model.h>
@@ -21,8 +22,9 @@
 extern CDXParentHandler* g_dxHandler;
 extern std::atomic<uint32_t> maxConcurrentThreads;
 
-ExportSettings_t g_ExportSettings{ .previewedSkinIndex = 0, .exportNormalRecalcSetting = eNormalExportRecalc::NML_RECALC_NONE, .exportTextureNameSetting = eTextureExportName::TXTR_NAME_TEXT,
-    .exportPathsFull = false, .exportAssetDeps = false, .exportRigSequences = true, .exportModelSkin = false, .exportMaterialTextures = true, .exportPhysicsContentsFilter = static_cast<uint32_t>(TRACE_MASK_ALL) };
+ExportSettings_t g_ExportSettings{ .previewedSkinIndex = 0, .exportNormalRecalcSetting = eNormalExportRecalc::NML_RECALC_NONE, .exportTextureNameSetting = eTextureExportName::TXTR_NAME_TEXT, .exportModelLodSetting = eModelExportLod::MDL_LOD_ALL,
+    .exportPngCompressionSetting = ePngExportCompression::PNG_COMPRESSION_FAST,
+    .exportPathsFull = false, .exportAssetDeps = false, .exportRigSequences = true, .exportModelSkin = false, .exportMaterialTextures = true, .exportSkipUnchanged = false, .exportPhysicsContentsFilter = static_cast<uint32_t>(TRACE_MASK_ALL) };
 PreviewSettings_t g_PreviewSettings { .previewCullDistance = PREVIEW_CULL_DEFAULT, .previewMovementSpeed = PREVIEW_SPEED_DEFAULT };
 
 std::atomic<bool> inJobAction = false;
@@ -665,6 +667,8 @@ void HandleRenderFrame()
     }
 
     constexpr uint32_t minThreads = 1u;
+    constexpr uint32_t minParsedDataBudget = 256u, maxParsedDataBudget = 65536u;
+    constexpr uint32_t minSpillBudget = 0u;
 
     if (uiState.settingsWindowVisible)
     {
@@ -694,10 +698,22 @@ void HandleRenderFrame()
             ImGui::SameLine();
             g_pImGuiHandler->HelpMarker("Enables exporting of all textures that are associated with any material asset that is being exported.");
 
+            ImGui::Checkbox("Skip unchanged assets", &g_ExportSettings.exportSkipUnchanged);
+            ImGui::SameLine();
+            g_pImGuiHandler->HelpMarker("When exporting all assets, skips any pak asset that was already exported from the same pak with the same settings.\nAn asset is exported again if it, anything it depends on, or any file it wrote has changed.\nExported assets are tracked in \"export_manifest.bin\" in the export directory, delete it to force everything to be exported again.");
+
             ImGui::Combo("Material Texture Names", reinterpret_cast<int*>(&g_ExportSettings.exportTextureNameSetting), s_TextureExportNameSetting, static_cast<int>(ARRAYSIZE(s_TextureExportNameSetting)));
             ImGui::SameLine();
             g_pImGuiHandler->HelpMarker("Naming scheme for exporting textures via materials options are as follows:\nGUID: exports only using the asset's GUID as a name.\nReal: exports texture using a real name (asset name or guid if no name).\nText: exports the texture with a text name always, generating one if there is none provided.\nSemantic: exports with a generated name all the time, useful for models.");
 
+            ImGui::Combo("Model LODs", reinterpret_cast<int*>(&g_ExportSettings.exportModelLodSetting), s_ModelExportLodSetting, static_cast<int>(ARRAYSIZE(s_ModelExportLodSetting)));
+            ImGui::SameLine();
+            g_pImGuiHandler->HelpMarker("Which LODs are written when exporting models.\nLODs that aren't exported are never read from the starpak or decompressed, which makes bulk model exports faster.");
+
+            ImGui::Combo("PNG Compression", reinterpret_cast<int*>(&g_ExportSettings.exportPngCompressionSetting), s_PngExportCompressionSetting, static_cast<int>(ARRAYSIZE(s_PngExportCompressionSetting)));
+            ImGui::SameLine();
+            g_pImGuiHandler->HelpMarker("How hard exported pngs are compressed.\nStore: no compression, fastest to write but the files are as big as the raw image. Useful when the pngs are only read back by other tools.\nFast: filters every row the same way, like older versions did.\nDefault: picks the best filter for each row, smaller files for a bit more time.\nSmall: smallest files, much slower to write.");
+
             ImGui::Combo("Normal Recalc", reinterpret_cast<int*>(&g_ExportSettings.exportNormalRecalcSetting), s_NormalExportRecalcSetting, static_cast<int>(ARRAYSIZE(s_NormalExportRecalcSetting)));
             ImGui::SameLine();
             g_pImGuiHandler->HelpMarker("None: exports the normal as it is stored.\nDirectX: exports with a generated blue channel.\nOpenGL: exports with a generated blue channel and inverts the green channel.");
@@ -725,6 +741,34 @@ void HandleRenderFrame()
             ImGui::SameLine();
             g_pImGuiHandler->HelpMarker("The number of CPU threads that will be used for exporting assets.\n\nA higher number of threads will usually make RSX export assets more quickly, however the increased disk usage may cause decreased performance.");
 
+            // ===============================================================================================================
+            ImGui::SeparatorText("Loading");
+
+            ImGui::Checkbox("Memory map starpaks", &UtilsConfig->mapStarpaks);
+            ImGui::SameLine();
+            g_pImGuiHandler->HelpMarker("Maps starpak files into memory when loading paks, so streamed data can be used directly instead of being copied into new buffers.\nFalls back on regular file reads if a starpak can't be mapped. Only applies to paks loaded after changing this setting.");
+
+            bool parsedDataChanged = ImGui::Combo("Parsed data storage", reinterpret_cast<int*>(&UtilsConfig->parsedDataStorage), s_RamenStorageSetting, static_cast<int>(ARRSIZE(s_RamenStorageSetting)));
+            ImGui::SameLine();
+            g_pImGuiHandler->HelpMarker("How parsed model and animation data is kept in memory.\nRaw is fastest to preview and export but uses the most memory, Kraken uses the least but has to be decompressed on every use.\nAuto keeps data raw while under half of the memory budget, then switches to Fast, then to Kraken once over budget.");
+
+            parsedDataChanged |= ImGui::SliderScalar("Parsed data budget (MB)", ImGuiDataType_U32, &UtilsConfig->parsedDataBudget, &minParsedDataBudget, &maxParsedDataBudget);
+            ImGui::SameLine();
+            g_pImGuiHandler->HelpMarker(std::format("Memory budget used by the Auto storage mode.\nCurrently resident: {} MB.", CRamen::ResidentSize() >> 20ull).c_str());
+
+            if (parsedDataChanged)
+                CRamen::SetStoragePolicy(static_cast<eRamenStorage>(UtilsConfig->parsedDataStorage), static_cast<size_t>(UtilsConfig->parsedDataBudget) << 20ull);
+
+            if (ImGui::SliderScalar("Spill budget (MB)", ImGuiDataType_U32, &UtilsConfig->parsedDataSpillBudget, &minSpillBudget, &maxParsedDataBudget))
+                g_spillCache.SetBudget(static_cast<size_t>(UtilsConfig->parsedDataSpillBudget) << 20ull);
+            ImGui::SameLine();
+            {
+                const SpillCacheStats_t spillStats = g_spillCache.GetStats();
+                g_pImGuiHandler->HelpMarker(std::format("Parsed data past this budget is written out to a scratch file, least recently used first, and read back in when it's needed again.\n0 keeps everything in memory. Only applies to files loaded after changing this setting.\n\n"
+                    "Resident: {} MB\nHit rate: {:.1f}%\nSpilled: {} MB\nFaulted back in: {} MB, {:.0f}us on average",
+                    g_spillCache.ResidentSize() >> 20ull, spillStats.HitRate() * 100.0f, spillStats.bytesSpilled >> 20ull, spillStats.bytesFaulted >> 20ull, spillStats.AvgFaultTimeUs()).c_str());
+            }
+
             // ===============================================================================================================
             ImGui::SeparatorText("Preview");
 
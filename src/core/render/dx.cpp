@@ -1,11 +1,11 @@
 #include <pch.h>
 #include <core/render/dx.h>
+#include <core/render/texdecode.h>
+#include <core/render/pngwriter.h>
 #include <core/input/input.h>
 
 #include <thirdparty/directxtex/DirectXTex.h>
 
-#include <wincodec.h>
-
 #if _DEBUG
 #pragma comment(lib, "thirdparty/directxtex/DirectXTex_x64d.lib")
 #else
@@ -16,6 +16,7 @@
 
 extern CDXParentHandler* g_dxHandler;
 extern PreviewSettings_t g_PreviewSettings;
+extern ExportSettings_t g_ExportSettings;
 
 CTexture::CTexture(const char* const buf, const size_t bufSize, const size_t width, const size_t height, const DXGI_FORMAT imgFormat, const size_t arraySize, const size_t mipLevels) : m_width(width), m_height(height), m_shaderResourceView(nullptr)
 {
@@ -95,34 +96,70 @@ bool CTexture::CreateShaderResourceView(ID3D11Device* const device)
 
 bool CTexture::ExportAsPng(const std::filesystem::path& exportPath)
 {
-    if (!IsValid32bppFormat())
+    const DirectX::Image* const image = ToScratchImage->GetImage(0, 0, 0);
+
+    if (CanWritePng(image->format))
+        return WritePng(exportPath, image->pixels, image->rowPitch, image->width, image->height, image->format, g_ExportSettings.exportPngCompressionSetting);
+
+    // decode straight into a buffer for the png writer, the texture itself is left in its original format
+    const DXGI_FORMAT decodeFormat = DirectX::IsSRGB(image->format) ? DXGI_FORMAT_R8G8B8A8_UNORM_SRGB : DXGI_FORMAT_R8G8B8A8_UNORM;
+    if (CanDecodeTexture(image->format, decodeFormat))
     {
-        const DXGI_FORMAT convertFormat = DirectX::IsSRGB(ToScratchImage->GetMetadata().format) ? DXGI_FORMAT_B8G8R8A8_UNORM_SRGB : DXGI_FORMAT_B8G8R8A8_UNORM;
-        if (!ConvertToFormat(convertFormat))
+        const size_t rowPitch = image->width * 4ull;
+        std::unique_ptr<uint8_t[]> pixels = std::make_unique<uint8_t[]>(rowPitch * image->height);
+
+        if (!DecodeTexture(image->pixels, image->rowPitch, image->width, image->height, image->format, pixels.get(), rowPitch, decodeFormat))
         {
-            assertm(false, "Converting the texture format failed.");
+            assertm(false, "Decoding texture failed.");
             return false;
         }
-    }
 
-    const HRESULT res = DirectX::SaveToWICFile(*ToScratchImage->GetImages(), DirectX::WIC_FLAGS::WIC_FLAGS_FORCE_SRGB, DirectX::GetWICCodec(DirectX::WICCodecs::WIC_CODEC_PNG), exportPath.wstring().c_str(), nullptr, 
-        [](IPropertyBag2* props)
-        {
-            PROPBAG2 options{};
-            VARIANT varValues{};
-            options.pstrName = (LPOLESTR)L"FilterOption";
-            varValues.vt = VT_UI1;
-            varValues.bVal = WICPngFilterOption::WICPngFilterUp;
+        return WritePng(exportPath, pixels.get(), rowPitch, image->width, image->height, decodeFormat, g_ExportSettings.exportPngCompressionSetting);
+    }
 
-            props->Write(1u, &options, &varValues);
-        });
+    // anything our decoder can't handle goes through DirectXTex
+    const DXGI_FORMAT convertFormat = DirectX::IsSRGB(image->format) ? DXGI_FORMAT_B8G8R8A8_UNORM_SRGB : DXGI_FORMAT_B8G8R8A8_UNORM;
+    if (!ConvertToFormat(convertFormat))
+    {
+        assertm(false, "Converting the texture format failed.");
+        return false;
+    }
 
-    return SUCCEEDED(res);
+    const DirectX::Image* const convertedImage = ToScratchImage->GetImage(0, 0, 0);
+    return WritePng(exportPath, convertedImage->pixels, convertedImage->rowPitch, convertedImage->width, convertedImage->height, convertedImage->format, g_ExportSettings.exportPngCompressionSetting);
 }
 
 bool CTexture::ExportAsDds(const std::filesystem::path& exportPath)
 {
-    return SUCCEEDED(DirectX::SaveToDDSFile(ToScratchImage->GetImages(), ToScratchImage->GetImageCount(), ToScratchImage->GetMetadata(), DirectX::DDS_FLAGS::DDS_FLAGS_NONE, exportPath.wstring().c_str()));
+    if (FAILED(DirectX::SaveToDDSFile(ToScratchImage->GetImages(), ToScratchImage->GetImageCount(), ToScratchImage->GetMetadata(), DirectX::DDS_FLAGS::DDS_FLAGS_NONE, exportPath.wstring().c_str())))
+        return false;
+
+    RecordExportOutput(exportPath);
+    return true;
+}
+
+// decodes every image in src with our own decoder, format has to pass CanDecodeTexture
+static bool DecodeScratchImage(const DirectX::ScratchImage* const src, const DXGI_FORMAT format, DirectX::ScratchImage* const dst)
+{
+    DirectX::TexMetadata metadata = src->GetMetadata();
+    metadata.format = format;
+
+    if (FAILED(dst->Initialize(metadata)))
+        return false;
+
+    const DirectX::Image* const srcImages = src->GetImages();
+    const DirectX::Image* const dstImages = dst->GetImages();
+
+    for (size_t i = 0; i < src->GetImageCount(); i++)
+    {
+        const DirectX::Image& srcImage = srcImages[i];
+        const DirectX::Image& dstImage = dstImages[i];
+
+        if (!DecodeTexture(srcImage.pixels, srcImage.rowPitch, srcImage.width, srcImage.height, srcImage.format, dstImage.pixels, dstImage.rowPitch, dstImage.format))
+            return false;
+    }
+
+    return true;
 }
 
 bool CTexture::ConvertToFormat(const DXGI_FORMAT format)
@@ -130,6 +167,22 @@ bool CTexture::ConvertToFormat(const DXGI_FORMAT format)
     if (ToScratchImage->GetMetadata().format == format)
         return true;
 
+    // decoding to 8 bit rgba doesn't need DirectXTex, and our decoder can be run across threads
+    if (CanDecodeTexture(ToScratchImage->GetMetadata().format, format))
+    {
+        std::unique_ptr<DirectX::ScratchImage> tempImage = std::make_unique<DirectX::ScratchImage>();
+        if (DecodeScratchImage(ToScratchImage, format, tempImage.get()))
+        {
+            delete ToScratchImage;
+            m_texture = tempImage.release();
+
+            return true;
+        }
+
+        // fall back on DirectXTex
+        assertm(false, "Decoding texture failed.");
+    }
+
     DXGI_FORMAT decompressFormat = DXGI_FORMAT::DXGI_FORMAT_UNKNOWN;
     if (!DirectX::IsCompressed(format))
         decompressFormat = format;
@@ -231,78 +284,63 @@ const int CTexture::Morton(uint32_t i, uint32_t sx, uint32_t sy)
     return v6 * sx + v5;
 }
 
-// https://www.tech-artists.org/t/how-to-calculate-the-blue-channel-for-normal-map/4436/7
-inline float GetNormalZFromXY(const float x, const float y)
-{
-    const float xm = (2.0f * x) - 1.0f;
-    const float ym = (2.0f * y) - 1.0f;
-
-    const float a = 1.f - (xm * xm) - (ym * ym);
-
-    // normalized (?) can't be a valid blue value if it's above 1.0f anyway.
-    if (a < 0.0f)
-        return 0.5f;
-
-    const float sq = sqrtf(a);
-
-    return (sq / 2.0f) + 0.5f;
-}
-
-void CTexture::ConvertNormalOpenDX()
+// z is rebuilt from x and y, see ReconstructNormals
+void CTexture::ConvertNormal(const bool invertGreen)
 {
     const DXGI_FORMAT format = ToScratchImage->GetMetadata().format;
 
     // not a valid normal texture for this function.
     if (format > DXGI_FORMAT::DXGI_FORMAT_BC5_SNORM || format < DXGI_FORMAT::DXGI_FORMAT_BC5_TYPELESS)
         return;
-    
-    ConvertToFormat(DXGI_FORMAT::DXGI_FORMAT_R8G8B8A8_UNORM);
 
-    for (size_t i = 0; i < (ToScratchImage->GetPixelsSize()); i += 4)
+    // decode and rebuild the blue channel in one pass while the decoded rows are still in cache
+    if (CanDecodeTexture(format, DXGI_FORMAT::DXGI_FORMAT_R8G8B8A8_UNORM))
     {
-        uint8_t* pixels = &GetPixels()[i];
+        DirectX::TexMetadata metadata = ToScratchImage->GetMetadata();
+        metadata.format = DXGI_FORMAT::DXGI_FORMAT_R8G8B8A8_UNORM;
 
-        const float x = static_cast<float>(pixels[0]) / 255.0f; // r
-        const float y = static_cast<float>(pixels[1]) / 255.0f; // g
+        std::unique_ptr<DirectX::ScratchImage> tempImage = std::make_unique<DirectX::ScratchImage>();
+        bool decoded = SUCCEEDED(tempImage->Initialize(metadata));
 
-        const float z = GetNormalZFromXY(x, y);
+        const DirectX::Image* const srcImages = ToScratchImage->GetImages();
+        const DirectX::Image* const dstImages = tempImage->GetImages();
 
-        pixels[2] = static_cast<uint8_t>(z * 255.0f);
-    }
+        for (size_t i = 0; decoded && i < ToScratchImage->GetImageCount(); i++)
+        {
+            const DirectX::Image& srcImage = srcImages[i];
+            const DirectX::Image& dstImage = dstImages[i];
 
-    // I'd prefer to use this since uncompressed normals are fat, but it's way too slow.
-    //ConvertToFormat(DXGI_FORMAT::DXGI_FORMAT_BC7_UNORM);
+            decoded = DecodeNormalTexture(srcImage.pixels, srcImage.rowPitch, srcImage.width, srcImage.height, srcImage.format, dstImage.pixels, dstImage.rowPitch, invertGreen);
+        }
 
-    return;
-}
+        if (decoded)
+        {
+            delete ToScratchImage;
+            m_texture = tempImage.release();
 
-void CTexture::ConvertNormalOpenGL()
-{
-    const DXGI_FORMAT format = ToScratchImage->GetMetadata().format;
+            return;
+        }
 
-    // not a valid normal texture for this function.
-    if (format > DXGI_FORMAT::DXGI_FORMAT_BC5_SNORM || format < DXGI_FORMAT::DXGI_FORMAT_BC5_TYPELESS)
-        return;
+        // fall back on converting then rebuilding
+        assertm(false, "Decoding normal texture failed.");
+    }
     
     ConvertToFormat(DXGI_FORMAT::DXGI_FORMAT_R8G8B8A8_UNORM);
 
-    for (size_t i = 0; i < (ToScratchImage->GetPixelsSize()); i += 4)
-    {
-        uint8_t* pixels = &GetPixels()[i];
-
-        const float x = static_cast<float>(pixels[0]) / 255.0f; // r
-        const float y = static_cast<float>(255 - pixels[1]) / 255.0f; // g
-
-        const float z = GetNormalZFromXY(x, y);
-
-        pixels[1] = static_cast<uint8_t>(y * 255.0f);
-        pixels[2] = static_cast<uint8_t>(z * 255.0f);
-    }
+    ReconstructNormals(GetPixels(), ToScratchImage->GetPixelsSize() / 4, invertGreen);
 
     // I'd prefer to use this since uncompressed normals are fat, but it's way too slow.
     //ConvertToFormat(DXGI_FORMAT::DXGI_FORMAT_BC7_UNORM);
+}
+
+void CTexture::ConvertNormalOpenDX()
+{
+    ConvertNormal(false);
+}
 
-    return;
+void CTexture::ConvertNormalOpenGL()
+{
+    ConvertNormal(true);
 }
 
 bool CTexture::IsValid32bppFormat()
@@ -402,6 +440,35 @@ bool CDXParentHandler::SetupDeviceD3D()
     return true;
 }
 
+// device without a window or swapchain, only used for creating resources when running without the gui
+// falls back to the WARP software rasterizer so machines without a gpu can still load and export assets
+bool CDXParentHandler::SetupDeviceHeadless()
+{
+    assertm((m_pDevice == nullptr), "DX device was already setup.");
+
+    D3D_FEATURE_LEVEL featureLevel;
+    const D3D_FEATURE_LEVEL featureLevelArr[2] = { D3D_FEATURE_LEVEL_11_0, D3D_FEATURE_LEVEL_10_0 };
+
+    UINT deviceFlags = 0;
+
+#ifdef _DEBUG
+    deviceFlags |= D3D11_CREATE_DEVICE_DEBUG;
+#endif
+
+    const D3D_DRIVER_TYPE driverTypes[2] = { D3D_DRIVER_TYPE_HARDWARE, D3D_DRIVER_TYPE_WARP };
+    for (const D3D_DRIVER_TYPE driverType : driverTypes)
+    {
+        if (D3D11CreateDevice(nullptr, driverType, nullptr, deviceFlags, featureLevelArr, ARRSIZE(featureLevelArr),
+            D3D11_SDK_VERSION, &m_pDevice, &featureLevel, &m_pDeviceContext) == S_OK)
+        {
+            return CreateMisc();
+        }
+    }
+
+    assertm(false, "Failed to setup headless device.");
+    return false;
+}
+
 bool CDXParentHandler::CreateMainView(const uint16_t w, const uint16_t h)
 {
     ID3D11Texture2D* pBackBuffer = nullptr;
@@ -45,6 +45,7 @@ public:
 
 private:
     bool IsValid32bppFormat();
+    void ConvertNormal(const bool invertGreen);
     void InitTexture(const char* const buf, const size_t bufSize, const size_t width, const size_t height, const DXGI_FORMAT imgFormat, const size_t arraySize, const size_t mipLevels);
 
     size_t m_width;
@@ -279,10 +280,11 @@ class CDXParentHandler
 {
 public:
 	CDXParentHandler() = default;
-	CDXParentHandler(const HWND windowHandle) : m_windowHandle(windowHandle), m_pDevice(nullptr), m_pDeviceContext(nullptr), m_pSwapChain(nullptr), m_pMainView(nullptr), m_pRasterizerState(nullptr), m_pShaderManager(nullptr), m_pCamera(nullptr) {};
+	CDXParentHandler(const HWND windowHandle) : m_windowHandle(windowHandle), m_pDevice(nullptr), m_pDeviceContext(nullptr), m_pSwapChain(nullptr), m_pMainView(nullptr), m_pDepthStencilView(nullptr), m_pDepthStencilState(nullptr), m_pRasterizerState(nullptr), m_pSamplerState(nullptr), m_pSamplerCmpState(nullptr), m_pShaderManager(nullptr), m_pCamera(nullptr) {};
 	~CDXParentHandler() { CleanupD3D(); };
 
 	bool SetupDeviceD3D();
+	bool SetupDeviceHeadless();
 	void CleanupD3D();
 	void HandleResize(const uint16_t x, const uint16_t y);
 
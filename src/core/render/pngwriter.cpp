@@ -0,0 +1,1064 @@
+#include <pch.h>
+#include <core/render/pngwriter.h>
+
+#include <bit>
+
+// each job filters and compresses about this much image data, anything smaller is written on the calling thread
+// matches can't reach back past the start of a job, so this trades a little size for parallelism
+static constexpr size_t s_pngJobBytes = 1ull << 20ull;
+
+// tokens buffered before a deflate block is written out
+static constexpr size_t s_deflateBlockTokens = 1ull << 15ull;
+
+static constexpr uint32_t s_deflateWindowSize = 32768u;
+static constexpr uint32_t s_deflateMinMatch = 3u;
+static constexpr uint32_t s_deflateMaxMatch = 258u;
+static constexpr uint32_t s_deflateMaxStored = 65535u;
+
+static constexpr uint32_t s_deflateHashBits = 15u;
+
+static const uint8_t s_pngSignature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+
+enum ePngFilter : uint8_t
+{
+    PNG_FILTER_NONE,
+    PNG_FILTER_SUB,
+    PNG_FILTER_UP,
+    PNG_FILTER_AVERAGE,
+    PNG_FILTER_PAETH,
+
+    PNG_FILTER_COUNT,
+};
+
+struct PngCompressionLevel_t
+{
+    bool store; // stored blocks only
+    bool adaptiveFilter; // pick the best filter per row, otherwise rows always use filter
+    ePngFilter filter;
+    uint32_t maxChain; // how many earlier positions are tried for each match
+    uint32_t goodMatch; // stop searching once a match is this long
+    bool lazy; // check if the next byte has a longer match before taking one
+};
+
+static const PngCompressionLevel_t s_PngCompressionLevels[ePngExportCompression::PNG_COMPRESSION_COUNT] =
+{
+    { true, false, PNG_FILTER_NONE, 0u, 0u, false },
+    { false, false, PNG_FILTER_UP, 4u, 16u, false }, // same filter wic was told to use
+    { false, true, PNG_FILTER_NONE, 32u, 64u, true },
+    { false, true, PNG_FILTER_NONE, 128u, s_deflateMaxMatch, true },
+};
+
+//
+// CHECKSUMS
+//
+struct Crc32Table_t
+{
+    Crc32Table_t()
+    {
+        for (uint32_t i = 0u; i < 256u; i++)
+        {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; bit++)
+                crc = (crc & 1u) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+
+            table[i] = crc;
+        }
+    }
+
+    uint32_t table[256];
+};
+
+static const Crc32Table_t s_crc32Table;
+
+// crc is the running value, start with zero
+static uint32_t Crc32(uint32_t crc, const uint8_t* const data, const size_t size)
+{
+    crc = ~crc;
+    for (size_t i = 0; i < size; i++)
+        crc = s_crc32Table.table[(crc ^ data[i]) & 0xFFu] ^ (crc >> 8);
+
+    return ~crc;
+}
+
+static constexpr uint32_t s_adlerBase = 65521u;
+
+// adler is the running value, start with one
+static uint32_t Adler32(const uint32_t adler, const uint8_t* const data, const size_t size)
+{
+    // most bytes that can be summed before sum2 could overflow
+    constexpr size_t maxRun = 5552ull;
+
+    uint32_t sum1 = adler & 0xFFFFu;
+    uint32_t sum2 = adler >> 16;
+
+    size_t pos = 0;
+    while (pos < size)
+    {
+        const size_t run = std::min(size - pos, maxRun);
+        for (size_t i = 0; i < run; i++)
+        {
+            sum1 += data[pos + i];
+            sum2 += sum1;
+        }
+
+        sum1 %= s_adlerBase;
+        sum2 %= s_adlerBase;
+
+        pos += run;
+    }
+
+    return sum1 | (sum2 << 16);
+}
+
+// adler of two buffers back to back, from the adler of each and the size of the second
+static uint32_t Adler32Combine(const uint32_t adler1, const uint32_t adler2, const size_t size2)
+{
+    const uint32_t rem = static_cast<uint32_t>(size2 % s_adlerBase);
+
+    uint32_t sum1 = adler1 & 0xFFFFu;
+    uint32_t sum2 = static_cast<uint32_t>((static_cast<uint64_t>(rem) * sum1) % s_adlerBase);
+
+    sum1 += (adler2 & 0xFFFFu) + s_adlerBase - 1u;
+    sum2 += (adler1 >> 16) + (adler2 >> 16) + s_adlerBase - rem;
+
+    if (sum1 >= s_adlerBase)
+        sum1 -= s_adlerBase;
+    if (sum1 >= s_adlerBase)
+        sum1 -= s_adlerBase;
+    if (sum2 >= (s_adlerBase << 1))
+        sum2 -= (s_adlerBase << 1);
+    if (sum2 >= s_adlerBase)
+        sum2 -= s_adlerBase;
+
+    return sum1 | (sum2 << 16);
+}
+
+//
+// DEFLATE
+//
+static const uint16_t s_deflateLengthBase[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+static const uint8_t s_deflateLengthExtra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+
+static const uint16_t s_deflateDistBase[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+static const uint8_t s_deflateDistExtra[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+// order the code length code lengths are written in
+static const uint8_t s_deflateCodeLengthOrder[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+static constexpr uint32_t s_deflateLitLenCodes = 286u;
+static constexpr uint32_t s_deflateDistCodes = 30u;
+static constexpr uint32_t s_deflateCodeLengthCodes = 19u;
+static constexpr uint32_t s_deflateEndOfBlock = 256u;
+
+// lookups from match length and distance to their code
+struct DeflateCodeTable_t
+{
+    DeflateCodeTable_t()
+    {
+        for (uint8_t code = 0; code < 29; code++)
+        {
+            const uint32_t count = 1u << s_deflateLengthExtra[code];
+            for (uint32_t i = 0u; i < count && s_deflateLengthBase[code] + i <= s_deflateMaxMatch; i++)
+                lengthCode[s_deflateLengthBase[code] + i] = code;
+        }
+
+        // 258 has its own code instead of being the end of 227's range
+        lengthCode[s_deflateMaxMatch] = 28;
+
+        for (uint8_t code = 0; code < 30; code++)
+        {
+            const uint32_t count = 1u << s_deflateDistExtra[code];
+            for (uint32_t i = 0u; i < count; i++)
+            {
+                const uint32_t dist = s_deflateDistBase[code] + i;
+                if (dist <= 256u)
+                    distCodeLow[dist] = code;
+                else
+                    distCodeHigh[(dist - 1u) >> 7] = code;
+            }
+        }
+    }
+
+    inline const uint8_t DistCode(const uint32_t dist) const
+    {
+        return dist <= 256u ? distCodeLow[dist] : distCodeHigh[(dist - 1u) >> 7];
+    }
+
+    uint8_t lengthCode[s_deflateMaxMatch + 1];
+    uint8_t distCodeLow[257];
+    uint8_t distCodeHigh[256];
+};
+
+static const DeflateCodeTable_t s_deflateCodeTable;
+
+// a literal if dist is zero, otherwise a match
+struct DeflateToken_t
+{
+    uint16_t litLen;
+    uint16_t dist;
+};
+
+class CDeflateBitWriter
+{
+public:
+    CDeflateBitWriter(std::vector<uint8_t>* const outBuf) : out(outBuf), bits(0ull), bitCount(0u) {};
+
+    // lowest bit first
+    inline void Write(const uint32_t value, const uint32_t count)
+    {
+        bits |= static_cast<uint64_t>(value) << bitCount;
+        bitCount += count;
+
+        while (bitCount >= 8u)
+        {
+            out->push_back(static_cast<uint8_t>(bits));
+            bits >>= 8;
+            bitCount -= 8u;
+        }
+    }
+
+    inline void AlignToByte()
+    {
+        if (bitCount > 0u)
+        {
+            out->push_back(static_cast<uint8_t>(bits));
+            bits = 0ull;
+            bitCount = 0u;
+        }
+    }
+
+    inline void WriteBytes(const uint8_t* const data, const size_t size)
+    {
+        assertm(bitCount == 0u, "writing bytes while not aligned");
+        out->insert(out->end(), data, data + size);
+    }
+
+private:
+    std::vector<uint8_t>* out;
+
+    uint64_t bits;
+    uint32_t bitCount;
+};
+
+// huffman code lengths for the given frequencies, no longer than maxBits
+static void BuildCodeLengths(const uint32_t* const freqs, const uint32_t count, const uint32_t maxBits, uint8_t* const lengths)
+{
+    memset(lengths, 0, count);
+
+    std::vector<uint32_t> scaledFreqs(freqs, freqs + count);
+
+    uint32_t numUsed = 0u;
+    uint32_t lastUsed = 0u;
+    for (uint32_t i = 0u; i < count; i++)
+    {
+        if (scaledFreqs[i] > 0u)
+        {
+            numUsed++;
+            lastUsed = i;
+        }
+    }
+
+    if (numUsed == 0u)
+        return;
+
+    // a single code still needs a length, decoders accept one code of one bit
+    if (numUsed == 1u)
+    {
+        lengths[lastUsed] = 1u;
+        return;
+    }
+
+    struct Node_t
+    {
+        uint32_t freq;
+        int32_t left;
+        int32_t right;
+    };
+
+    std::vector<Node_t> nodes;
+    std::vector<uint8_t> depths;
+    nodes.reserve(count * 2u);
+
+    while (true)
+    {
+        nodes.clear();
+
+        using Entry_t = std::pair<uint32_t, int32_t>; // freq, node
+        std::priority_queue<Entry_t, std::vector<Entry_t>, std::greater<Entry_t>> queue;
+
+        for (uint32_t i = 0u; i < count; i++)
+        {
+            if (scaledFreqs[i] == 0u)
+                continue;
+
+            queue.emplace(scaledFreqs[i], static_cast<int32_t>(nodes.size()));
+            nodes.push_back({ scaledFreqs[i], -1, static_cast<int32_t>(i) }); // leaves keep their symbol in right
+        }
+
+        while (queue.size() > 1)
+        {
+            const Entry_t a = queue.top();
+            queue.pop();
+            const Entry_t b = queue.top();
+            queue.pop();
+
+            queue.emplace(a.first + b.first, static_cast<int32_t>(nodes.size()));
+            nodes.push_back({ a.first + b.first, a.second, b.second });
+        }
+
+        // parents always come after their children, so walk back from the root
+        depths.assign(nodes.size(), 0u);
+
+        uint32_t maxDepth = 0u;
+        for (int32_t i = static_cast<int32_t>(nodes.size()) - 1; i >= 0; i--)
+        {
+            const Node_t& node = nodes[i];
+            if (node.left < 0)
+            {
+                lengths[node.right] = depths[i];
+                maxDepth = std::max(maxDepth, static_cast<uint32_t>(depths[i]));
+
+                continue;
+            }
+
+            depths[node.left] = depths[i] + 1u;
+            depths[node.right] = depths[i] + 1u;
+        }
+
+        if (maxDepth <= maxBits)
+            return;
+
+        // flatten the frequencies and try again, each pass brings rare symbols closer to common ones
+        for (uint32_t i = 0u; i < count; i++)
+        {
+            if (scaledFreqs[i] > 0u)
+                scaledFreqs[i] = (scaledFreqs[i] >> 1) | 1u;
+        }
+    }
+}
+
+// canonical codes from code lengths, bit reversed since deflate writes huffman codes highest bit first
+static void BuildCodes(const uint8_t* const lengths, const uint32_t count, uint16_t* const codes)
+{
+    uint32_t lengthCounts[16] = {};
+    for (uint32_t i = 0u; i < count; i++)
+        lengthCounts[lengths[i]]++;
+
+    lengthCounts[0] = 0u;
+
+    uint32_t nextCode[16] = {};
+    uint32_t code = 0u;
+    for (uint32_t bits = 1u; bits < 16u; bits++)
+    {
+        code = (code + lengthCounts[bits - 1u]) << 1;
+        nextCode[bits] = code;
+    }
+
+    for (uint32_t i = 0u; i < count; i++)
+    {
+        const uint32_t length = lengths[i];
+        if (length == 0u)
+        {
+            codes[i] = 0u;
+            continue;
+        }
+
+        uint32_t value = nextCode[length]++;
+        uint32_t reversed = 0u;
+        for (uint32_t bit = 0u; bit < length; bit++)
+        {
+            reversed = (reversed << 1) | (value & 1u);
+            value >>= 1;
+        }
+
+        codes[i] = static_cast<uint16_t>(reversed);
+    }
+}
+
+class CDeflateCompressor
+{
+public:
+    CDeflateCompressor(const PngCompressionLevel_t* const compressionLevel, std::vector<uint8_t>* const out) : level(compressionLevel), writer(out)
+    {
+        if (!level->store)
+        {
+            head = std::make_unique<int32_t[]>(1ull << s_deflateHashBits);
+            prev = std::make_unique<int32_t[]>(s_deflateWindowSize);
+
+            std::fill_n(head.get(), 1ull << s_deflateHashBits, -1);
+
+            tokens.reserve(s_deflateBlockTokens);
+        }
+    }
+
+    // compresses data as a run of blocks, the last block is only marked final if isFinal is set.
+    // the output always ends on a byte boundary so the next part of the stream can be appended as is.
+    void Compress(const uint8_t* const data, const size_t size, const bool isFinal)
+    {
+        if (level->store)
+            WriteStored(data, size, isFinal);
+        else
+            CompressLZ(data, size, isFinal);
+
+        // empty stored block, brings us back to a byte boundary without ending the stream
+        if (!isFinal)
+        {
+            writer.Write(0u, 3u);
+            writer.AlignToByte();
+            writer.Write(0x0000u, 16u);
+            writer.Write(0xFFFFu, 16u);
+        }
+
+        writer.AlignToByte();
+    }
+
+private:
+    void WriteStored(const uint8_t* const data, const size_t size, const bool isFinal)
+    {
+        size_t pos = 0;
+        do
+        {
+            const uint32_t blockSize = static_cast<uint32_t>(std::min<size_t>(size - pos, s_deflateMaxStored));
+            const bool lastBlock = isFinal && pos + blockSize == size;
+
+            writer.Write(lastBlock ? 1u : 0u, 1u);
+            writer.Write(0u, 2u);
+            writer.AlignToByte();
+            writer.Write(blockSize, 16u);
+            writer.Write(~blockSize & 0xFFFFu, 16u);
+            writer.WriteBytes(data + pos, blockSize);
+
+            pos += blockSize;
+        } while (pos < size);
+    }
+
+    static inline uint32_t Hash(const uint8_t* const data)
+    {
+        const uint32_t value = data[0] | (data[1] << 8) | (data[2] << 16);
+        return (value * 2654435761u) >> (32u - s_deflateHashBits);
+    }
+
+    inline void Insert(const uint8_t* const data, const size_t pos)
+    {
+        const uint32_t hash = Hash(data + pos);
+
+        prev[pos & (s_deflateWindowSize - 1u)] = head[hash];
+        head[hash] = static_cast<int32_t>(pos);
+    }
+
+    // compares eight bytes at a time while there's room for it
+    static inline uint32_t MatchLength(const uint8_t* const a, const uint8_t* const b, const uint32_t maxLength)
+    {
+        uint32_t length = 0u;
+        while (length + 8u <= maxLength)
+        {
+            uint64_t valueA = 0ull;
+            uint64_t valueB = 0ull;
+            memcpy(&valueA, a + length, sizeof(uint64_t));
+            memcpy(&valueB, b + length, sizeof(uint64_t));
+
+            const uint64_t diff = valueA ^ valueB;
+            if (diff != 0ull)
+                return length + static_cast<uint32_t>(std::countr_zero(diff) >> 3);
+
+            length += 8u;
+        }
+
+        while (length < maxLength && a[length] == b[length])
+            length++;
+
+        return length;
+    }
+
+    // longest earlier match for pos, pos has to have been inserted already
+    uint32_t FindMatch(const uint8_t* const data, const size_t size, const size_t pos, uint32_t* const outDist) const
+    {
+        const uint32_t maxLength = static_cast<uint32_t>(std::min<size_t>(size - pos, s_deflateMaxMatch));
+        if (maxLength < s_deflateMinMatch)
+            return 0u;
+
+        uint32_t bestLength = s_deflateMinMatch - 1u;
+        uint32_t bestDist = 0u;
+
+        int32_t candidate = prev[pos & (s_deflateWindowSize - 1u)];
+        for (uint32_t chain = 0u; chain < level->maxChain && candidate >= 0; chain++)
+        {
+            const size_t dist = pos - static_cast<size_t>(candidate);
+            if (dist > s_deflateWindowSize - 1u)
+                break;
+
+            const uint8_t* const a = data + pos;
+            const uint8_t* const b = data + candidate;
+
+            // can't beat the best match unless the byte at its end matches
+            if (b[bestLength] == a[bestLength] && b[0] == a[0])
+            {
+                const uint32_t length = MatchLength(a, b, maxLength);
+
+                if (length > bestLength)
+                {
+                    bestLength = length;
+                    bestDist = static_cast<uint32_t>(dist);
+
+                    if (length >= level->goodMatch || length == maxLength)
+                        break;
+                }
+            }
+
+            candidate = prev[candidate & (s_deflateWindowSize - 1u)];
+        }
+
+        if (bestDist == 0u)
+            return 0u;
+
+        *outDist = bestDist;
+        return bestLength;
+    }
+
+    void CompressLZ(const uint8_t* const data, const size_t size, const bool isFinal)
+    {
+        size_t blockStart = 0;
+        size_t pos = 0;
+
+        const auto canHash = [size](const size_t at) { return at + s_deflateMinMatch <= size; };
+
+        // match found at the last position when looking ahead
+        uint32_t pendingLength = 0u;
+        uint32_t pendingDist = 0u;
+
+        while (pos < size)
+        {
+            uint32_t length = 0u;
+            uint32_t dist = 0u;
+
+            if (pendingLength > 0u)
+            {
+                length = pendingLength;
+                dist = pendingDist;
+                pendingLength = 0u;
+            }
+            else if (canHash(pos))
+            {
+                Insert(data, pos);
+                length = FindMatch(data, size, pos, &dist);
+            }
+
+            if (length >= s_deflateMinMatch && level->lazy && length < level->goodMatch && canHash(pos + 1))
+            {
+                // a longer match one byte later is worth a literal
+                Insert(data, pos + 1);
+
+                uint32_t nextDist = 0u;
+                const uint32_t nextLength = FindMatch(data, size, pos + 1, &nextDist);
+                if (nextLength > length)
+                {
+                    tokens.push_back({ data[pos], 0u });
+                    pos++;
+
+                    pendingLength = nextLength;
+                    pendingDist = nextDist;
+                }
+                else
+                {
+                    tokens.push_back({ static_cast<uint16_t>(length), static_cast<uint16_t>(dist) });
+
+                    // pos + 1 is already in
+                    for (size_t i = pos + 2; i < pos + length && canHash(i); i++)
+                        Insert(data, i);
+
+                    pos += length;
+                }
+            }
+            else if (length >= s_deflateMinMatch)
+            {
+                tokens.push_back({ static_cast<uint16_t>(length), static_cast<uint16_t>(dist) });
+
+                for (size_t i = pos + 1; i < pos + length && canHash(i); i++)
+                    Insert(data, i);
+
+                pos += length;
+            }
+            else
+            {
+                tokens.push_back({ data[pos], 0u });
+                pos++;
+            }
+
+            // the last block is always written below, so it can be marked final
+            if (tokens.size() >= s_deflateBlockTokens && pos < size)
+            {
+                WriteBlock(data + blockStart, pos - blockStart, false);
+                blockStart = pos;
+            }
+        }
+
+        WriteBlock(data + blockStart, pos - blockStart, isFinal);
+    }
+
+    // writes the buffered tokens as a dynamic huffman block, or stored if that ends up smaller
+    void WriteBlock(const uint8_t* const data, const size_t size, const bool isFinal)
+    {
+        uint32_t litLenFreqs[s_deflateLitLenCodes] = {};
+        uint32_t distFreqs[s_deflateDistCodes] = {};
+
+        for (const DeflateToken_t& token : tokens)
+        {
+            if (token.dist == 0u)
+            {
+                litLenFreqs[token.litLen]++;
+                continue;
+            }
+
+            litLenFreqs[257u + s_deflateCodeTable.lengthCode[token.litLen]]++;
+            distFreqs[s_deflateCodeTable.DistCode(token.dist)]++;
+        }
+
+        litLenFreqs[s_deflateEndOfBlock] = 1u;
+
+        uint8_t litLenLengths[s_deflateLitLenCodes] = {};
+        uint8_t distLengths[s_deflateDistCodes] = {};
+        BuildCodeLengths(litLenFreqs, s_deflateLitLenCodes, 15u, litLenLengths);
+        BuildCodeLengths(distFreqs, s_deflateDistCodes, 15u, distLengths);
+
+        // blocks without matches still need one distance code
+        if (std::all_of(distLengths, distLengths + s_deflateDistCodes, [](const uint8_t length) { return length == 0u; }))
+            distLengths[0] = 1u;
+
+        uint32_t numLitLen = s_deflateLitLenCodes;
+        while (numLitLen > 257u && litLenLengths[numLitLen - 1u] == 0u)
+            numLitLen--;
+
+        uint32_t numDist = s_deflateDistCodes;
+        while (numDist > 1u && distLengths[numDist - 1u] == 0u)
+            numDist--;
+
+        // both sets of lengths are run length encoded as one sequence
+        uint8_t allLengths[s_deflateLitLenCodes + s_deflateDistCodes] = {};
+        memcpy(allLengths, litLenLengths, numLitLen);
+        memcpy(allLengths + numLitLen, distLengths, numDist);
+
+        const uint32_t numLengths = numLitLen + numDist;
+
+        std::vector<std::pair<uint8_t, uint8_t>> lengthSymbols; // symbol, extra bits value
+        lengthSymbols.reserve(numLengths);
+
+        for (uint32_t i = 0u; i < numLengths;)
+        {
+            const uint8_t length = allLengths[i];
+
+            uint32_t run = 1u;
+            while (i + run < numLengths && allLengths[i + run] == length)
+                run++;
+
+            if (length == 0u && run >= 3u)
+            {
+                run = std::min(run, 138u);
+                if (run >= 11u)
+                    lengthSymbols.emplace_back(18u, static_cast<uint8_t>(run - 11u));
+                else
+                    lengthSymbols.emplace_back(17u, static_cast<uint8_t>(run - 3u));
+            }
+            else if (length != 0u && run >= 4u)
+            {
+                // the first one has to be written as is, the rest can repeat it
+                lengthSymbols.emplace_back(length, 0u);
+
+                run = std::min(run - 1u, 6u) + 1u;
+                lengthSymbols.emplace_back(16u, static_cast<uint8_t>(run - 4u));
+            }
+            else
+            {
+                run = 1u;
+                lengthSymbols.emplace_back(length, 0u);
+            }
+
+            i += run;
+        }
+
+        uint32_t codeLengthFreqs[s_deflateCodeLengthCodes] = {};
+        for (const std::pair<uint8_t, uint8_t>& symbol : lengthSymbols)
+            codeLengthFreqs[symbol.first]++;
+
+        uint8_t codeLengthLengths[s_deflateCodeLengthCodes] = {};
+        BuildCodeLengths(codeLengthFreqs, s_deflateCodeLengthCodes, 7u, codeLengthLengths);
+
+        uint32_t numCodeLengths = s_deflateCodeLengthCodes;
+        while (numCodeLengths > 4u && codeLengthLengths[s_deflateCodeLengthOrder[numCodeLengths - 1u]] == 0u)
+            numCodeLengths--;
+
+        // work out if the huffman block is actually any smaller than storing the data
+        uint64_t dynamicBits = 3ull + 5ull + 5ull + 4ull + (numCodeLengths * 3ull);
+        for (const std::pair<uint8_t, uint8_t>& symbol : lengthSymbols)
+            dynamicBits += codeLengthLengths[symbol.first] + (symbol.first == 16u ? 2u : symbol.first == 17u ? 3u : symbol.first == 18u ? 7u : 0u);
+
+        for (uint32_t i = 0u; i < s_deflateLitLenCodes; i++)
+            dynamicBits += static_cast<uint64_t>(litLenFreqs[i]) * (litLenLengths[i] + (i > 256u ? s_deflateLengthExtra[i - 257u] : 0u));
+
+        for (uint32_t i = 0u; i < s_deflateDistCodes; i++)
+            dynamicBits += static_cast<uint64_t>(distFreqs[i]) * (distLengths[i] + s_deflateDistExtra[i]);
+
+        const uint64_t storedBits = (static_cast<uint64_t>(size) + (((size / s_deflateMaxStored) + 1ull) * 5ull)) * 8ull;
+        if (storedBits <= dynamicBits)
+        {
+            WriteStored(data, size, isFinal);
+            tokens.clear();
+
+            return;
+        }
+
+        uint16_t litLenCodes[s_deflateLitLenCodes] = {};
+        uint16_t distCodes[s_deflateDistCodes] = {};
+        uint16_t codeLengthCodes[s_deflateCodeLengthCodes] = {};
+        BuildCodes(litLenLengths, s_deflateLitLenCodes, litLenCodes);
+        BuildCodes(distLengths, s_deflateDistCodes, distCodes);
+        BuildCodes(codeLengthLengths, s_deflateCodeLengthCodes, codeLengthCodes);
+
+        writer.Write(isFinal ? 1u : 0u, 1u);
+        writer.Write(2u, 2u); // dynamic huffman
+        writer.Write(numLitLen - 257u, 5u);
+        writer.Write(numDist - 1u, 5u);
+        writer.Write(numCodeLengths - 4u, 4u);
+
+        for (uint32_t i = 0u; i < numCodeLengths; i++)
+            writer.Write(codeLengthLengths[s_deflateCodeLengthOrder[i]], 3u);
+
+        for (const std::pair<uint8_t, uint8_t>& symbol : lengthSymbols)
+        {
+            writer.Write(codeLengthCodes[symbol.first], codeLengthLengths[symbol.first]);
+
+            if (symbol.first == 16u)
+                writer.Write(symbol.second, 2u);
+            else if (symbol.first == 17u)
+                writer.Write(symbol.second, 3u);
+            else if (symbol.first == 18u)
+                writer.Write(symbol.second, 7u);
+        }
+
+        for (const DeflateToken_t& token : tokens)
+        {
+            if (token.dist == 0u)
+            {
+                writer.Write(litLenCodes[token.litLen], litLenLengths[token.litLen]);
+                continue;
+            }
+
+            const uint8_t lengthCode = s_deflateCodeTable.lengthCode[token.litLen];
+            writer.Write(litLenCodes[257u + lengthCode], litLenLengths[257u + lengthCode]);
+            writer.Write(token.litLen - s_deflateLengthBase[lengthCode], s_deflateLengthExtra[lengthCode]);
+
+            const uint8_t distCode = s_deflateCodeTable.DistCode(token.dist);
+            writer.Write(distCodes[distCode], distLengths[distCode]);
+            writer.Write(token.dist - s_deflateDistBase[distCode], s_deflateDistExtra[distCode]);
+        }
+
+        writer.Write(litLenCodes[s_deflateEndOfBlock], litLenLengths[s_deflateEndOfBlock]);
+
+        tokens.clear();
+    }
+
+    const PngCompressionLevel_t* level;
+    CDeflateBitWriter writer;
+
+    std::unique_ptr<int32_t[]> head; // most recent position for each hash
+    std::unique_ptr<int32_t[]> prev; // previous position with the same hash, indexed by position in the window
+
+    std::vector<DeflateToken_t> tokens;
+};
+
+//
+// PNG
+//
+static inline uint8_t PaethPredictor(const uint8_t a, const uint8_t b, const uint8_t c)
+{
+    const int p = static_cast<int>(a) + static_cast<int>(b) - static_cast<int>(c);
+    const int pa = abs(p - static_cast<int>(a));
+    const int pb = abs(p - static_cast<int>(b));
+    const int pc = abs(p - static_cast<int>(c));
+
+    if (pa <= pb && pa <= pc)
+        return a;
+
+    return pb <= pc ? b : c;
+}
+
+// prev is all zero for the first row of the image
+static void FilterRow(const ePngFilter filter, const uint8_t* const row, const uint8_t* const prev, const size_t rowBytes, const uint32_t bpp, uint8_t* const out)
+{
+    switch (filter)
+    {
+    case PNG_FILTER_NONE:
+    {
+        memcpy(out, row, rowBytes);
+        break;
+    }
+    case PNG_FILTER_SUB:
+    {
+        for (size_t i = 0; i < rowBytes; i++)
+            out[i] = static_cast<uint8_t>(row[i] - (i >= bpp ? row[i - bpp] : 0u));
+
+        break;
+    }
+    case PNG_FILTER_UP:
+    {
+        for (size_t i = 0; i < rowBytes; i++)
+            out[i] = static_cast<uint8_t>(row[i] - prev[i]);
+
+        break;
+    }
+    case PNG_FILTER_AVERAGE:
+    {
+        for (size_t i = 0; i < rowBytes; i++)
+            out[i] = static_cast<uint8_t>(row[i] - (((i >= bpp ? row[i - bpp] : 0u) + prev[i]) >> 1));
+
+        break;
+    }
+    case PNG_FILTER_PAETH:
+    {
+        for (size_t i = 0; i < rowBytes; i++)
+            out[i] = static_cast<uint8_t>(row[i] - PaethPredictor(i >= bpp ? row[i - bpp] : 0, prev[i], i >= bpp ? prev[i - bpp] : 0));
+
+        break;
+    }
+    default:
+        unreachable();
+    }
+}
+
+// converts a row of source pixels to the channel order png wants
+static void ConvertRow(const uint8_t* const src, const size_t width, const DXGI_FORMAT format, uint8_t* const out)
+{
+    switch (format)
+    {
+    case DXGI_FORMAT_R8G8B8A8_UNORM:
+    case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+    {
+        memcpy(out, src, width * 4ull);
+        break;
+    }
+    case DXGI_FORMAT_B8G8R8A8_UNORM:
+    case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+    {
+        for (size_t i = 0; i < width; i++)
+        {
+            out[(i * 4) + 0] = src[(i * 4) + 2];
+            out[(i * 4) + 1] = src[(i * 4) + 1];
+            out[(i * 4) + 2] = src[(i * 4) + 0];
+            out[(i * 4) + 3] = src[(i * 4) + 3];
+        }
+
+        break;
+    }
+    case DXGI_FORMAT_B8G8R8X8_UNORM:
+    {
+        for (size_t i = 0; i < width; i++)
+        {
+            out[(i * 3) + 0] = src[(i * 4) + 2];
+            out[(i * 3) + 1] = src[(i * 4) + 1];
+            out[(i * 3) + 2] = src[(i * 4) + 0];
+        }
+
+        break;
+    }
+    default:
+        unreachable();
+    }
+}
+
+const bool CanWritePng(const DXGI_FORMAT format)
+{
+    switch (format)
+    {
+    case DXGI_FORMAT_R8G8B8A8_UNORM:
+    case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+    case DXGI_FORMAT_B8G8R8A8_UNORM:
+    case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+    case DXGI_FORMAT_B8G8R8X8_UNORM:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// one IDAT worth of compressed rows
+struct PngImageChunk_t
+{
+    std::vector<uint8_t> data; // chunk type followed by the compressed data, so the crc can be taken over it in one go
+    uint32_t crc;
+    uint32_t adler; // of the filtered rows
+    size_t filteredSize;
+};
+
+static void CompressPngRows(const uint8_t* const pixels, const size_t rowPitch, const size_t width, const DXGI_FORMAT format, const uint32_t channels, const PngCompressionLevel_t* const level,
+    const size_t firstRow, const size_t lastRow, const bool isFirst, const bool isLast, PngImageChunk_t* const chunk)
+{
+    const size_t rowBytes = width * channels;
+    const size_t filteredSize = (lastRow - firstRow) * (rowBytes + 1ull);
+
+    std::unique_ptr<uint8_t[]> filtered = std::make_unique<uint8_t[]>(filteredSize);
+
+    std::unique_ptr<uint8_t[]> rowBuf = std::make_unique<uint8_t[]>(rowBytes * 2ull);
+    std::unique_ptr<uint8_t[]> scratch = std::make_unique<uint8_t[]>(rowBytes * PNG_FILTER_COUNT);
+
+    uint8_t* curRow = rowBuf.get();
+    uint8_t* prevRow = rowBuf.get() + rowBytes;
+
+    // filters look at the row above, even if it belongs to another job
+    if (firstRow > 0ull)
+        ConvertRow(pixels + ((firstRow - 1ull) * rowPitch), width, format, prevRow);
+    else
+        memset(prevRow, 0, rowBytes);
+
+    for (size_t row = firstRow; row < lastRow; row++)
+    {
+        ConvertRow(pixels + (row * rowPitch), width, format, curRow);
+
+        uint8_t* const out = filtered.get() + ((row - firstRow) * (rowBytes + 1ull));
+
+        ePngFilter filter = level->filter;
+        if (level->adaptiveFilter)
+        {
+            // smallest sum of the filtered bytes as signed values, the usual heuristic
+            uint64_t bestSum = UINT64_MAX;
+            for (uint8_t i = 0; i < PNG_FILTER_COUNT; i++)
+            {
+                uint8_t* const filterOut = scratch.get() + (i * rowBytes);
+                FilterRow(static_cast<ePngFilter>(i), curRow, prevRow, rowBytes, channels, filterOut);
+
+                uint64_t sum = 0ull;
+                for (size_t j = 0; j < rowBytes; j++)
+                    sum += static_cast<uint64_t>(abs(static_cast<int8_t>(filterOut[j])));
+
+                if (sum < bestSum)
+                {
+                    bestSum = sum;
+                    filter = static_cast<ePngFilter>(i);
+                }
+            }
+
+            memcpy(out + 1, scratch.get() + (filter * rowBytes), rowBytes);
+        }
+        else
+        {
+            FilterRow(filter, curRow, prevRow, rowBytes, channels, out + 1);
+        }
+
+        out[0] = static_cast<uint8_t>(filter);
+
+        std::swap(curRow, prevRow);
+    }
+
+    chunk->data.clear();
+    chunk->data.reserve(filteredSize + (filteredSize / s_deflateMaxStored * 5ull) + 64ull);
+    chunk->data.insert(chunk->data.end(), { 'I', 'D', 'A', 'T' });
+
+    // zlib header, 32k window with no preset dictionary
+    if (isFirst)
+        chunk->data.insert(chunk->data.end(), { 0x78, static_cast<uint8_t>(level->store ? 0x01 : 0x9C) });
+
+    CDeflateCompressor compressor(level, &chunk->data);
+    compressor.Compress(filtered.get(), filteredSize, isLast);
+
+    chunk->crc = Crc32(0u, chunk->data.data(), chunk->data.size());
+    chunk->adler = Adler32(1u, filtered.get(), filteredSize);
+    chunk->filteredSize = filteredSize;
+}
+
+static void WritePngChunk(StreamIO& out, const char* const type, const uint8_t* const data, const uint32_t size)
+{
+    std::vector<uint8_t> typeAndData(size + 4u);
+    memcpy(typeAndData.data(), type, 4);
+    if (size > 0u)
+        memcpy(typeAndData.data() + 4, data, size);
+
+    const uint32_t sizeBE = _byteswap_ulong(size);
+    const uint32_t crcBE = _byteswap_ulong(Crc32(0u, typeAndData.data(), typeAndData.size()));
+
+    out.write(reinterpret_cast<const char*>(&sizeBE), sizeof(uint32_t));
+    out.write(reinterpret_cast<const char*>(typeAndData.data()), typeAndData.size());
+    out.write(reinterpret_cast<const char*>(&crcBE), sizeof(uint32_t));
+}
+
+const bool WritePng(const std::filesystem::path& exportPath, const uint8_t* const pixels, const size_t rowPitch, const size_t width, const size_t height, const DXGI_FORMAT format, const uint32_t compression)
+{
+    if (!CanWritePng(format) || width == 0ull || height == 0ull || width > UINT32_MAX || height > UINT32_MAX)
+        return false;
+
+    const PngCompressionLevel_t* const level = &s_PngCompressionLevels[compression < ePngExportCompression::PNG_COMPRESSION_COUNT ? compression : ePngExportCompression::PNG_COMPRESSION_DEFAULT];
+
+    const uint32_t channels = format == DXGI_FORMAT_B8G8R8X8_UNORM ? 3u : 4u;
+    const size_t rowBytes = width * channels;
+
+    const size_t rowsPerJob = std::max<size_t>(1ull, s_pngJobBytes / rowBytes);
+    const size_t numJobs = (height + rowsPerJob - 1ull) / rowsPerJob;
+
+    std::vector<PngImageChunk_t> chunks(numJobs);
+
+    const auto compressJob = [&chunks, pixels, rowPitch, width, height, format, channels, level, rowsPerJob, numJobs](const size_t job)
+        {
+            const size_t firstRow = job * rowsPerJob;
+            const size_t lastRow = std::min<size_t>(firstRow + rowsPerJob, height);
+
+            CompressPngRows(pixels, rowPitch, width, format, channels, level, firstRow, lastRow, job == 0ull, job == numJobs - 1ull, &chunks[job]);
+        };
+
+    if (numJobs == 1ull)
+    {
+        compressJob(0ull);
+    }
+    else
+    {
+        CTaskGroup compressJobs;
+        for (size_t job = 0; job < numJobs; job++)
+            compressJobs.run([compressJob, job]() { compressJob(job); });
+
+        compressJobs.wait();
+    }
+
+    StreamIO out(exportPath, eStreamIOMode::Write);
+    if (!out.checkWritabilityStatus())
+        return false;
+
+    out.write(reinterpret_cast<const char*>(s_pngSignature), sizeof(s_pngSignature));
+
+    uint8_t header[13] = {};
+    const uint32_t widthBE = _byteswap_ulong(static_cast<uint32_t>(width));
+    const uint32_t heightBE = _byteswap_ulong(static_cast<uint32_t>(height));
+    memcpy(header, &widthBE, sizeof(uint32_t));
+    memcpy(header + 4, &heightBE, sizeof(uint32_t));
+    header[8] = 8; // bit depth
+    header[9] = static_cast<uint8_t>(channels == 4u ? 6 : 2); // rgba or rgb
+    header[10] = 0; // deflate
+    header[11] = 0; // adaptive filtering
+    header[12] = 0; // not interlaced
+
+    WritePngChunk(out, "IHDR", header, sizeof(header));
+
+    const uint8_t renderingIntent = 0; // perceptual
+    WritePngChunk(out, "sRGB", &renderingIntent, sizeof(renderingIntent));
+
+    // every job already made its own IDAT, the zlib stream just carries on across them
+    uint32_t adler = 1u;
+    for (size_t job = 0; job < numJobs; job++)
+    {
+        const PngImageChunk_t& chunk = chunks[job];
+
+        const uint32_t sizeBE = _byteswap_ulong(static_cast<uint32_t>(chunk.data.size() - 4ull));
+        const uint32_t crcBE = _byteswap_ulong(chunk.crc);
+
+        out.write(reinterpret_cast<const char*>(&sizeBE), sizeof(uint32_t));
+        out.write(reinterpret_cast<const char*>(chunk.data.data()), chunk.data.size());
+        out.write(reinterpret_cast<const char*>(&crcBE), sizeof(uint32_t));
+
+        adler = job == 0ull ? chunk.adler : Adler32Combine(adler, chunk.adler, chunk.filteredSize);
+    }
+
+    // the adler of the whole stream is only known once every job is done, so it gets an IDAT of its own
+    const uint32_t adlerBE = _byteswap_ulong(adler);
+    WritePngChunk(out, "IDAT", reinterpret_cast<const uint8_t*>(&adlerBE), sizeof(uint32_t));
+
+    WritePngChunk(out, "IEND", nullptr, 0u);
+
+    out.close();
+
+    return true;
+}
@@ -0,0 +1,12 @@
+#pragma once
+#include <dxgiformat.h>
+
+// png writer with its own deflate, so textures can be written straight from a decoded buffer without going through wic.
+// big images are split into chunks of rows that are filtered and compressed on the shared task scheduler, each chunk becomes its own IDAT.
+
+// can pixels in this format be written without converting them first?
+// 8 bit rgba and bgra, bgrx is written as rgb.
+const bool CanWritePng(const DXGI_FORMAT format);
+
+// compression is an ePngExportCompression, the image is tagged as srgb regardless of format (same as the wic path did).
+const bool WritePng(const std::filesystem::path& exportPath, const uint8_t* const pixels, const size_t rowPitch, const size_t width, const size_t height, const DXGI_FORMAT format, const uint32_t compression);
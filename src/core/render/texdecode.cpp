@@ -0,0 +1,1228 @@
+#include <pch.h>
+#include <core/render/texdecode.h>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#define TEXDECODE_SSE2
+#include <emmintrin.h>
+#endif
+
+// pixels are always decoded as rgba, then swapped to bgra when they're written out if needed
+typedef void(*DecodeBlockFn_t)(const uint8_t* const block, uint8_t* const pixels); // pixels is a 4x4 block of rgba8
+typedef void(*DecodeRowFn_t)(const uint8_t* const src, uint8_t* const pixels, const size_t width);
+
+// images are split into jobs of at least this many pixels, anything smaller is decoded on the calling thread
+static constexpr size_t s_decodeJobPixels = 256ull * 256ull;
+
+//
+// HELPERS
+//
+static inline uint8_t UnormToByte(const float value)
+{
+    // written so nan ends up as zero
+    const float clamped = !(value > 0.0f) ? 0.0f : (value > 1.0f ? 1.0f : value);
+    return static_cast<uint8_t>(std::nearbyint(clamped * 255.0f));
+}
+
+// clamps and rounds four floats to rgba8
+static inline void StoreUnorm4(const float* const rgba, uint8_t* const out)
+{
+#if defined(TEXDECODE_SSE2)
+    // max with the value first so nan ends up as zero
+    __m128 v = _mm_max_ps(_mm_loadu_ps(rgba), _mm_setzero_ps());
+    v = _mm_min_ps(v, _mm_set1_ps(1.0f));
+    v = _mm_mul_ps(v, _mm_set1_ps(255.0f));
+
+    const __m128i i32 = _mm_cvtps_epi32(v); // round to nearest
+    const __m128i i16 = _mm_packs_epi32(i32, i32);
+    const __m128i u8 = _mm_packus_epi16(i16, i16);
+
+    const int packed = _mm_cvtsi128_si32(u8);
+    memcpy(out, &packed, sizeof(int));
+#else
+    out[0] = UnormToByte(rgba[0]);
+    out[1] = UnormToByte(rgba[1]);
+    out[2] = UnormToByte(rgba[2]);
+    out[3] = UnormToByte(rgba[3]);
+#endif
+}
+
+static inline float HalfToFloat(const uint16_t half)
+{
+    const uint32_t sign = static_cast<uint32_t>(half & 0x8000u) << 16;
+    const uint32_t exponent = (half >> 10) & 0x1Fu;
+    const uint32_t mantissa = half & 0x3FFu;
+
+    uint32_t bits = 0u;
+    if (exponent == 0u)
+    {
+        if (mantissa == 0u)
+        {
+            bits = sign;
+        }
+        else
+        {
+            // denormal, normalize it
+            uint32_t shift = 0u;
+            uint32_t m = mantissa;
+            while (!(m & 0x400u))
+            {
+                m <<= 1;
+                shift++;
+            }
+
+            bits = sign | ((127u - 15u + 1u - shift) << 23) | ((m & 0x3FFu) << 13);
+        }
+    }
+    else if (exponent == 31u)
+    {
+        bits = sign | 0x7F800000u | (mantissa << 13);
+    }
+    else
+    {
+        bits = sign | ((exponent + (127u - 15u)) << 23) | (mantissa << 13);
+    }
+
+    float out = 0.0f;
+    memcpy(&out, &bits, sizeof(float));
+
+    return out;
+}
+
+static inline void SwapRedBlue(uint8_t* const pixels, const size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        uint32_t pixel = 0u;
+        memcpy(&pixel, pixels + (i * 4), sizeof(uint32_t));
+
+        pixel = (pixel & 0xFF00FF00u) | ((pixel & 0xFFu) << 16) | ((pixel >> 16) & 0xFFu);
+        memcpy(pixels + (i * 4), &pixel, sizeof(uint32_t));
+    }
+}
+
+static inline const uint16_t ReadU16(const uint8_t* const data)
+{
+    return static_cast<uint16_t>(data[0] | (data[1] << 8));
+}
+
+// reads bits from a 128 bit block, lowest bit first
+class CBlockBitReader
+{
+public:
+    CBlockBitReader(const uint8_t* const block) : pos(0u)
+    {
+        memcpy(&low, block, sizeof(uint64_t));
+        memcpy(&high, block + sizeof(uint64_t), sizeof(uint64_t));
+    }
+
+    inline const uint32_t Read(const uint32_t count)
+    {
+        if (count == 0u)
+            return 0u;
+
+        uint64_t value = 0ull;
+        if (pos >= 64u)
+            value = high >> (pos - 64u);
+        else if (pos == 0u)
+            value = low;
+        else
+            value = (low >> pos) | (high << (64u - pos));
+
+        pos += count;
+
+        return static_cast<uint32_t>(value & ((1ull << count) - 1ull));
+    }
+
+private:
+    uint64_t low;
+    uint64_t high;
+    uint32_t pos;
+};
+
+//
+// BC1-BC5
+//
+static inline void Unpack565(const uint16_t color, float* const rgba)
+{
+    rgba[0] = static_cast<float>((color >> 11) & 31) * (1.0f / 31.0f);
+    rgba[1] = static_cast<float>((color >> 5) & 63) * (1.0f / 63.0f);
+    rgba[2] = static_cast<float>(color & 31) * (1.0f / 31.0f);
+    rgba[3] = 1.0f;
+}
+
+static inline void Lerp4(const float* const a, const float* const b, const float t, float* const out)
+{
+    for (int i = 0; i < 4; i++)
+        out[i] = a[i] + (t * (b[i] - a[i]));
+}
+
+// bc1 color block, bc2 and bc3 always use four colors
+static void DecodeColorBlock(const uint8_t* const block, uint8_t* const pixels, const bool allowTransparent)
+{
+    const uint16_t color0 = ReadU16(block);
+    const uint16_t color1 = ReadU16(block + 2);
+
+    float palette[4][4] = {};
+    Unpack565(color0, palette[0]);
+    Unpack565(color1, palette[1]);
+
+    if (!allowTransparent || color0 > color1)
+    {
+        Lerp4(palette[0], palette[1], 1.0f / 3.0f, palette[2]);
+        Lerp4(palette[0], palette[1], 2.0f / 3.0f, palette[3]);
+    }
+    else
+    {
+        // three colors and transparent black
+        Lerp4(palette[0], palette[1], 0.5f, palette[2]);
+    }
+
+    uint8_t colors[4][4] = {};
+    for (int i = 0; i < 4; i++)
+        StoreUnorm4(palette[i], colors[i]);
+
+    uint32_t indices = 0u;
+    memcpy(&indices, block + 4, sizeof(uint32_t));
+
+    for (int i = 0; i < 16; i++)
+        memcpy(pixels + (i * 4), colors[(indices >> (i * 2)) & 3u], 4);
+}
+
+// bc3 alpha and bc4/bc5 channels, values are in the range of the format (-1 to 1 for snorm)
+static void DecodeChannelBlock(const uint8_t* const block, float* const values, const bool isSigned)
+{
+    float steps[8] = {};
+
+    bool sixSteps = false;
+    if (isSigned)
+    {
+        const int8_t red0 = static_cast<int8_t>(block[0]);
+        const int8_t red1 = static_cast<int8_t>(block[1]);
+
+        steps[0] = red0 == -128 ? -1.0f : static_cast<float>(red0) / 127.0f;
+        steps[1] = red1 == -128 ? -1.0f : static_cast<float>(red1) / 127.0f;
+
+        sixSteps = red0 > red1;
+    }
+    else
+    {
+        steps[0] = static_cast<float>(block[0]) / 255.0f;
+        steps[1] = static_cast<float>(block[1]) / 255.0f;
+
+        sixSteps = block[0] > block[1];
+    }
+
+    if (sixSteps)
+    {
+        for (int i = 1; i < 7; i++)
+            steps[i + 1] = ((steps[0] * static_cast<float>(7 - i)) + (steps[1] * static_cast<float>(i))) / 7.0f;
+    }
+    else
+    {
+        for (int i = 1; i < 5; i++)
+            steps[i + 1] = ((steps[0] * static_cast<float>(5 - i)) + (steps[1] * static_cast<float>(i))) / 5.0f;
+
+        steps[6] = isSigned ? -1.0f : 0.0f;
+        steps[7] = 1.0f;
+    }
+
+    uint64_t indices = 0ull;
+    for (int i = 0; i < 6; i++)
+        indices |= static_cast<uint64_t>(block[2 + i]) << (i * 8);
+
+    for (int i = 0; i < 16; i++)
+        values[i] = steps[(indices >> (i * 3)) & 7ull];
+}
+
+// written to an unorm target, snorm values are remapped from -1 to 1 into 0 to 1
+static inline uint8_t ChannelToByte(const float value, const bool isSigned)
+{
+    return UnormToByte(isSigned ? (value * 0.5f) + 0.5f : value);
+}
+
+static void DecodeBlockBC1(const uint8_t* const block, uint8_t* const pixels)
+{
+    DecodeColorBlock(block, pixels, true);
+}
+
+static void DecodeBlockBC2(const uint8_t* const block, uint8_t* const pixels)
+{
+    DecodeColorBlock(block + 8, pixels, false);
+
+    for (int i = 0; i < 16; i++)
+    {
+        const uint8_t alpha = (block[i >> 1] >> ((i & 1) * 4)) & 0xF;
+        pixels[(i * 4) + 3] = UnormToByte(static_cast<float>(alpha) / 15.0f);
+    }
+}
+
+static void DecodeBlockBC3(const uint8_t* const block, uint8_t* const pixels)
+{
+    DecodeColorBlock(block + 8, pixels, false);
+
+    float alpha[16] = {};
+    DecodeChannelBlock(block, alpha, false);
+
+    for (int i = 0; i < 16; i++)
+        pixels[(i * 4) + 3] = UnormToByte(alpha[i]);
+}
+
+template <bool isSigned>
+static void DecodeBlockBC4(const uint8_t* const block, uint8_t* const pixels)
+{
+    float red[16] = {};
+    DecodeChannelBlock(block, red, isSigned);
+
+    const uint8_t zero = ChannelToByte(0.0f, isSigned);
+    for (int i = 0; i < 16; i++)
+    {
+        pixels[(i * 4) + 0] = ChannelToByte(red[i], isSigned);
+        pixels[(i * 4) + 1] = zero;
+        pixels[(i * 4) + 2] = zero;
+        pixels[(i * 4) + 3] = 0xFF;
+    }
+}
+
+template <bool isSigned>
+static void DecodeBlockBC5(const uint8_t* const block, uint8_t* const pixels)
+{
+    float red[16] = {};
+    float green[16] = {};
+    DecodeChannelBlock(block, red, isSigned);
+    DecodeChannelBlock(block + 8, green, isSigned);
+
+    const uint8_t zero = ChannelToByte(0.0f, isSigned);
+    for (int i = 0; i < 16; i++)
+    {
+        pixels[(i * 4) + 0] = ChannelToByte(red[i], isSigned);
+        pixels[(i * 4) + 1] = ChannelToByte(green[i], isSigned);
+        pixels[(i * 4) + 2] = zero;
+        pixels[(i * 4) + 3] = 0xFF;
+    }
+}
+
+//
+// BC6H/BC7
+//
+// bit masks of which pixels are in the second subset, pixel 0 is the lowest bit
+static const uint16_t s_BPTCPartitions2[64] =
+{
+    0xCCCC, 0x8888, 0xEEEE, 0xECC8, 0xC880, 0xFEEC, 0xFEC8, 0xEC80,
+    0xC800, 0xFFEC, 0xFE80, 0xE800, 0xFFE8, 0xFF00, 0xFFF0, 0xF000,
+    0xF710, 0x008E, 0x7100, 0x08CE, 0x008C, 0x7310, 0x3100, 0x8CCE,
+    0x088C, 0x3110, 0x6666, 0x366C, 0x17E8, 0x0FF0, 0x718E, 0x399C,
+    0xAAAA, 0xF0F0, 0x5A5A, 0x33CC, 0x3C3C, 0x55AA, 0x9696, 0xA55A,
+    0x73CE, 0x13C8, 0x324C, 0x3BDC, 0x6996, 0xC33C, 0x9966, 0x0660,
+    0x0272, 0x04E4, 0x4E40, 0x2720, 0xC936, 0x936C, 0x39C6, 0x639C,
+    0x9336, 0x9CC6, 0x817E, 0xE718, 0xCCF0, 0x0FCC, 0x7744, 0xEE22,
+};
+
+// two bits per pixel, pixel 0 in the lowest bits
+static const uint32_t s_BPTCPartitions3[64] =
+{
+    0xAA685050, 0x6A5A5040, 0x5A5A4200, 0x5450A0A8, 0xA5A50000, 0xA0A05050, 0x5555A0A0, 0x5A5A5050,
+    0xAA550000, 0xAA555500, 0xAAAA5500, 0x90909090, 0x94949494, 0xA4A4A4A4, 0xA9A59450, 0x2A0A4250,
+    0xA5945040, 0x0A425054, 0xA5A5A500, 0x55A0A0A0, 0xA8A85454, 0x6A6A4040, 0xA4A45000, 0x1A1A0500,
+    0x0050A4A4, 0xAAA59090, 0x14696914, 0x69691400, 0xA08585A0, 0xAA821414, 0x50A4A450, 0x6A5A0200,
+    0xA9A58000, 0x5090A0A8, 0xA8A09050, 0x24242424, 0x00AA5500, 0x24924924, 0x24499224, 0x50A50A50,
+    0x500AA550, 0xAAAA4444, 0x66660000, 0xA5A0A5A0, 0x50A050A0, 0x69286928, 0x44AAAA44, 0x66666600,
+    0xAA444444, 0x54A854A8, 0x95809580, 0x96969600, 0xA85454A8, 0x80959580, 0xAA141414, 0x96960000,
+    0xAAAA1414, 0xA05050A0, 0xA0A5A5A0, 0x96000000, 0x40804080, 0xA9A8A9A8, 0xAAAAAA44, 0x2A4A5254,
+};
+
+// index of the anchor pixel for the second subset of two subset partitions
+static const uint8_t s_BPTCAnchor2[64] =
+{
+    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+    15, 2, 8, 2, 2, 8, 8, 15, 2, 8, 2, 2, 8, 8, 2, 2,
+    15, 15, 6, 8, 2, 8, 15, 15, 2, 8, 2, 2, 2, 15, 15, 6,
+    6, 2, 6, 8, 15, 15, 2, 2, 15, 15, 15, 15, 15, 2, 2, 15,
+};
+
+// anchor pixels for the second and third subsets of three subset partitions
+static const uint8_t s_BPTCAnchor3_1[64] =
+{
+    3, 3, 15, 15, 8, 3, 15, 15, 8, 8, 6, 6, 6, 5, 3, 3,
+    3, 3, 8, 15, 3, 3, 6, 10, 5, 8, 8, 6, 8, 5, 15, 15,
+    8, 15, 3, 5, 6, 10, 8, 15, 15, 3, 15, 5, 15, 15, 15, 15,
+    3, 15, 5, 5, 5, 8, 5, 10, 5, 10, 8, 13, 15, 12, 3, 3,
+};
+
+static const uint8_t s_BPTCAnchor3_2[64] =
+{
+    15, 8, 8, 3, 15, 15, 3, 8, 15, 15, 15, 15, 15, 15, 15, 8,
+    15, 8, 15, 3, 15, 8, 15, 8, 3, 15, 6, 10, 15, 15, 10, 8,
+    15, 3, 15, 10, 10, 8, 9, 10, 6, 15, 8, 15, 3, 6, 6, 8,
+    15, 3, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 3, 15, 15, 8,
+};
+
+static const uint8_t s_BPTCWeights2[4] = { 0, 21, 43, 64 };
+static const uint8_t s_BPTCWeights3[8] = { 0, 9, 18, 27, 37, 46, 55, 64 };
+static const uint8_t s_BPTCWeights4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+static inline const uint8_t* const GetBPTCWeights(const uint32_t indexBits)
+{
+    switch (indexBits)
+    {
+    case 2:
+        return s_BPTCWeights2;
+    case 3:
+        return s_BPTCWeights3;
+    default:
+        return s_BPTCWeights4;
+    }
+}
+
+static inline int32_t BPTCInterpolate(const int32_t a, const int32_t b, const uint8_t weight)
+{
+    return ((a * (64 - weight)) + (b * weight) + 32) >> 6;
+}
+
+static inline uint32_t BPTCSubset(const uint32_t subsets, const uint32_t partition, const int pixel)
+{
+    switch (subsets)
+    {
+    case 2:
+        return (s_BPTCPartitions2[partition] >> pixel) & 1u;
+    case 3:
+        return (s_BPTCPartitions3[partition] >> (pixel * 2)) & 3u;
+    default:
+        return 0u;
+    }
+}
+
+static inline bool BPTCIsAnchor(const uint32_t subsets, const uint32_t partition, const int pixel)
+{
+    if (pixel == 0)
+        return true;
+
+    switch (subsets)
+    {
+    case 2:
+        return pixel == s_BPTCAnchor2[partition];
+    case 3:
+        return pixel == s_BPTCAnchor3_1[partition] || pixel == s_BPTCAnchor3_2[partition];
+    default:
+        return false;
+    }
+}
+
+struct BC7ModeInfo_t
+{
+    uint8_t subsets;
+    uint8_t partitionBits;
+    uint8_t rotationBits;
+    uint8_t indexSelectionBits;
+    uint8_t colorBits;
+    uint8_t alphaBits;
+    uint8_t endpointPBits; // one p bit per endpoint
+    uint8_t sharedPBits; // one p bit per subset
+    uint8_t indexBits;
+    uint8_t indexBits2;
+};
+
+static const BC7ModeInfo_t s_BC7Modes[8] =
+{
+    { 3, 4, 0, 0, 4, 0, 1, 0, 3, 0 },
+    { 2, 6, 0, 0, 6, 0, 0, 1, 3, 0 },
+    { 3, 6, 0, 0, 5, 0, 0, 0, 2, 0 },
+    { 2, 6, 0, 0, 7, 0, 1, 0, 2, 0 },
+    { 1, 0, 2, 1, 5, 6, 0, 0, 2, 3 },
+    { 1, 0, 2, 0, 7, 8, 0, 0, 2, 2 },
+    { 1, 0, 0, 0, 7, 7, 1, 0, 4, 0 },
+    { 2, 6, 0, 0, 5, 5, 1, 0, 2, 0 },
+};
+
+static inline uint8_t BC7ExpandEndpoint(uint32_t value, const uint32_t bits)
+{
+    value <<= (8u - bits);
+    value |= value >> bits;
+
+    return static_cast<uint8_t>(value);
+}
+
+static void DecodeBlockBC7(const uint8_t* const block, uint8_t* const pixels)
+{
+    CBlockBitReader reader(block);
+
+    uint32_t mode = 0u;
+    while (mode < 8u && !reader.Read(1u))
+        mode++;
+
+    // reserved mode, decodes to transparent black
+    if (mode == 8u)
+    {
+        memset(pixels, 0, 16 * 4);
+        return;
+    }
+
+    const BC7ModeInfo_t& info = s_BC7Modes[mode];
+
+    const uint32_t partition = reader.Read(info.partitionBits);
+    const uint32_t rotation = reader.Read(info.rotationBits);
+    const uint32_t indexSelection = reader.Read(info.indexSelectionBits);
+
+    const uint32_t numEndpoints = info.subsets * 2u;
+
+    uint32_t endpoints[6][4] = {};
+    for (uint32_t channel = 0u; channel < 3u; channel++)
+    {
+        for (uint32_t i = 0u; i < numEndpoints; i++)
+            endpoints[i][channel] = reader.Read(info.colorBits);
+    }
+
+    for (uint32_t i = 0u; i < numEndpoints; i++)
+        endpoints[i][3] = reader.Read(info.alphaBits);
+
+    uint32_t pBits[6] = {};
+    if (info.endpointPBits)
+    {
+        for (uint32_t i = 0u; i < numEndpoints; i++)
+            pBits[i] = reader.Read(1u);
+    }
+    else if (info.sharedPBits)
+    {
+        for (uint32_t i = 0u; i < info.subsets; i++)
+            pBits[i * 2u] = pBits[(i * 2u) + 1u] = reader.Read(1u);
+    }
+
+    const bool hasPBits = info.endpointPBits || info.sharedPBits;
+
+    uint8_t colors[6][4] = {};
+    for (uint32_t i = 0u; i < numEndpoints; i++)
+    {
+        for (uint32_t channel = 0u; channel < 4u; channel++)
+        {
+            const uint32_t bits = channel < 3u ? info.colorBits : info.alphaBits;
+            if (bits == 0u)
+            {
+                colors[i][channel] = 0xFF;
+                continue;
+            }
+
+            if (hasPBits)
+                colors[i][channel] = BC7ExpandEndpoint((endpoints[i][channel] << 1) | pBits[i], bits + 1u);
+            else
+                colors[i][channel] = BC7ExpandEndpoint(endpoints[i][channel], bits);
+        }
+    }
+
+    uint8_t indices[16] = {};
+    for (int i = 0; i < 16; i++)
+        indices[i] = static_cast<uint8_t>(reader.Read(info.indexBits - (BPTCIsAnchor(info.subsets, partition, i) ? 1u : 0u)));
+
+    uint8_t indices2[16] = {};
+    if (info.indexBits2)
+    {
+        for (int i = 0; i < 16; i++)
+            indices2[i] = static_cast<uint8_t>(reader.Read(info.indexBits2 - (i == 0 ? 1u : 0u)));
+    }
+
+    // with two sets of indices the first is for color and the second for alpha, unless the index selection bit swaps them
+    const bool swapIndices = indexSelection != 0u;
+    const uint8_t* const colorWeights = GetBPTCWeights(info.indexBits2 && swapIndices ? info.indexBits2 : info.indexBits);
+    const uint8_t* const alphaWeights = GetBPTCWeights(info.indexBits2 && !swapIndices ? info.indexBits2 : info.indexBits);
+
+    for (int i = 0; i < 16; i++)
+    {
+        const uint32_t subset = BPTCSubset(info.subsets, partition, i);
+        const uint8_t* const color0 = colors[subset * 2u];
+        const uint8_t* const color1 = colors[(subset * 2u) + 1u];
+
+        uint8_t colorIndex = indices[i];
+        uint8_t alphaIndex = indices[i];
+        if (info.indexBits2)
+        {
+            colorIndex = swapIndices ? indices2[i] : indices[i];
+            alphaIndex = swapIndices ? indices[i] : indices2[i];
+        }
+
+        uint8_t* const pixel = pixels + (i * 4);
+        for (int channel = 0; channel < 3; channel++)
+            pixel[channel] = static_cast<uint8_t>(BPTCInterpolate(color0[channel], color1[channel], colorWeights[colorIndex]));
+
+        pixel[3] = static_cast<uint8_t>(BPTCInterpolate(color0[3], color1[3], alphaWeights[alphaIndex]));
+
+        switch (rotation)
+        {
+        case 1:
+            std::swap(pixel[0], pixel[3]);
+            break;
+        case 2:
+            std::swap(pixel[1], pixel[3]);
+            break;
+        case 3:
+            std::swap(pixel[2], pixel[3]);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+enum eBC6HField : uint8_t
+{
+    BC6H_RW,
+    BC6H_RX,
+    BC6H_RY,
+    BC6H_RZ,
+    BC6H_GW,
+    BC6H_GX,
+    BC6H_GY,
+    BC6H_GZ,
+    BC6H_BW,
+    BC6H_BX,
+    BC6H_BY,
+    BC6H_BZ,
+    BC6H_D, // partition
+
+    BC6H_FIELD_COUNT,
+};
+
+// bits of a field in the order they are stored, from first to last (inclusive)
+struct BC6HBitRun_t
+{
+    uint8_t field;
+    uint8_t first;
+    uint8_t last;
+};
+
+struct BC6HModeInfo_t
+{
+    uint8_t regions;
+    bool transformed; // x/y/z are deltas from w
+    uint8_t endpointBits;
+    uint8_t deltaBits[3];
+    uint8_t numRuns;
+    BC6HBitRun_t runs[24];
+};
+
+// bit layouts from the d3d11 spec, mode bits are not included
+static const BC6HModeInfo_t s_BC6HModes[14] =
+{
+    // mode 0x00
+    { 2, true, 10, { 5, 5, 5 }, 20,
+        { { BC6H_GY, 4, 4 }, { BC6H_BY, 4, 4 }, { BC6H_BZ, 4, 4 }, { BC6H_RW, 0, 9 }, { BC6H_GW, 0, 9 }, { BC6H_BW, 0, 9 }, { BC6H_RX, 0, 4 }, { BC6H_GZ, 4, 4 }, { BC6H_GY, 0, 3 }, { BC6H_GX, 0, 4 }, { BC6H_BZ, 0, 0 }, { BC6H_GZ, 0, 3 }, { BC6H_BX, 0, 4 }, { BC6H_BZ, 1, 1 }, { BC6H_BY, 0, 3 }, { BC6H_RY, 0, 4 }, { BC6H_BZ, 2, 2 }, { BC6H_RZ, 0, 4 }, { BC6H_BZ, 3, 3 }, { BC6H_D, 0, 4 } } },
+    // mode 0x01
+    { 2, true, 7, { 6, 6, 6 }, 24,
+        { { BC6H_GY, 5, 5 }, { BC6H_GZ, 4, 4 }, { BC6H_GZ, 5, 5 }, { BC6H_RW, 0, 6 }, { BC6H_BZ, 0, 0 }, { BC6H_BZ, 1, 1 }, { BC6H_BY, 4, 4 }, { BC6H_GW, 0, 6 }, { BC6H_BY, 5, 5 }, { BC6H_BZ, 2, 2 }, { BC6H_GY, 4, 4 }, { BC6H_BW, 0, 6 }, { BC6H_BZ, 3, 3 }, { BC6H_BZ, 5, 5 }, { BC6H_BZ, 4, 4 }, { BC6H_RX, 0, 5 }, { BC6H_GY, 0, 3 }, { BC6H_GX, 0, 5 }, { BC6H_GZ, 0, 3 }, { BC6H_BX, 0, 5 }, { BC6H_BY, 0, 3 }, { BC6H_RY, 0, 5 }, { BC6H_RZ, 0, 5 }, { BC6H_D, 0, 4 } } },
+    // mode 0x02
+    { 2, true, 11, { 5, 4, 4 }, 19,
+        { { BC6H_RW, 0, 9 }, { BC6H_GW, 0, 9 }, { BC6H_BW, 0, 9 }, { BC6H_RX, 0, 4 }, { BC6H_RW, 10, 10 }, { BC6H_GY, 0, 3 }, { BC6H_GX, 0, 3 }, { BC6H_GW, 10, 10 }, { BC6H_BZ, 0, 0 }, { BC6H_GZ, 0, 3 }, { BC6H_BX, 0, 3 }, { BC6H_BW, 10, 10 }, { BC6H_BZ, 1, 1 }, { BC6H_BY, 0, 3 }, { BC6H_RY, 0, 4 }, { BC6H_BZ, 2, 2 }, { BC6H_RZ, 0, 4 }, { BC6H_BZ, 3, 3 }, { BC6H_D, 0, 4 } } },
+    // mode 0x06
+    { 2, true, 11, { 4, 5, 4 }, 21,
+        { { BC6H_RW, 0, 9 }, { BC6H_GW, 0, 9 }, { BC6H_BW, 0, 9 }, { BC6H_RX, 0, 3 }, { BC6H_RW, 10, 10 }, { BC6H_GZ, 4, 4 }, { BC6H_GY, 0, 3 }, { BC6H_GX, 0, 4 }, { BC6H_GW, 10, 10 }, { BC6H_GZ, 0, 3 }, { BC6H_BX, 0, 3 }, { BC6H_BW, 10, 10 }, { BC6H_BZ, 1, 1 }, { BC6H_BY, 0, 3 }, { BC6H_RY, 0, 3 }, { BC6H_BZ, 0, 0 }, { BC6H_BZ, 2, 2 }, { BC6H_RZ, 0, 3 }, { BC6H_GY, 4, 4 }, { BC6H_BZ, 3, 3 }, { BC6H_D, 0, 4 } } },
+    // mode 0x0A
+    { 2, true, 11, { 4, 4, 5 }, 21,
+        { { BC6H_RW, 0, 9 }, { BC6H_GW, 0, 9 }, { BC6H_BW, 0, 9 }, { BC6H_RX, 0, 3 }, { BC6H_RW, 10, 10 }, { BC6H_BY, 4, 4 }, { BC6H_GY, 0, 3 }, { BC6H_GX, 0, 3 }, { BC6H_GW, 10, 10 }, { BC6H_BZ, 0, 0 }, { BC6H_GZ, 0, 3 }, { BC6H_BX, 0, 4 }, { BC6H_BW, 10, 10 }, { BC6H_BY, 0, 3 }, { BC6H_RY, 0, 3 }, { BC6H_BZ, 1, 1 }, { BC6H_BZ, 2, 2 }, { BC6H_RZ, 0, 3 }, { BC6H_BZ, 4, 4 }, { BC6H_BZ, 3, 3 }, { BC6H_D, 0, 4 } } },
+    // mode 0x0E
+    { 2, true, 9, { 5, 5, 5 }, 20,
+        { { BC6H_RW, 0, 8 }, { BC6H_BY, 4, 4 }, { BC6H_GW, 0, 8 }, { BC6H_GY, 4, 4 }, { BC6H_BW, 0, 8 }, { BC6H_BZ, 4, 4 }, { BC6H_RX, 0, 4 }, { BC6H_GZ, 4, 4 }, { BC6H_GY, 0, 3 }, { BC6H_GX, 0, 4 }, { BC6H_BZ, 0, 0 }, { BC6H_GZ, 0, 3 }, { BC6H_BX, 0, 4 }, { BC6H_BZ, 1, 1 }, { BC6H_BY, 0, 3 }, { BC6H_RY, 0, 4 }, { BC6H_BZ, 2, 2 }, { BC6H_RZ, 0, 4 }, { BC6H_BZ, 3, 3 }, { BC6H_D, 0, 4 } } },
+    // mode 0x12
+    { 2, true, 8, { 6, 5, 5 }, 20,
+        { { BC6H_RW, 0, 7 }, { BC6H_GZ, 4, 4 }, { BC6H_BY, 4, 4 }, { BC6H_GW, 0, 7 }, { BC6H_BZ, 2, 2 }, { BC6H_GY, 4, 4 }, { BC6H_BW, 0, 7 }, { BC6H_BZ, 3, 3 }, { BC6H_BZ, 4, 4 }, { BC6H_RX, 0, 5 }, { BC6H_GY, 0, 3 }, { BC6H_GX, 0, 4 }, { BC6H_BZ, 0, 0 }, { BC6H_GZ, 0, 3 }, { BC6H_BX, 0, 4 }, { BC6H_BZ, 1, 1 }, { BC6H_BY, 0, 3 }, { BC6H_RY, 0, 5 }, { BC6H_RZ, 0, 5 }, { BC6H_D, 0, 4 } } },
+    // mode 0x16
+    { 2, true, 8, { 5, 6, 5 }, 22,
+        { { BC6H_RW, 0, 7 }, { BC6H_BZ, 0, 0 }, { BC6H_BY, 4, 4 }, { BC6H_GW, 0, 7 }, { BC6H_GY, 5, 5 }, { BC6H_GY, 4, 4 }, { BC6H_BW, 0, 7 }, { BC6H_GZ, 5, 5 }, { BC6H_BZ, 4, 4 }, { BC6H_RX, 0, 4 }, { BC6H_GZ, 4, 4 }, { BC6H_GY, 0, 3 }, { BC6H_GX, 0, 5 }, { BC6H_GZ, 0, 3 }, { BC6H_BX, 0, 4 }, { BC6H_BZ, 1, 1 }, { BC6H_BY, 0, 3 }, { BC6H_RY, 0, 4 }, { BC6H_BZ, 2, 2 }, { BC6H_RZ, 0, 4 }, { BC6H_BZ, 3, 3 }, { BC6H_D, 0, 4 } } },
+    // mode 0x1A
+    { 2, true, 8, { 5, 5, 6 }, 22,
+        { { BC6H_RW, 0, 7 }, { BC6H_BZ, 1, 1 }, { BC6H_BY, 4, 4 }, { BC6H_GW, 0, 7 }, { BC6H_BY, 5, 5 }, { BC6H_GY, 4, 4 }, { BC6H_BW, 0, 7 }, { BC6H_BZ, 5, 5 }, { BC6H_BZ, 4, 4 }, { BC6H_RX, 0, 4 }, { BC6H_GZ, 4, 4 }, { BC6H_GY, 0, 3 }, { BC6H_GX, 0, 4 }, { BC6H_BZ, 0, 0 }, { BC6H_GZ, 0, 3 }, { BC6H_BX, 0, 5 }, { BC6H_BY, 0, 3 }, { BC6H_RY, 0, 4 }, { BC6H_BZ, 2, 2 }, { BC6H_RZ, 0, 4 }, { BC6H_BZ, 3, 3 }, { BC6H_D, 0, 4 } } },
+    // mode 0x1E
+    { 2, false, 6, { 6, 6, 6 }, 24,
+        { { BC6H_RW, 0, 5 }, { BC6H_GZ, 4, 4 }, { BC6H_BZ, 0, 0 }, { BC6H_BZ, 1, 1 }, { BC6H_BY, 4, 4 }, { BC6H_GW, 0, 5 }, { BC6H_GY, 5, 5 }, { BC6H_BY, 5, 5 }, { BC6H_BZ, 2, 2 }, { BC6H_GY, 4, 4 }, { BC6H_BW, 0, 5 }, { BC6H_GZ, 5, 5 }, { BC6H_BZ, 3, 3 }, { BC6H_BZ, 5, 5 }, { BC6H_BZ, 4, 4 }, { BC6H_RX, 0, 5 }, { BC6H_GY, 0, 3 }, { BC6H_GX, 0, 5 }, { BC6H_GZ, 0, 3 }, { BC6H_BX, 0, 5 }, { BC6H_BY, 0, 3 }, { BC6H_RY, 0, 5 }, { BC6H_RZ, 0, 5 }, { BC6H_D, 0, 4 } } },
+    // mode 0x03
+    { 1, false, 10, { 10, 10, 10 }, 6,
+        { { BC6H_RW, 0, 9 }, { BC6H_GW, 0, 9 }, { BC6H_BW, 0, 9 }, { BC6H_RX, 0, 9 }, { BC6H_GX, 0, 9 }, { BC6H_BX, 0, 9 } } },
+    // mode 0x07
+    { 1, true, 11, { 9, 9, 9 }, 9,
+        { { BC6H_RW, 0, 9 }, { BC6H_GW, 0, 9 }, { BC6H_BW, 0, 9 }, { BC6H_RX, 0, 8 }, { BC6H_RW, 10, 10 }, { BC6H_GX, 0, 8 }, { BC6H_GW, 10, 10 }, { BC6H_BX, 0, 8 }, { BC6H_BW, 10, 10 } } },
+    // mode 0x0B
+    { 1, true, 12, { 8, 8, 8 }, 9,
+        { { BC6H_RW, 0, 9 }, { BC6H_GW, 0, 9 }, { BC6H_BW, 0, 9 }, { BC6H_RX, 0, 7 }, { BC6H_RW, 11, 10 }, { BC6H_GX, 0, 7 }, { BC6H_GW, 11, 10 }, { BC6H_BX, 0, 7 }, { BC6H_BW, 11, 10 } } },
+    // mode 0x0F
+    { 1, true, 16, { 4, 4, 4 }, 9,
+        { { BC6H_RW, 0, 9 }, { BC6H_GW, 0, 9 }, { BC6H_BW, 0, 9 }, { BC6H_RX, 0, 3 }, { BC6H_RW, 15, 10 }, { BC6H_GX, 0, 3 }, { BC6H_GW, 15, 10 }, { BC6H_BX, 0, 3 }, { BC6H_BW, 15, 10 } } },
+};
+
+// mode bits to index into s_BC6HModes, -1 for reserved modes
+static const int8_t s_BC6HModeIndex[32] =
+{
+    0, 1, 2, 10, -1, -1, 3, 11, -1, -1, 4, 12, -1, -1, 5, 13,
+    -1, -1, 6, -1, -1, -1, 7, -1, -1, -1, 8, -1, -1, -1, 9, -1,
+};
+
+static inline int32_t SignExtend(const int32_t value, const uint32_t bits)
+{
+    const int32_t shift = 32 - static_cast<int32_t>(bits);
+    return static_cast<int32_t>(static_cast<uint32_t>(value) << shift) >> shift;
+}
+
+static inline int32_t BC6HUnquantize(const int32_t value, const uint32_t bits, const bool isSigned)
+{
+    if (!isSigned)
+    {
+        if (bits >= 15u)
+            return value;
+
+        if (value == 0)
+            return 0;
+
+        if (value == static_cast<int32_t>((1u << bits) - 1u))
+            return 0xFFFF;
+
+        return ((value << 16) + 0x8000) >> bits;
+    }
+
+    if (bits >= 16u)
+        return value;
+
+    const bool negative = value < 0;
+    const int32_t magnitude = negative ? -value : value;
+
+    int32_t unquantized = 0;
+    if (magnitude == 0)
+        unquantized = 0;
+    else if (magnitude >= static_cast<int32_t>((1u << (bits - 1u)) - 1u))
+        unquantized = 0x7FFF;
+    else
+        unquantized = ((magnitude << 15) + 0x4000) >> (bits - 1u);
+
+    return negative ? -unquantized : unquantized;
+}
+
+static inline uint16_t BC6HFinishUnquantize(const int32_t value, const bool isSigned)
+{
+    if (!isSigned)
+        return static_cast<uint16_t>((value * 31) >> 6);
+
+    const int32_t scaled = value < 0 ? -(((-value) * 31) >> 5) : (value * 31) >> 5;
+    return scaled < 0 ? static_cast<uint16_t>(0x8000 | -scaled) : static_cast<uint16_t>(scaled);
+}
+
+template <bool isSigned>
+static void DecodeBlockBC6H(const uint8_t* const block, uint8_t* const pixels)
+{
+    CBlockBitReader reader(block);
+
+    uint32_t modeBits = reader.Read(2u);
+    if (modeBits > 1u)
+        modeBits |= reader.Read(3u) << 2;
+
+    const int8_t modeIdx = s_BC6HModeIndex[modeBits];
+    if (modeIdx < 0)
+    {
+        for (int i = 0; i < 16; i++)
+        {
+            pixels[(i * 4) + 0] = 0;
+            pixels[(i * 4) + 1] = 0;
+            pixels[(i * 4) + 2] = 0;
+            pixels[(i * 4) + 3] = 0xFF;
+        }
+
+        return;
+    }
+
+    const BC6HModeInfo_t& info = s_BC6HModes[modeIdx];
+
+    int32_t fields[BC6H_FIELD_COUNT] = {};
+    for (uint32_t run = 0u; run < info.numRuns; run++)
+    {
+        const BC6HBitRun_t& bitRun = info.runs[run];
+        const int step = bitRun.last >= bitRun.first ? 1 : -1;
+
+        for (int bit = bitRun.first; ; bit += step)
+        {
+            fields[bitRun.field] |= static_cast<int32_t>(reader.Read(1u) << bit);
+
+            if (bit == bitRun.last)
+                break;
+        }
+    }
+
+    const uint32_t numEndpoints = info.regions * 2u;
+    const int32_t endpointMask = static_cast<int32_t>((1u << info.endpointBits) - 1u);
+
+    // [channel][w, x, y, z]
+    int32_t endpoints[3][4] = {};
+    for (uint32_t channel = 0u; channel < 3u; channel++)
+    {
+        int32_t* const endpoint = endpoints[channel];
+        for (uint32_t i = 0u; i < 4u; i++)
+            endpoint[i] = fields[(channel * 4u) + i];
+
+        if (isSigned)
+            endpoint[0] = SignExtend(endpoint[0], info.endpointBits);
+
+        for (uint32_t i = 1u; i < numEndpoints; i++)
+        {
+            if (info.transformed)
+            {
+                endpoint[i] = (endpoint[0] + SignExtend(endpoint[i], info.deltaBits[channel])) & endpointMask;
+
+                if (isSigned)
+                    endpoint[i] = SignExtend(endpoint[i], info.endpointBits);
+            }
+            else if (isSigned)
+            {
+                endpoint[i] = SignExtend(endpoint[i], info.endpointBits);
+            }
+        }
+
+        for (uint32_t i = 0u; i < numEndpoints; i++)
+            endpoint[i] = BC6HUnquantize(endpoint[i], info.endpointBits, isSigned);
+    }
+
+    const uint32_t partition = static_cast<uint32_t>(fields[BC6H_D]);
+    const uint32_t indexBits = info.regions == 2u ? 3u : 4u;
+    const uint8_t* const weights = GetBPTCWeights(indexBits);
+
+    for (int i = 0; i < 16; i++)
+    {
+        const uint32_t region = BPTCSubset(info.regions, partition, i);
+        const uint32_t index = reader.Read(indexBits - (BPTCIsAnchor(info.regions, partition, i) ? 1u : 0u));
+
+        float rgba[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+        for (uint32_t channel = 0u; channel < 3u; channel++)
+        {
+            const int32_t value = BPTCInterpolate(endpoints[channel][region * 2u], endpoints[channel][(region * 2u) + 1u], weights[index]);
+            rgba[channel] = HalfToFloat(BC6HFinishUnquantize(value, isSigned));
+        }
+
+        StoreUnorm4(rgba, pixels + (i * 4));
+    }
+}
+
+//
+// UNCOMPRESSED
+//
+static void DecodeRowR8G8B8A8(const uint8_t* const src, uint8_t* const pixels, const size_t width)
+{
+    memcpy(pixels, src, width * 4);
+}
+
+static void DecodeRowB8G8R8A8(const uint8_t* const src, uint8_t* const pixels, const size_t width)
+{
+    memcpy(pixels, src, width * 4);
+    SwapRedBlue(pixels, width);
+}
+
+static void DecodeRowB8G8R8X8(const uint8_t* const src, uint8_t* const pixels, const size_t width)
+{
+    DecodeRowB8G8R8A8(src, pixels, width);
+
+    for (size_t i = 0; i < width; i++)
+        pixels[(i * 4) + 3] = 0xFF;
+}
+
+static void DecodeRowR8G8(const uint8_t* const src, uint8_t* const pixels, const size_t width)
+{
+    for (size_t i = 0; i < width; i++)
+    {
+        pixels[(i * 4) + 0] = src[(i * 2) + 0];
+        pixels[(i * 4) + 1] = src[(i * 2) + 1];
+        pixels[(i * 4) + 2] = 0;
+        pixels[(i * 4) + 3] = 0xFF;
+    }
+}
+
+static void DecodeRowR8(const uint8_t* const src, uint8_t* const pixels, const size_t width)
+{
+    for (size_t i = 0; i < width; i++)
+    {
+        pixels[(i * 4) + 0] = src[i];
+        pixels[(i * 4) + 1] = 0;
+        pixels[(i * 4) + 2] = 0;
+        pixels[(i * 4) + 3] = 0xFF;
+    }
+}
+
+static void DecodeRowA8(const uint8_t* const src, uint8_t* const pixels, const size_t width)
+{
+    for (size_t i = 0; i < width; i++)
+    {
+        pixels[(i * 4) + 0] = 0;
+        pixels[(i * 4) + 1] = 0;
+        pixels[(i * 4) + 2] = 0;
+        pixels[(i * 4) + 3] = src[i];
+    }
+}
+
+static void DecodeRowR10G10B10A2(const uint8_t* const src, uint8_t* const pixels, const size_t width)
+{
+    for (size_t i = 0; i < width; i++)
+    {
+        uint32_t packed = 0u;
+        memcpy(&packed, src + (i * 4), sizeof(uint32_t));
+
+        const float rgba[4] =
+        {
+            static_cast<float>(packed & 0x3FFu) / 1023.0f,
+            static_cast<float>((packed >> 10) & 0x3FFu) / 1023.0f,
+            static_cast<float>((packed >> 20) & 0x3FFu) / 1023.0f,
+            static_cast<float>(packed >> 30) / 3.0f,
+        };
+
+        StoreUnorm4(rgba, pixels + (i * 4));
+    }
+}
+
+// channels missing from the source are zero, alpha is one
+template <uint32_t channels>
+static void DecodeRowUnorm16(const uint8_t* const src, uint8_t* const pixels, const size_t width)
+{
+    for (size_t i = 0; i < width; i++)
+    {
+        float rgba[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+        for (uint32_t channel = 0u; channel < channels; channel++)
+            rgba[channel] = static_cast<float>(ReadU16(src + (((i * channels) + channel) * 2))) / 65535.0f;
+
+        StoreUnorm4(rgba, pixels + (i * 4));
+    }
+}
+
+template <uint32_t channels>
+static void DecodeRowFloat16(const uint8_t* const src, uint8_t* const pixels, const size_t width)
+{
+    for (size_t i = 0; i < width; i++)
+    {
+        float rgba[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+        for (uint32_t channel = 0u; channel < channels; channel++)
+            rgba[channel] = HalfToFloat(ReadU16(src + (((i * channels) + channel) * 2)));
+
+        StoreUnorm4(rgba, pixels + (i * 4));
+    }
+}
+
+template <uint32_t channels>
+static void DecodeRowFloat32(const uint8_t* const src, uint8_t* const pixels, const size_t width)
+{
+    for (size_t i = 0; i < width; i++)
+    {
+        float rgba[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+        memcpy(rgba, src + (i * channels * sizeof(float)), channels * sizeof(float));
+
+        StoreUnorm4(rgba, pixels + (i * 4));
+    }
+}
+
+//
+// DECODING
+//
+struct TextureDecoder_t
+{
+    DXGI_FORMAT format;
+    uint8_t blockSize; // bytes per 4x4 block, or per pixel if the format isn't compressed
+    bool srgb;
+
+    DecodeBlockFn_t decodeBlock;
+    DecodeRowFn_t decodeRow;
+};
+
+static const TextureDecoder_t s_TextureDecoders[] =
+{
+    { DXGI_FORMAT_BC1_UNORM, 8, false, &DecodeBlockBC1, nullptr },
+    { DXGI_FORMAT_BC1_UNORM_SRGB, 8, true, &DecodeBlockBC1, nullptr },
+    { DXGI_FORMAT_BC2_UNORM, 16, false, &DecodeBlockBC2, nullptr },
+    { DXGI_FORMAT_BC2_UNORM_SRGB, 16, true, &DecodeBlockBC2, nullptr },
+    { DXGI_FORMAT_BC3_UNORM, 16, false, &DecodeBlockBC3, nullptr },
+    { DXGI_FORMAT_BC3_UNORM_SRGB, 16, true, &DecodeBlockBC3, nullptr },
+    { DXGI_FORMAT_BC4_UNORM, 8, false, &DecodeBlockBC4<false>, nullptr },
+    { DXGI_FORMAT_BC4_SNORM, 8, false, &DecodeBlockBC4<true>, nullptr },
+    { DXGI_FORMAT_BC5_UNORM, 16, false, &DecodeBlockBC5<false>, nullptr },
+    { DXGI_FORMAT_BC5_SNORM, 16, false, &DecodeBlockBC5<true>, nullptr },
+    { DXGI_FORMAT_BC6H_UF16, 16, false, &DecodeBlockBC6H<false>, nullptr },
+    { DXGI_FORMAT_BC6H_SF16, 16, false, &DecodeBlockBC6H<true>, nullptr },
+    { DXGI_FORMAT_BC7_UNORM, 16, false, &DecodeBlockBC7, nullptr },
+    { DXGI_FORMAT_BC7_UNORM_SRGB, 16, true, &DecodeBlockBC7, nullptr },
+
+    { DXGI_FORMAT_R8G8B8A8_UNORM, 4, false, nullptr, &DecodeRowR8G8B8A8 },
+    { DXGI_FORMAT_R8G8B8A8_UNORM_SRGB, 4, true, nullptr, &DecodeRowR8G8B8A8 },
+    { DXGI_FORMAT_B8G8R8A8_UNORM, 4, false, nullptr, &DecodeRowB8G8R8A8 },
+    { DXGI_FORMAT_B8G8R8A8_UNORM_SRGB, 4, true, nullptr, &DecodeRowB8G8R8A8 },
+    { DXGI_FORMAT_B8G8R8X8_UNORM, 4, false, nullptr, &DecodeRowB8G8R8X8 },
+    { DXGI_FORMAT_R8G8_UNORM, 2, false, nullptr, &DecodeRowR8G8 },
+    { DXGI_FORMAT_R8_UNORM, 1, false, nullptr, &DecodeRowR8 },
+    { DXGI_FORMAT_A8_UNORM, 1, false, nullptr, &DecodeRowA8 },
+    { DXGI_FORMAT_R10G10B10A2_UNORM, 4, false, nullptr, &DecodeRowR10G10B10A2 },
+    { DXGI_FORMAT_R16G16B16A16_UNORM, 8, false, nullptr, &DecodeRowUnorm16<4> },
+    { DXGI_FORMAT_R16G16_UNORM, 4, false, nullptr, &DecodeRowUnorm16<2> },
+    { DXGI_FORMAT_R16_UNORM, 2, false, nullptr, &DecodeRowUnorm16<1> },
+    { DXGI_FORMAT_R16G16B16A16_FLOAT, 8, false, nullptr, &DecodeRowFloat16<4> },
+    { DXGI_FORMAT_R16G16_FLOAT, 4, false, nullptr, &DecodeRowFloat16<2> },
+    { DXGI_FORMAT_R16_FLOAT, 2, false, nullptr, &DecodeRowFloat16<1> },
+    { DXGI_FORMAT_R32G32B32A32_FLOAT, 16, false, nullptr, &DecodeRowFloat32<4> },
+    { DXGI_FORMAT_R32G32B32_FLOAT, 12, false, nullptr, &DecodeRowFloat32<3> },
+    { DXGI_FORMAT_R32G32_FLOAT, 8, false, nullptr, &DecodeRowFloat32<2> },
+    { DXGI_FORMAT_R32_FLOAT, 4, false, nullptr, &DecodeRowFloat32<1> },
+};
+
+static const TextureDecoder_t* const FindTextureDecoder(const DXGI_FORMAT format)
+{
+    for (const TextureDecoder_t& decoder : s_TextureDecoders)
+    {
+        if (decoder.format == format)
+            return &decoder;
+    }
+
+    return nullptr;
+}
+
+const bool CanDecodeTexture(const DXGI_FORMAT srcFormat, const DXGI_FORMAT dstFormat)
+{
+    bool dstSrgb = false;
+    switch (dstFormat)
+    {
+    case DXGI_FORMAT_R8G8B8A8_UNORM:
+    case DXGI_FORMAT_B8G8R8A8_UNORM:
+        dstSrgb = false;
+        break;
+    case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+    case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+        dstSrgb = true;
+        break;
+    default:
+        return false;
+    }
+
+    const TextureDecoder_t* const decoder = FindTextureDecoder(srcFormat);
+    return decoder && decoder->srgb == dstSrgb;
+}
+
+static void DecodeBlockRows(const TextureDecoder_t* const decoder, const uint8_t* const src, const size_t srcRowPitch, const size_t width, const size_t height, uint8_t* const dst, const size_t dstRowPitch, const bool bgra, const size_t firstRow, const size_t lastRow)
+{
+    const size_t blocksWide = (width + 3ull) / 4ull;
+
+    uint8_t pixels[16 * 4] = {};
+    for (size_t blockRow = firstRow; blockRow < lastRow; blockRow++)
+    {
+        const uint8_t* block = src + (blockRow * srcRowPitch);
+
+        const size_t y = blockRow * 4ull;
+        const size_t rows = std::min<size_t>(4ull, height - y);
+
+        for (size_t blockCol = 0; blockCol < blocksWide; blockCol++)
+        {
+            decoder->decodeBlock(block, pixels);
+            block += decoder->blockSize;
+
+            if (bgra)
+                SwapRedBlue(pixels, 16);
+
+            // edge blocks hang off the image
+            const size_t x = blockCol * 4ull;
+            const size_t cols = std::min<size_t>(4ull, width - x);
+
+            for (size_t row = 0; row < rows; row++)
+                memcpy(dst + ((y + row) * dstRowPitch) + (x * 4ull), pixels + (row * 16ull), cols * 4ull);
+        }
+    }
+}
+
+static void DecodePixelRows(const TextureDecoder_t* const decoder, const uint8_t* const src, const size_t srcRowPitch, const size_t width, uint8_t* const dst, const size_t dstRowPitch, const bool bgra, const size_t firstRow, const size_t lastRow)
+{
+    for (size_t row = firstRow; row < lastRow; row++)
+    {
+        uint8_t* const pixels = dst + (row * dstRowPitch);
+        decoder->decodeRow(src + (row * srcRowPitch), pixels, width);
+
+        if (bgra)
+            SwapRedBlue(pixels, width);
+    }
+}
+
+//
+// NORMALS
+//
+
+// two channel normal maps (bc5) only store x and y, z is rebuilt from them.
+// the math is the same as it was when this was done per pixel on floats, every step is a single ieee op so the vector version gives exactly the same bytes.
+// https://www.tech-artists.org/t/how-to-calculate-the-blue-channel-for-normal-map/4436/7
+#if defined(TEXDECODE_SSE2)
+// four rgba8 pixels at a time
+static inline __m128i ReconstructNormal4(const __m128i pixels, const bool invertGreen)
+{
+    const __m128i byteMask = _mm_set1_epi32(0xFF);
+
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 two = _mm_set1_ps(2.0f);
+    const __m128 max = _mm_set1_ps(255.0f);
+
+    const __m128i red = _mm_and_si128(pixels, byteMask);
+    __m128i green = _mm_and_si128(_mm_srli_epi32(pixels, 8), byteMask);
+
+    if (invertGreen)
+        green = _mm_sub_epi32(byteMask, green);
+
+    const __m128 x = _mm_div_ps(_mm_cvtepi32_ps(red), max);
+    const __m128 y = _mm_div_ps(_mm_cvtepi32_ps(green), max);
+
+    const __m128 xm = _mm_sub_ps(_mm_mul_ps(two, x), one);
+    const __m128 ym = _mm_sub_ps(_mm_mul_ps(two, y), one);
+
+    const __m128 a = _mm_sub_ps(_mm_sub_ps(one, _mm_mul_ps(xm, xm)), _mm_mul_ps(ym, ym));
+
+    // can't be a valid blue value if a is negative, sqrt(0) gives the same 0.5 the scalar version used for that
+    const __m128 sq = _mm_sqrt_ps(_mm_max_ps(a, _mm_setzero_ps()));
+    const __m128 z = _mm_add_ps(_mm_div_ps(sq, two), _mm_set1_ps(0.5f));
+
+    // truncated like a cast
+    const __m128i blue = _mm_cvttps_epi32(_mm_mul_ps(z, max));
+
+    if (invertGreen)
+    {
+        const __m128i greenOut = _mm_cvttps_epi32(_mm_mul_ps(y, max));
+        return _mm_or_si128(_mm_and_si128(pixels, _mm_set1_epi32(static_cast<int>(0xFF0000FFu))), _mm_or_si128(_mm_slli_epi32(greenOut, 8), _mm_slli_epi32(blue, 16)));
+    }
+
+    return _mm_or_si128(_mm_and_si128(pixels, _mm_set1_epi32(static_cast<int>(0xFF00FFFFu))), _mm_slli_epi32(blue, 16));
+}
+
+static void ReconstructNormalPixels(uint8_t* const pixels, const size_t count, const bool invertGreen)
+{
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i* const block = reinterpret_cast<__m128i*>(pixels + (i * 4));
+        _mm_storeu_si128(block, ReconstructNormal4(_mm_loadu_si128(block), invertGreen));
+    }
+
+    // whatever's left over goes through a padded copy
+    if (i < count)
+    {
+        alignas(16) uint8_t tail[16] = {};
+        memcpy(tail, pixels + (i * 4), (count - i) * 4);
+
+        __m128i* const block = reinterpret_cast<__m128i*>(tail);
+        _mm_store_si128(block, ReconstructNormal4(_mm_load_si128(block), invertGreen));
+
+        memcpy(pixels + (i * 4), tail, (count - i) * 4);
+    }
+}
+#else
+static inline float GetNormalZFromXY(const float x, const float y)
+{
+    const float xm = (2.0f * x) - 1.0f;
+    const float ym = (2.0f * y) - 1.0f;
+
+    const float a = 1.f - (xm * xm) - (ym * ym);
+
+    // normalized (?) can't be a valid blue value if it's above 1.0f anyway.
+    if (a < 0.0f)
+        return 0.5f;
+
+    const float sq = sqrtf(a);
+
+    return (sq / 2.0f) + 0.5f;
+}
+
+static void ReconstructNormalPixels(uint8_t* const pixels, const size_t count, const bool invertGreen)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        uint8_t* const pixel = pixels + (i * 4);
+
+        const float x = static_cast<float>(pixel[0]) / 255.0f; // r
+        const float y = static_cast<float>(invertGreen ? 255 - pixel[1] : pixel[1]) / 255.0f; // g
+
+        const float z = GetNormalZFromXY(x, y);
+
+        if (invertGreen)
+            pixel[1] = static_cast<uint8_t>(y * 255.0f);
+
+        pixel[2] = static_cast<uint8_t>(z * 255.0f);
+    }
+}
+#endif
+
+enum class eNormalReconstruct
+{
+    NONE,
+    DIRECTX,
+    OPENGL, // green is inverted
+};
+
+// decodes (and optionally rebuilds normals for) every row of blocks or pixels, split into jobs on the shared task scheduler if the image is big enough
+static void DecodeTextureRows(const TextureDecoder_t* const decoder, const uint8_t* const src, const size_t srcRowPitch, const size_t width, const size_t height, uint8_t* const dst, const size_t dstRowPitch, const bool bgra, const eNormalReconstruct normals)
+{
+    // rows of blocks for compressed formats
+    const size_t rowHeight = decoder->decodeBlock ? 4ull : 1ull;
+    const size_t numRows = (height + rowHeight - 1ull) / rowHeight;
+
+    const auto decodeRows = [decoder, src, srcRowPitch, width, height, dst, dstRowPitch, bgra, normals, rowHeight](const size_t firstRow, const size_t lastRow)
+        {
+            if (decoder->decodeBlock)
+                DecodeBlockRows(decoder, src, srcRowPitch, width, height, dst, dstRowPitch, bgra, firstRow, lastRow);
+            else
+                DecodePixelRows(decoder, src, srcRowPitch, width, dst, dstRowPitch, bgra, firstRow, lastRow);
+
+            if (normals == eNormalReconstruct::NONE)
+                return;
+
+            // rows that were just decoded are still in cache
+            const size_t lastPixelRow = std::min<size_t>(lastRow * rowHeight, height);
+            for (size_t y = firstRow * rowHeight; y < lastPixelRow; y++)
+                ReconstructNormalPixels(dst + (y * dstRowPitch), width, normals == eNormalReconstruct::OPENGL);
+        };
+
+    const size_t rowsPerJob = std::max<size_t>(1ull, s_decodeJobPixels / std::max<size_t>(1ull, width * rowHeight));
+    if (numRows <= rowsPerJob)
+    {
+        decodeRows(0ull, numRows);
+        return;
+    }
+
+    // rows don't share anything, so each job can write straight into the output
+    CTaskGroup decodeJobs;
+    for (size_t row = 0; row < numRows; row += rowsPerJob)
+    {
+        const size_t lastRow = std::min<size_t>(row + rowsPerJob, numRows);
+        decodeJobs.run([decodeRows, row, lastRow]() { decodeRows(row, lastRow); });
+    }
+
+    // only runs this group's own rows while it waits, so this is fine from the ui thread
+    decodeJobs.wait();
+}
+
+const bool DecodeTexture(const uint8_t* const src, const size_t srcRowPitch, const size_t width, const size_t height, const DXGI_FORMAT srcFormat, uint8_t* const dst, const size_t dstRowPitch, const DXGI_FORMAT dstFormat)
+{
+    if (!CanDecodeTexture(srcFormat, dstFormat))
+        return false;
+
+    const TextureDecoder_t* const decoder = FindTextureDecoder(srcFormat);
+    const bool bgra = dstFormat == DXGI_FORMAT_B8G8R8A8_UNORM || dstFormat == DXGI_FORMAT_B8G8R8A8_UNORM_SRGB;
+
+    DecodeTextureRows(decoder, src, srcRowPitch, width, height, dst, dstRowPitch, bgra, eNormalReconstruct::NONE);
+
+    return true;
+}
+
+const bool DecodeNormalTexture(const uint8_t* const src, const size_t srcRowPitch, const size_t width, const size_t height, const DXGI_FORMAT srcFormat, uint8_t* const dst, const size_t dstRowPitch, const bool invertGreen)
+{
+    if (!CanDecodeTexture(srcFormat, DXGI_FORMAT_R8G8B8A8_UNORM))
+        return false;
+
+    const TextureDecoder_t* const decoder = FindTextureDecoder(srcFormat);
+
+    DecodeTextureRows(decoder, src, srcRowPitch, width, height, dst, dstRowPitch, false, invertGreen ? eNormalReconstruct::OPENGL : eNormalReconstruct::DIRECTX);
+
+    return true;
+}
+
+void ReconstructNormals(uint8_t* const pixels, const size_t numPixels, const bool invertGreen)
+{
+    if (numPixels <= s_decodeJobPixels)
+    {
+        ReconstructNormalPixels(pixels, numPixels, invertGreen);
+        return;
+    }
+
+    CTaskGroup normalJobs;
+    for (size_t pixel = 0; pixel < numPixels; pixel += s_decodeJobPixels)
+    {
+        const size_t count = std::min<size_t>(s_decodeJobPixels, numPixels - pixel);
+        normalJobs.run([pixels, pixel, count, invertGreen]() { ReconstructNormalPixels(pixels + (pixel * 4ull), count, invertGreen); });
+    }
+
+    // same as above, the wait never picks up unrelated pool work
+    normalJobs.wait();
+}
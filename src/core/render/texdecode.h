@@ -0,0 +1,20 @@
+#pragma once
+#include <dxgiformat.h>
+
+// texture decoding to 8 bit rgba that doesn't go through DirectXTex or any other windows api, so it can be run anywhere and in parallel.
+// covers the block compressed formats (bc1-bc7) and the common uncompressed formats textures come in, anything else should fall back on DirectXTex.
+
+// can srcFormat be decoded straight to dstFormat?
+// dstFormat has to be R8G8B8A8 or B8G8R8A8, srgb formats are only decoded to srgb formats (and the other way around) since we don't convert gamma.
+const bool CanDecodeTexture(const DXGI_FORMAT srcFormat, const DXGI_FORMAT dstFormat);
+
+// decodes one 2d image, srcRowPitch is the size of a row of blocks for block compressed formats.
+// big images are split up by rows of blocks and decoded on the shared task scheduler.
+const bool DecodeTexture(const uint8_t* const src, const size_t srcRowPitch, const size_t width, const size_t height, const DXGI_FORMAT srcFormat, uint8_t* const dst, const size_t dstRowPitch, const DXGI_FORMAT dstFormat);
+
+// decodes a two channel normal map (bc5) to R8G8B8A8_UNORM and rebuilds the blue channel from red and green in the same pass.
+// invertGreen flips green for opengl style normals.
+const bool DecodeNormalTexture(const uint8_t* const src, const size_t srcRowPitch, const size_t width, const size_t height, const DXGI_FORMAT srcFormat, uint8_t* const dst, const size_t dstRowPitch, const bool invertGreen);
+
+// rebuilds the blue channel of normal map pixels that are already R8G8B8A8, numPixels is the total across all rows (rows have to be tightly packed).
+void ReconstructNormals(uint8_t* const pixels, const size_t numPixels, const bool invertGreen);
@@ -41,13 +41,22 @@ public:
 
 	CManagedBuffer* ClaimBuffer()
 	{
+		CManagedBuffer* const buffer = TryClaimBuffer();
 #if defined(ASSERTS)
-		assertm(openSlots.empty() == false, "at least one slot should always be open");
+		assertm(buffer, "at least one slot should always be open");
 #endif
+		return buffer;
+	}
+
+	// returns nullptr when every buffer is in use, for callers that fall back on their own allocation
+	CManagedBuffer* TryClaimBuffer()
+	{
+		std::unique_lock<std::mutex> lock(bufferMutex);
+
+		// checked under the lock, otherwise two threads can both see the last slot
 		if (openSlots.empty())
 			return nullptr;
 
-		std::unique_lock<std::mutex> lock(bufferMutex);
 		const uint8_t index = openSlots.top();
 		openSlots.pop();
 
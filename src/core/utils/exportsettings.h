@@ -7,12 +7,15 @@ struct ExportSettings_t
 
     uint32_t exportNormalRecalcSetting;
     uint32_t exportTextureNameSetting;
+    uint32_t exportModelLodSetting;
+    uint32_t exportPngCompressionSetting;
 
     bool exportPathsFull;
     bool exportAssetDeps;
     bool exportRigSequences;
     bool exportModelSkin; 
     bool exportMaterialTextures;
+    bool exportSkipUnchanged; // skip assets that haven't changed since they were last exported, tracked through the export manifest
 
     uint32_t exportPhysicsContentsFilter;
     bool exportPhysicsFilterExclusive;
@@ -53,6 +56,42 @@ static const char* s_TextureExportNameSetting[eTextureExportName::TXTR_NAME_COUN
     "Semantic",
 };
 
+enum eModelExportLod : uint32_t
+{
+    MDL_LOD_ALL,
+    MDL_LOD_HIGHEST, // only lod 0
+    MDL_LOD_LOWEST, // only the last lod, usually used for impostors
+    MDL_LOD_HIGHEST_LOWEST,
+
+    MDL_LOD_COUNT,
+};
+
+static const char* s_ModelExportLodSetting[eModelExportLod::MDL_LOD_COUNT] =
+{
+    "All",
+    "Highest",
+    "Lowest",
+    "Highest + Lowest",
+};
+
+enum ePngExportCompression : uint32_t
+{
+    PNG_COMPRESSION_STORE, // no compression, for pngs that only get read back by other tools
+    PNG_COMPRESSION_FAST,
+    PNG_COMPRESSION_DEFAULT,
+    PNG_COMPRESSION_SMALL, // slowest, searches harder for matches
+
+    PNG_COMPRESSION_COUNT,
+};
+
+static const char* s_PngExportCompressionSetting[ePngExportCompression::PNG_COMPRESSION_COUNT] =
+{
+    "Store",
+    "Fast",
+    "Default",
+    "Small",
+};
+
 // preview settings
 #define PREVIEW_CULL_DEFAULT    1000.0f
 #define PREVIEW_CULL_MIN        256.0f // map max size
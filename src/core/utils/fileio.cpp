@@ -1,6 +1,183 @@
 #include <pch.h>
 #include <core/utils/fileio.h>
 
+// event for waiting on overlapped reads, one per thread so concurrent reads never share one
+class CThreadReadEvent
+{
+public:
+    CThreadReadEvent() : eventHandle(CreateEventA(nullptr, TRUE, FALSE, nullptr)) {};
+    ~CThreadReadEvent()
+    {
+        if (eventHandle)
+            CloseHandle(eventHandle);
+    }
+
+    inline HANDLE get() const { return eventHandle; };
+
+private:
+    HANDLE eventHandle;
+};
+
+static thread_local CThreadReadEvent s_readEvent;
+
+bool CRandomAccessFile::open(const std::string& path)
+{
+    close();
+
+    // FILE_SHARE_READ so other handles (e.g. StreamIO) can still be opened on the same file
+    // the handle has to be overlapped, windows serializes every ReadFile on a synchronous handle even when the offset is given
+    const HANDLE handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS | FILE_FLAG_OVERLAPPED, nullptr);
+    if (handle == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER largeSize = {};
+    if (!GetFileSizeEx(handle, &largeSize))
+    {
+        CloseHandle(handle);
+        return false;
+    }
+
+    fileHandle = handle;
+    fileSize = static_cast<uint64_t>(largeSize.QuadPart);
+
+    return true;
+}
+
+void CRandomAccessFile::close()
+{
+    if (fileHandle)
+    {
+        CloseHandle(static_cast<HANDLE>(fileHandle));
+        fileHandle = nullptr;
+    }
+
+    fileSize = 0ull;
+}
+
+bool CRandomAccessFile::read(void* const buf, const uint64_t offset, const uint64_t size) const
+{
+    // offsets come from asset data, so don't let offset + size wrap around
+    if (!fileHandle || size > fileSize || offset > fileSize - size)
+        return false;
+
+    const HANDLE event = s_readEvent.get();
+    if (!event)
+        return false;
+
+    char* out = static_cast<char*>(buf);
+    uint64_t remaining = size;
+    uint64_t cursor = offset;
+
+    // ReadFile can only do 32 bit sizes, split big reads up
+    while (remaining > 0ull)
+    {
+        const DWORD chunkSize = static_cast<DWORD>(std::min(remaining, static_cast<uint64_t>(0x80000000ull)));
+
+        // overlapped reads carry their own offset, so reads from other threads run alongside this one
+        OVERLAPPED overlapped = {};
+        overlapped.Offset = static_cast<DWORD>(cursor & 0xFFFFFFFFull);
+        overlapped.OffsetHigh = static_cast<DWORD>(cursor >> 32);
+        overlapped.hEvent = event;
+
+        if (!ReadFile(static_cast<HANDLE>(fileHandle), out, chunkSize, nullptr, &overlapped) && GetLastError() != ERROR_IO_PENDING)
+            return false;
+
+        DWORD numBytesRead = 0ul;
+        if (!GetOverlappedResult(static_cast<HANDLE>(fileHandle), &overlapped, &numBytesRead, TRUE) || numBytesRead != chunkSize)
+            return false;
+
+        out += numBytesRead;
+        cursor += numBytesRead;
+        remaining -= numBytesRead;
+    }
+
+    return true;
+}
+
+bool CMappedFile::open(const std::string& path)
+{
+    close();
+
+    const HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER largeSize = {};
+    if (!GetFileSizeEx(file, &largeSize) || largeSize.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    const HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0ul, 0ul, nullptr);
+    if (!mapping)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    const void* const mappedView = MapViewOfFile(mapping, FILE_MAP_READ, 0ul, 0ul, 0ull);
+    if (!mappedView)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    fileHandle = file;
+    mappingHandle = mapping;
+    view = static_cast<const char*>(mappedView);
+    fileSize = static_cast<uint64_t>(largeSize.QuadPart);
+
+    return true;
+}
+
+void CMappedFile::close()
+{
+    if (view)
+    {
+        UnmapViewOfFile(view);
+        view = nullptr;
+    }
+
+    if (mappingHandle)
+    {
+        CloseHandle(static_cast<HANDLE>(mappingHandle));
+        mappingHandle = nullptr;
+    }
+
+    if (fileHandle)
+    {
+        CloseHandle(static_cast<HANDLE>(fileHandle));
+        fileHandle = nullptr;
+    }
+
+    fileSize = 0ull;
+}
+
+static thread_local CExportOutputRecorder* s_exportOutputRecorder = nullptr;
+
+CExportOutputScope::CExportOutputScope(CExportOutputRecorder* const recorder) : prevRecorder(s_exportOutputRecorder)
+{
+    s_exportOutputRecorder = recorder;
+}
+
+CExportOutputScope::~CExportOutputScope()
+{
+    s_exportOutputRecorder = prevRecorder;
+}
+
+CExportOutputRecorder* const GetExportOutputRecorder()
+{
+    return s_exportOutputRecorder;
+}
+
+void RecordExportOutput(const std::filesystem::path& path)
+{
+    if (s_exportOutputRecorder)
+        s_exportOutputRecorder->add(path);
+}
+
 std::mutex dirMutex;
 bool CreateDirectories(const std::filesystem::path& exportPath)
 {
@@ -7,6 +7,41 @@ enum class eStreamIOMode : uint8_t
     Write
 };
 
+// collects the files written while an asset is exported, so the export manifest can tell when one has been deleted since.
+// set for the current thread with CExportOutputScope, tasks an export hands to the pool have to open a scope with the same recorder.
+class CExportOutputRecorder
+{
+public:
+    void add(const std::filesystem::path& path)
+    {
+        std::lock_guard<std::mutex> lock(outputMutex);
+        outputs.emplace_back(path.string());
+    }
+
+    // only valid once every task writing for this export has finished
+    inline const std::vector<std::string>& getOutputs() const { return outputs; };
+
+private:
+    std::mutex outputMutex;
+    std::vector<std::string> outputs;
+};
+
+class CExportOutputScope
+{
+public:
+    CExportOutputScope(CExportOutputRecorder* const recorder);
+    ~CExportOutputScope();
+
+    CExportOutputScope(const CExportOutputScope&) = delete;
+    CExportOutputScope& operator=(const CExportOutputScope&) = delete;
+
+private:
+    CExportOutputRecorder* prevRecorder;
+};
+
+CExportOutputRecorder* const GetExportOutputRecorder(); // recorder for the current thread, null if nothing is being recorded
+void RecordExportOutput(const std::filesystem::path& path);
+
 class StreamIO
 {
 public:
@@ -38,6 +73,8 @@ public:
             {
                 currentMode = eStreamIOMode::None;
             }
+            else
+                RecordExportOutput(path);
         }
         // Read mode
         else if (mode == eStreamIOMode::Read)
@@ -275,6 +312,66 @@ private:
     eStreamIOMode currentMode;
 };
 
+// read only file handle that is opened once and shared between threads.
+// reads are positional (offset is passed with every read) so concurrent readers never fight over a seek cursor.
+class CRandomAccessFile
+{
+public:
+    CRandomAccessFile() : fileHandle(nullptr), fileSize(0ull) {};
+    ~CRandomAccessFile()
+    {
+        close();
+    }
+
+    CRandomAccessFile(const CRandomAccessFile&) = delete;
+    CRandomAccessFile& operator=(const CRandomAccessFile&) = delete;
+
+    // opens a file for reading. Returns whether the open operation was successful
+    bool open(const std::string& path);
+    void close();
+
+    // reads 'size' bytes at 'offset' into 'buf', safe to call from multiple threads at once.
+    bool read(void* const buf, const uint64_t offset, const uint64_t size) const;
+
+    inline const bool isOpen() const { return fileHandle != nullptr; };
+    inline const uint64_t size() const { return fileSize; };
+
+private:
+    void* fileHandle; // HANDLE
+    uint64_t fileSize;
+};
+
+// read only memory mapping of a whole file, the view stays valid until the file is closed.
+class CMappedFile
+{
+public:
+    CMappedFile() : fileHandle(nullptr), mappingHandle(nullptr), view(nullptr), fileSize(0ull) {};
+    ~CMappedFile()
+    {
+        close();
+    }
+
+    CMappedFile(const CMappedFile&) = delete;
+    CMappedFile& operator=(const CMappedFile&) = delete;
+
+    // maps a file for reading. Returns whether the mapping was successful
+    bool open(const std::string& path);
+    void close();
+
+    inline const bool isOpen() const { return view != nullptr; };
+    inline const char* const data() const { return view; };
+    inline const uint64_t size() const { return fileSize; };
+
+    // checks if a range is fully inside of the mapped file
+    inline const bool contains(const uint64_t offset, const uint64_t size) const { return view && offset <= fileSize && size <= fileSize - offset; };
+
+private:
+    void* fileHandle; // HANDLE
+    void* mappingHandle; // HANDLE
+    const char* view;
+    uint64_t fileSize;
+};
+
 bool CreateDirectories(const std::filesystem::path& exportPath);
 bool RestoreCurrentWorkingDirectory();
 
@@ -1,13 +1,81 @@
 #include <pch.h>
 
 #include <core/utils/ramen.h>
+#include <core/cache/spillcache.h>
 #include <thirdparty/oodle/oodle2.h>
 #include <game/rtech/utils/utils.h>
- 
+
+constexpr OodleLZ_Compressor noodleCompressorFast = OodleLZ_Compressor_Selkie;
+constexpr OodleLZ_CompressionLevel noodleCompressionLevelFast = OodleLZ_CompressionLevel_SuperFast;
+
 constexpr OodleLZ_Compressor noodleCompressor = OodleLZ_Compressor_Kraken;
 constexpr OodleLZ_CompressionLevel noodleCompressionLevel = OodleLZ_CompressionLevel_VeryFast;
 
-const size_t CRamen::addIdx(const size_t index, char* const buf, const size_t bufSize)
+const eRamenStorage CRamen::pickStorage() const
+{
+	const eRamenStorage policy = s_storagePolicy;
+	if (policy != eRamenStorage::RAMEN_STORAGE_AUTO)
+		return policy;
+
+	// keep things raw while there's plenty of room, then trade access speed for memory as we get closer to the budget
+	const size_t budget = s_memoryBudget;
+	const size_t resident = s_residentSize;
+
+	if (resident < (budget / 2ull))
+		return eRamenStorage::RAMEN_STORAGE_RAW;
+
+	if (resident < budget)
+		return eRamenStorage::RAMEN_STORAGE_FAST;
+
+	return eRamenStorage::RAMEN_STORAGE_KRAKEN;
+}
+
+char* const CRamen::arenaReserve(const size_t size)
+{
+	if (arena)
+	{
+		const size_t offset = IALIGN(arena->used, arenaAlignment);
+		if (offset + size <= arena->size)
+			return arena->Data() + offset;
+	}
+
+	// grow block sizes with each block so small ramens stay small, big noodles get a block of their own size
+	const size_t blockSize = std::max(arena ? std::min(arena->size * 2ull, arenaMaxBlockSize) : arenaMinBlockSize, size);
+
+	ArenaBlock_t* const block = reinterpret_cast<ArenaBlock_t*>(new char[sizeof(ArenaBlock_t) + blockSize]);
+	block->prev = arena;
+	block->size = blockSize;
+	block->used = 0ull;
+
+	arena = block;
+	arenaSize += sizeof(ArenaBlock_t) + blockSize;
+	s_residentSize += sizeof(ArenaBlock_t) + blockSize;
+
+	return block->Data();
+}
+
+void CRamen::arenaCommit(const size_t size)
+{
+	assertm(arena, "committing without a reserved block");
+	arena->used = IALIGN(arena->used, arenaAlignment) + size;
+}
+
+void CRamen::freeArena()
+{
+	while (arena)
+	{
+		ArenaBlock_t* const prev = arena->prev;
+
+		delete[] reinterpret_cast<char*>(arena);
+
+		arena = prev;
+	}
+
+	s_residentSize -= arenaSize;
+	arenaSize = 0ull;
+}
+
+const size_t CRamen::addIdx(const size_t index, const char* const buf, const size_t bufSize)
 {
 	if (index > noodleSize)
 	{
@@ -15,59 +83,299 @@ const size_t CRamen::addIdx(const size_t index, char* const buf, const size_t bu
 		return invalidNoodleIdx;
 	}
 
+	// decided when the first noodle goes in so a ramen never switches halfway
+	if (noodleSize == 0ull && !arena)
+		spillable = g_spillCache.IsEnabled();
+
+	std::unique_lock<std::shared_mutex> lock(spillMutex, std::defer_lock);
+	if (spillable)
+	{
+		lock.lock();
+
+		if (spilled)
+			faultIn();
+
+		// the spilled copy is out of date now
+		dropSpill();
+	}
+
 	ensureCapacity(noodleSize + 1);
 
-	const size_t compSizeRequired = OodleLZ_GetCompressedBufferSizeNeeded(noodleCompressor, bufSize); // this will not be the actual compressed size which is not ideal
-	char* const compBuf = new char[compSizeRequired];
-	const size_t compSize = OodleLZ_Compress(noodleCompressor, buf, bufSize, compBuf, noodleCompressionLevel);
-	if (compSize == OODLELZ_FAILED)
+	const eRamenStorage storage = pickStorage();
+	if (storage != eRamenStorage::RAMEN_STORAGE_RAW)
 	{
-		assert(false); // odd, report in debug
+		const OodleLZ_Compressor compressor = storage == eRamenStorage::RAMEN_STORAGE_FAST ? noodleCompressorFast : noodleCompressor;
+		const OodleLZ_CompressionLevel level = storage == eRamenStorage::RAMEN_STORAGE_FAST ? noodleCompressionLevelFast : noodleCompressionLevel;
+
+		// compress straight into the arena, oodle wants more room than it will use but only what it actually wrote is committed
+		const size_t compSizeRequired = OodleLZ_GetCompressedBufferSizeNeeded(compressor, bufSize);
+		char* const compBuf = arenaReserve(compSizeRequired);
+		const size_t compSize = OodleLZ_Compress(compressor, buf, bufSize, compBuf, level);
+
+		assert(compSize != OODLELZ_FAILED); // odd, report in debug
+
+		if (compSize != OODLELZ_FAILED && compSize < bufSize)
+		{
+			arenaCommit(compSize);
+			noodles[index] = new CNoodle(compBuf, compSize, bufSize, storage);
 
-		delete[] compBuf;
-		noodles[index] = new CNoodle(buf, 0ull, bufSize, false);
+			noodleSize++;
 
-		noodleSize++;
+			if (spillable)
+				g_spillCache.Touch(this, arenaSize);
 
-		return index;
+			return index;
+		}
+
+		// failed or didn't shrink, store it raw
 	}
 
-	// oodle demands more memory than it actually uses, fix up.
-	char* const compBufShrink = new char[compSize];
-	memcpy(compBufShrink, compBuf, compSize);
-	delete[] compBuf;
+	char* const rawBuf = arenaReserve(bufSize);
+	memcpy(rawBuf, buf, bufSize);
+	arenaCommit(bufSize);
 
-	noodles[index] = new CNoodle(compBufShrink, compSize, bufSize, true);
+	noodles[index] = new CNoodle(rawBuf, bufSize, bufSize, eRamenStorage::RAMEN_STORAGE_RAW);
 
 	noodleSize++;
 
+	if (spillable)
+		g_spillCache.Touch(this, arenaSize);
+
 	return index;
 }
 
-std::unique_ptr<char[]> CRamen::getIdx(const size_t index) const
+const char* const CRamen::readIdx(const size_t index, char* const out, const size_t outSize) const
+{
+	const CNoodle* const thisChunk = noodles[index];
+	if (thisChunk->storage == eRamenStorage::RAMEN_STORAGE_RAW)
+		return thisChunk->data;
+
+	if (outSize < thisChunk->decompressedSize)
+	{
+		assertm(false, "output buffer too small for noodle");
+		return nullptr;
+	}
+
+	const size_t decompSize = OodleLZ_Decompress(thisChunk->data, thisChunk->compressedSize, out, thisChunk->decompressedSize);
+	if (decompSize == OODLELZ_FAILED)
+	{
+		assert(false);
+		return nullptr;
+	}
+
+	assert(decompSize == thisChunk->decompressedSize);
+	return out;
+}
+
+const char* const CRamen::getIdx(const size_t index, char* const out, const size_t outSize) const
 {
 	if (capacity == 0)
 		return nullptr;
 
-	CNoodle* const thisChunk = noodles[index];
-	std::unique_ptr<char[]> out = std::make_unique<char[]>(thisChunk->decompressedSize);
-	if (thisChunk->isCompressed)
+	if (!spillable)
+		return readIdx(index, out, outSize);
+
+	std::shared_lock<std::shared_mutex> lock(spillMutex);
+
+	// can't be spilled while we hold the lock, but it can happen between faulting in and getting it back
+	bool faulted = false;
+	while (spilled)
+	{
+		lock.unlock();
+
+		{
+			// faulting in doesn't change what the noodles hold
+			std::unique_lock<std::shared_mutex> faultLock(spillMutex);
+			if (spilled)
+				const_cast<CRamen*>(this)->faultIn();
+		}
+
+		faulted = true;
+		lock.lock();
+	}
+
+	if (!faulted)
+		g_spillCache.RecordHit();
+
+	g_spillCache.Touch(const_cast<CRamen*>(this), arenaSize);
+
+	const CNoodle* const thisChunk = noodles[index];
+	if (outSize < thisChunk->decompressedSize)
+	{
+		assertm(false, "output buffer too small for noodle");
+		return nullptr;
+	}
+
+	// the arena can be spilled as soon as we let go of the lock, so raw noodles get copied out too
+	const char* const data = readIdx(index, out, outSize);
+	if (data && data != out)
+		memcpy(out, data, thisChunk->decompressedSize);
+
+	return data ? out : nullptr;
+}
+
+void CRamen::clear()
+{
+	std::unique_lock<std::shared_mutex> lock(spillMutex);
+
+	// needs the noodles to know how big the spilled copy was
+	if (spillable)
+	{
+		g_spillCache.Remove(this);
+		dropSpill();
+
+		spillable = false;
+		spilled = false;
+	}
+
+	if (noodles != nullptr)
+	{
+		for (size_t i = 0ull; i < noodleSize; ++i)
+		{
+			if (noodles[i])
+				delete noodles[i];
+		}
+	}
+
+	noodleSize = 0;
+
+	// nothing references the arena anymore
+	freeArena();
+}
+
+void CRamen::move(CRamen& raman)
+{
+	if (this == &raman)
+		return;
+
+	clear();
+	shrink();
+
+	std::unique_lock<std::shared_mutex> lock(raman.spillMutex);
+
+	this->noodles = raman.noodles;
+	this->capacity = raman.capacity;
+	this->noodleSize = raman.noodleSize;
+	this->arena = raman.arena;
+	this->arenaSize = raman.arenaSize;
+	this->spillOffset = raman.spillOffset;
+	this->spillable = raman.spillable;
+	this->spilled = raman.spilled;
+
+	if (raman.spillable)
+		g_spillCache.Replace(&raman, this);
+
+	raman.noodles = nullptr;
+	raman.capacity = 0ull;
+	raman.noodleSize = 0ull;
+	raman.arena = nullptr;
+	raman.arenaSize = 0ull;
+	raman.spillOffset = invalidSpillOffset;
+	raman.spillable = false;
+	raman.spilled = false;
+}
+
+const size_t CRamen::spilledSize() const
+{
+	size_t size = 0ull;
+	for (size_t i = 0ull; i < noodleSize; ++i)
+		size = IALIGN(size, arenaAlignment) + noodles[i]->compressedSize;
+
+	return size;
+}
+
+const bool CRamen::trySpill()
+{
+	std::unique_lock<std::shared_mutex> lock(spillMutex, std::try_to_lock);
+	if (!lock.owns_lock() || spilled || !arena)
+		return false;
+
+	CSpillFile* const file = g_spillCache.File();
+
+	// still have a copy from the last time we were spilled, no need to write it again
+	if (spillOffset == invalidSpillOffset)
 	{
-		const size_t decompSize = OodleLZ_Decompress(thisChunk->data, thisChunk->compressedSize, out.get(), thisChunk->decompressedSize);
-		if (decompSize == OODLELZ_FAILED)
+		const size_t size = spilledSize();
+
+		spillOffset = file->Alloc(size);
+		if (spillOffset == invalidSpillOffset)
+			return false;
+
+		char* const spillData = file->Data(spillOffset);
+
+		size_t offset = 0ull;
+		for (size_t i = 0ull; i < noodleSize; ++i)
 		{
-			assert(false);
-			return nullptr;
+			offset = IALIGN(offset, arenaAlignment);
+
+			memcpy(spillData + offset, noodles[i]->data, noodles[i]->compressedSize);
+			offset += noodles[i]->compressedSize;
 		}
 
-		assert(decompSize == thisChunk->decompressedSize);
-		return out;
+		g_spillCache.RecordSpill(size);
 	}
-	else
+
+	for (size_t i = 0ull; i < noodleSize; ++i)
+		noodles[i]->data = nullptr;
+
+	freeArena();
+	spilled = true;
+
+	return true;
+}
+
+void CRamen::faultIn()
+{
+	assertm(spilled && spillOffset != invalidSpillOffset, "faulting in a ramen that isn't spilled");
+
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	const size_t size = spilledSize();
+	const char* const spillData = g_spillCache.File()->Data(spillOffset);
+
+	// everything goes back into one block
+	char* const buf = arenaReserve(size);
+	memcpy(buf, spillData, size);
+	arenaCommit(size);
+
+	size_t offset = 0ull;
+	for (size_t i = 0ull; i < noodleSize; ++i)
 	{
-		memcpy(out.get(), thisChunk->data, thisChunk->decompressedSize);
-		return out;
+		offset = IALIGN(offset, arenaAlignment);
+
+		noodles[i]->data = buf + offset;
+		offset += noodles[i]->compressedSize;
 	}
 
-	unreachable();
-}
\ No newline at end of file
+	spilled = false;
+
+	const uint64_t timeUs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+	g_spillCache.RecordFault(size, timeUs);
+}
+
+void CRamen::dropSpill()
+{
+	if (spillOffset == invalidSpillOffset)
+		return;
+
+	g_spillCache.File()->Free(spillOffset, spilledSize());
+	spillOffset = invalidSpillOffset;
+}
+
+std::unique_ptr<char[]> CRamen::getIdx(const size_t index) const
+{
+	if (capacity == 0)
+		return nullptr;
+
+	const CNoodle* const thisChunk = noodles[index];
+	std::unique_ptr<char[]> out = std::make_unique<char[]>(thisChunk->decompressedSize);
+
+	const char* const data = getIdx(index, out.get(), thisChunk->decompressedSize);
+	if (!data)
+		return nullptr;
+
+	if (data != out.get())
+		memcpy(out.get(), data, thisChunk->decompressedSize);
+
+	return out;
+}
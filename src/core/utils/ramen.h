@@ -1,6 +1,26 @@
 #pragma once
 
 static constexpr size_t invalidNoodleIdx = 0xFFFFFFFFFFFFFFFF;
+static constexpr uint64_t invalidSpillOffset = 0xFFFFFFFFFFFFFFFF;
+
+// how noodles are kept in memory
+enum eRamenStorage : uint8_t
+{
+	RAMEN_STORAGE_AUTO,		// picked per noodle, based on how much parsed data is resident compared to the memory budget
+	RAMEN_STORAGE_RAW,		// uncompressed, free to access
+	RAMEN_STORAGE_FAST,		// oodle selkie, lz4 class speed with a worse ratio
+	RAMEN_STORAGE_KRAKEN,	// oodle kraken, smallest but slowest to access
+
+	RAMEN_STORAGE_COUNT,
+};
+
+static const char* s_RamenStorageSetting[eRamenStorage::RAMEN_STORAGE_COUNT] =
+{
+	"Auto",
+	"Raw",
+	"Fast",
+	"Kraken",
+};
 
 class CRamen
 {
@@ -9,24 +29,16 @@ public:
 	{
 	public:
 		CNoodle() = delete; // no default constructor.
-		CNoodle(char* const buf, const size_t compSize, const size_t decompSize, bool isComp) : data(buf), compressedSize(compSize), decompressedSize(decompSize), isCompressed(isComp) {};
-		inline ~CNoodle()
-		{
-			if (data)
-			{
-				delete[] data;
-				data = nullptr;
-			}
-		}
+		CNoodle(const char* const buf, const size_t compSize, const size_t decompSize, const eRamenStorage storageType) : data(buf), compressedSize(compSize), decompressedSize(decompSize), storage(storageType) {};
 
-		char* data;
+		const char* data; // owned by the ramen's arena
 		size_t compressedSize;
 		size_t decompressedSize;
-		bool isCompressed;
+		eRamenStorage storage;
 	};
 
-	inline CRamen() : noodles(nullptr), capacity(0ull), noodleSize(0ull) {};
-	inline CRamen(const size_t size) : noodles(nullptr), capacity(0ull), noodleSize(0ull)
+	inline CRamen() : noodles(nullptr), capacity(0ull), noodleSize(0ull), arena(nullptr), arenaSize(0ull), spillOffset(invalidSpillOffset), spillable(false), spilled(false) {};
+	inline CRamen(const size_t size) : noodles(nullptr), capacity(0ull), noodleSize(0ull), arena(nullptr), arenaSize(0ull), spillOffset(invalidSpillOffset), spillable(false), spilled(false)
 	{
 		resize(size);
 	}
@@ -40,45 +52,25 @@ public:
 	CRamen& operator=(const CRamen&) = delete;
 	CRamen& operator=(CRamen&& dataChunks) noexcept
 	{
-		if (this != &dataChunks)
-		{
-			clear();
-			shrink();
-
-			this->noodles = dataChunks.noodles;
-			this->capacity = dataChunks.capacity;
-			this->noodleSize = dataChunks.noodleSize;
-
-			dataChunks.noodles = nullptr;
-			dataChunks.capacity = 0ull;
-			dataChunks.noodleSize = 0ull;
-		}
-
+		move(dataChunks);
 		return *this;
 	}
 
-	inline void move(CRamen& raman)
-	{
-		if (this != &raman)
-		{
-			clear();
-			shrink();
-
-			this->noodles = raman.noodles;
-			this->capacity = raman.capacity;
-			this->noodleSize = raman.noodleSize;
-
-			raman.noodles = nullptr;
-			raman.capacity = 0ull;
-			raman.noodleSize = 0ull;
-		}
-	}
+	void move(CRamen& raman);
 
-	inline const size_t addBack(char* const buf, const size_t bufSize)
+	inline const size_t addBack(const char* const buf, const size_t bufSize)
 	{ 
 		return addIdx(noodleSize, buf, bufSize);
 	}
 
+	// decompresses into out, which has to hold at least getSize(index) bytes
+	// returns the noodle's data, this is out unless the noodle is stored raw, in which case no copy is made
+	const char* const getIdx(const size_t index, char* const out, const size_t outSize) const;
+	inline const size_t getSize(const size_t index) const
+	{
+		return noodles[index]->decompressedSize;
+	}
+
 	std::unique_ptr<char[]> getIdx(const size_t index) const;
 	inline std::unique_ptr<char[]> getBack() const
 	{
@@ -90,20 +82,7 @@ public:
 		return getIdx(0ull);
 	}
 
-	inline void clear()
-	{
-		// only clear the data itself
-		if (noodles != nullptr)
-		{
-			for (size_t i = 0ull; i < noodleSize; ++i)
-			{
-				if (noodles[i])
-					delete noodles[i];
-			}
-		}
-
-		noodleSize = 0;
-	}
+	void clear(); // only clear the data itself
 
 	inline void nuke()
 	{
@@ -119,6 +98,9 @@ public:
 
 	inline void resize(const size_t newSize) // resize with potential data loss
 	{
+		// the noodle array can get reallocated, can't have it spilled at the same time
+		std::unique_lock<std::shared_mutex> lock(spillMutex);
+
 		if (newSize > capacity) // grow
 		{
 			const size_t newCapacity = std::max(capacity * 2ull, newSize);
@@ -159,8 +141,48 @@ public:
 		return (noodles + noodleSize);
 	}
 
+	// policy used by every ramen for noodles added from now on, budget is in bytes and only used by RAMEN_STORAGE_AUTO
+	static inline void SetStoragePolicy(const eRamenStorage policy, const size_t budget)
+	{
+		s_storagePolicy = policy;
+		s_memoryBudget = budget;
+	}
+
+	// bytes held by all ramen arenas
+	static inline const size_t ResidentSize() { return s_residentSize; }
+
 private:
-	const size_t addIdx(const size_t index, char* const buf, const size_t size);
+	friend class CSpillCache;
+
+	// noodle data is packed into blocks instead of getting an allocation each
+	struct alignas(16) ArenaBlock_t
+	{
+		ArenaBlock_t* prev;
+		size_t size;
+		size_t used;
+
+		inline char* const Data() { return reinterpret_cast<char*>(this + 1); }
+	};
+
+	static constexpr size_t arenaAlignment = 16ull; // noodles get cast to structs by their users
+	static constexpr size_t arenaMinBlockSize = 64ull * 1024ull;
+	static constexpr size_t arenaMaxBlockSize = 4ull * 1024ull * 1024ull;
+
+	const size_t addIdx(const size_t index, const char* const buf, const size_t size);
+
+	const eRamenStorage pickStorage() const;
+
+	const char* const readIdx(const size_t index, char* const out, const size_t outSize) const;
+
+	char* const arenaReserve(const size_t size);
+	void arenaCommit(const size_t size);
+	void freeArena();
+
+	// spilling, see core/cache/spillcache.h. all of these expect spillMutex to be held
+	const size_t spilledSize() const; // noodles are packed back to back when spilled
+	const bool trySpill(); // takes the lock itself, fails if the ramen is in use
+	void faultIn();
+	void dropSpill();
 
 	inline void ensureCapacity(size_t newCapacity)
 	{
@@ -186,4 +208,16 @@ private:
 	CNoodle** noodles;
 	size_t capacity;
 	size_t noodleSize;
+
+	ArenaBlock_t* arena; // newest block
+	size_t arenaSize; // bytes held by all blocks
+
+	mutable std::shared_mutex spillMutex;
+	uint64_t spillOffset; // copy in the spill file, stays valid while no noodles get added so spilling again is free
+	bool spillable; // created while the spill cache was on, never hands out pointers into the arena as it can go away
+	bool spilled;
+
+	static inline std::atomic<eRamenStorage> s_storagePolicy = eRamenStorage::RAMEN_STORAGE_AUTO;
+	static inline std::atomic<size_t> s_memoryBudget = 2048ull * 1024ull * 1024ull;
+	static inline std::atomic<size_t> s_residentSize = 0ull;
 };
\ No newline at end of file
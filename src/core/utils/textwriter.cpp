@@ -0,0 +1,41 @@
+#include <pch.h>
+#include <core/utils/textwriter.h>
+
+CTextWriter::CTextWriter(const std::filesystem::path& path, const bool textMode) : buffer(std::make_unique_for_overwrite<char[]>(bufferSize)), bufferPos(0ull), outString(nullptr)
+{
+    outFile.open(path, textMode ? std::ios::out : std::ios::out | std::ios::binary);
+
+    if (outFile.is_open())
+        RecordExportOutput(path);
+}
+
+CTextWriter::CTextWriter(std::string* const outStr) : buffer(std::make_unique_for_overwrite<char[]>(bufferSize)), bufferPos(0ull), outString(outStr)
+{
+}
+
+void CTextWriter::WriteOut(const char* const data, const size_t size)
+{
+    if (outString)
+        outString->append(data, size);
+    else if (outFile.is_open())
+        outFile.write(data, static_cast<std::streamsize>(size));
+}
+
+void CTextWriter::Flush()
+{
+    if (bufferPos == 0ull)
+        return;
+
+    WriteOut(buffer.get(), bufferPos);
+    bufferPos = 0ull;
+}
+
+void CTextWriter::Close()
+{
+    Flush();
+
+    if (outFile.is_open())
+        outFile.close();
+
+    outString = nullptr;
+}
@@ -0,0 +1,108 @@
+#pragma once
+#include <charconv>
+
+// buffered writer for text exports, numbers are formatted with std::to_chars straight into the buffer so nothing is allocated per value.
+// output either goes to a file in large blocks, or is appended to a string for text that also gets previewed.
+class CTextWriter
+{
+public:
+    static constexpr size_t bufferSize = 256ull * 1024ull;
+
+    // textMode translates line endings like a std::ofstream opened without std::ios::binary
+    CTextWriter(const std::filesystem::path& path, const bool textMode = false);
+    CTextWriter(std::string* const outStr);
+    ~CTextWriter()
+    {
+        Close();
+    }
+
+    CTextWriter(const CTextWriter&) = delete;
+    CTextWriter& operator=(const CTextWriter&) = delete;
+
+    inline const bool IsOpen() const { return outString || outFile.is_open(); };
+
+    void Flush();
+    void Close();
+
+    inline CTextWriter& Write(const char* const data, const size_t size)
+    {
+        if (size > bufferSize - bufferPos)
+        {
+            Flush();
+
+            // too big to be worth buffering
+            if (size > bufferSize)
+            {
+                WriteOut(data, size);
+                return *this;
+            }
+        }
+
+        memcpy(buffer.get() + bufferPos, data, size);
+        bufferPos += size;
+
+        return *this;
+    }
+
+    // these match what the same value written to a std::ostream would look like
+    inline CTextWriter& operator<<(const char* const str) { return Write(str, strlen(str)); };
+    inline CTextWriter& operator<<(const std::string& str) { return Write(str.data(), str.length()); };
+    inline CTextWriter& operator<<(const std::string_view str) { return Write(str.data(), str.length()); };
+    inline CTextWriter& operator<<(const char c) { return Write(&c, 1ull); };
+
+    // bools are written as 0 or 1, see WriteBool
+    template <typename T> requires (std::is_integral_v<T> && !std::is_same_v<T, char> && !std::is_same_v<T, signed char> && !std::is_same_v<T, unsigned char>)
+    inline CTextWriter& operator<<(const T value)
+    {
+        return ToChars(value);
+    }
+
+    // streams write floats with six significant digits
+    inline CTextWriter& operator<<(const float value) { return ToChars(static_cast<double>(value), std::chars_format::general, 6); };
+    inline CTextWriter& operator<<(const double value) { return ToChars(value, std::chars_format::general, 6); };
+
+    // same as std::boolalpha
+    inline CTextWriter& WriteBool(const bool value) { return value ? Write("true", 4ull) : Write("false", 5ull); };
+
+    // shortest text that reads back as the same value, same as std::format("{}")
+    inline CTextWriter& WriteShortest(const float value) { return ToChars(value); };
+
+    // same as std::format("{:f}")
+    inline CTextWriter& WriteFixed(const float value) { return ToChars(static_cast<double>(value), std::chars_format::fixed, 6); };
+
+    // same as std::hex, lowercase without a prefix or padding
+    inline CTextWriter& WriteHex(const uint64_t value) { return ToChars(value, 16); };
+
+private:
+    // makes sure there's room for the longest number we could write
+    inline char* const Reserve()
+    {
+        // longest double written as fixed is over 300 characters
+        constexpr size_t maxNumberLength = 512ull;
+
+        if (bufferSize - bufferPos < maxNumberLength)
+            Flush();
+
+        return buffer.get() + bufferPos;
+    }
+
+    template <typename... Args>
+    inline CTextWriter& ToChars(const Args... args)
+    {
+        char* const start = Reserve();
+        const std::to_chars_result result = std::to_chars(start, buffer.get() + bufferSize, args...);
+
+        assertm(result.ec == std::errc(), "number did not fit in the text buffer");
+        bufferPos += result.ptr - start;
+
+        return *this;
+    }
+
+    void WriteOut(const char* const data, const size_t size);
+
+    std::unique_ptr<char[]> buffer;
+    size_t bufferPos;
+
+    std::ofstream outFile;
+    std::string* outString;
+};
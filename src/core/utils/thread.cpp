@@ -0,0 +1,241 @@
+#include <pch.h>
+#include <core/utils/thread.h>
+
+// index of the worker running on this thread, -1 for threads that aren't part of the pool
+static thread_local int s_workerIdx = -1;
+
+CTaskScheduler::CTaskScheduler(const uint32_t workerCount) : nextWorker(0u), queuedTasks(0u), sleepingWorkers(0u), shutdown(false)
+{
+    const uint32_t count = std::max(workerCount, 1u);
+
+    workers.reserve(count);
+    for (uint32_t i = 0; i < count; ++i)
+        workers.emplace_back(std::make_unique<Worker_t>());
+
+    threads.reserve(count);
+    for (uint32_t i = 0; i < count; ++i)
+        threads.emplace_back([this, i]() { this->workerThread(i); });
+}
+
+CTaskScheduler::~CTaskScheduler()
+{
+    {
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        shutdown = true;
+    }
+
+    wakeCondition.notify_all();
+
+    for (std::thread& thread : threads)
+    {
+        if (thread.joinable())
+            thread.join();
+    }
+}
+
+void CTaskScheduler::submit(CTaskGroup* const group, std::function<void()>&& func)
+{
+    group->pendingTasks++;
+
+    // tasks submitted from a worker stay on that worker, so nested work is picked up by the thread that made it
+    const uint32_t workerIdx = s_workerIdx >= 0 ? static_cast<uint32_t>(s_workerIdx) : nextWorker++ % getWorkerCount();
+    Worker_t* const worker = workers[workerIdx].get();
+
+    pushTask(worker, { std::move(func), group });
+
+    wakeWorkers(1u);
+    wakeGroupWaiters(group);
+}
+
+void CTaskScheduler::submitBatch(CTaskGroup* const group, std::vector<std::function<void()>>& funcs)
+{
+    if (funcs.empty())
+        return;
+
+    const uint32_t taskCount = static_cast<uint32_t>(funcs.size());
+    group->pendingTasks += taskCount;
+
+    // spread the batch over every worker so they can all start straight away without stealing
+    const uint32_t workerCount = getWorkerCount();
+    const uint32_t firstWorker = nextWorker.fetch_add(taskCount) % workerCount;
+    for (uint32_t i = 0; i < taskCount; ++i)
+    {
+        Worker_t* const worker = workers[(firstWorker + i) % workerCount].get();
+        pushTask(worker, { std::move(funcs[i]), group });
+    }
+
+    funcs.clear();
+
+    wakeWorkers(taskCount);
+    wakeGroupWaiters(group);
+}
+
+void CTaskScheduler::wait(CTaskGroup* const group)
+{
+    while (!group->isDone())
+    {
+        if (tryRunTask(group))
+            continue;
+
+        // nothing left to help with, the rest of the group is running on other threads.
+        // sleep until either the group is done or it gets more tasks
+        std::unique_lock<std::mutex> lock(wakeMutex);
+
+        // counted before the condition is checked, so a submit either sees us waiting or we see its task
+        group->numWaiters++;
+        waitCondition.wait(lock, [group]() { return group->isDone() || group->queuedTasks > 0u; });
+        group->numWaiters--;
+    }
+}
+
+bool CTaskScheduler::tryRunTask(CTaskGroup* const group)
+{
+    Task_t task;
+    if (!popTask(task, group))
+        return false;
+
+    runTask(task);
+    return true;
+}
+
+void CTaskScheduler::pushTask(Worker_t* const worker, Task_t&& task)
+{
+    CTaskGroup* const group = task.group;
+
+    // counts are changed under the same lock as the deque, so a task can't be popped (and counted down) before it has been counted
+    std::unique_lock<std::mutex> lock(worker->mutex);
+    worker->tasks.push_back(std::move(task));
+
+    group->queuedTasks++;
+    queuedTasks++;
+}
+
+bool CTaskScheduler::popTask(Task_t& task, const CTaskGroup* const group)
+{
+    const uint32_t workerCount = getWorkerCount();
+
+    const auto inGroup = [group](const Task_t& queued) { return !group || queued.group == group; };
+
+    // our own tasks first, newest first since they are most likely to still be in cache
+    if (s_workerIdx >= 0)
+    {
+        Worker_t* const worker = workers[s_workerIdx].get();
+
+        std::unique_lock<std::mutex> lock(worker->mutex);
+
+        const auto it = std::find_if(worker->tasks.rbegin(), worker->tasks.rend(), inGroup);
+        if (it != worker->tasks.rend())
+        {
+            task = std::move(*it);
+            worker->tasks.erase(std::next(it).base());
+
+            task.group->queuedTasks--;
+            queuedTasks--;
+            return true;
+        }
+    }
+
+    // steal the oldest task from another worker
+    const uint32_t firstVictim = s_workerIdx >= 0 ? static_cast<uint32_t>(s_workerIdx) + 1u : 0u;
+    for (uint32_t i = 0; i < workerCount; ++i)
+    {
+        const uint32_t victimIdx = (firstVictim + i) % workerCount;
+        if (static_cast<int>(victimIdx) == s_workerIdx)
+            continue;
+
+        Worker_t* const victim = workers[victimIdx].get();
+
+        std::unique_lock<std::mutex> lock(victim->mutex);
+
+        const auto it = std::find_if(victim->tasks.begin(), victim->tasks.end(), inGroup);
+        if (it != victim->tasks.end())
+        {
+            task = std::move(*it);
+            victim->tasks.erase(it);
+
+            task.group->queuedTasks--;
+            queuedTasks--;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void CTaskScheduler::runTask(Task_t& task)
+{
+    CTaskGroup* const group = task.group;
+
+    if (!group->isCancelled())
+        task.func();
+
+    // last task of the group, wake anything waiting on it.
+    // the group can be destroyed as soon as the count hits zero, so it's not touched after that and the lock is always taken here
+    if (--group->pendingTasks == 0u)
+    {
+        {
+            std::unique_lock<std::mutex> lock(wakeMutex);
+        }
+
+        waitCondition.notify_all();
+    }
+}
+
+void CTaskScheduler::wakeWorkers(const uint32_t taskCount)
+{
+    // queuedTasks was raised before this is read, and a worker counts itself as sleeping before checking queuedTasks, so one of us sees the other
+    if (sleepingWorkers == 0u)
+        return;
+
+    // lock so a worker that just checked its wait condition can't miss this
+    {
+        std::unique_lock<std::mutex> lock(wakeMutex);
+    }
+
+    // one worker per task, anything more just wakes workers up to find nothing
+    if (taskCount >= getWorkerCount())
+    {
+        wakeCondition.notify_all();
+        return;
+    }
+
+    for (uint32_t i = 0; i < taskCount; ++i)
+        wakeCondition.notify_one();
+}
+
+void CTaskScheduler::wakeGroupWaiters(const CTaskGroup* const group)
+{
+    // only threads waiting on this group care about its new tasks
+    if (group->numWaiters == 0u)
+        return;
+
+    {
+        std::unique_lock<std::mutex> lock(wakeMutex);
+    }
+
+    // waiters on other groups share the condition, so they all get woken and go back to sleep if it wasn't theirs
+    waitCondition.notify_all();
+}
+
+void CTaskScheduler::workerThread(const uint32_t workerIdx)
+{
+    s_workerIdx = static_cast<int>(workerIdx);
+
+    while (!shutdown)
+    {
+        if (tryRunTask())
+            continue;
+
+        std::unique_lock<std::mutex> lock(wakeMutex);
+
+        sleepingWorkers++;
+        wakeCondition.wait(lock, [this]() { return shutdown || queuedTasks > 0u; });
+        sleepingWorkers--;
+    }
+}
+
+CTaskScheduler* const GetTaskScheduler()
+{
+    static CTaskScheduler s_taskScheduler(CThread::GetConCurrentThreads());
+    return &s_taskScheduler;
+}
@@ -68,75 +68,179 @@ private:
     std::atomic<bool> isDetached;
 };
 
+class CTaskGroup;
+
+// process wide pool of worker threads, each worker has its own deque of tasks.
+// workers run their own tasks newest first and steal the oldest tasks from other workers when they run out.
+// tasks can submit more tasks and wait on other groups, a waiting thread helps run the tasks of the group it's waiting on instead of blocking.
+// only helping with that group means a wait never picks up unrelated work, so the ui thread isn't held up by an export and a wait made while holding a lock can't re-enter it.
+class CTaskScheduler
+{
+public:
+    CTaskScheduler(const uint32_t workerCount);
+    ~CTaskScheduler();
+
+    CTaskScheduler(const CTaskScheduler&) = delete;
+    CTaskScheduler& operator=(const CTaskScheduler&) = delete;
+
+    void submit(CTaskGroup* const group, std::function<void()>&& func);
+    void submitBatch(CTaskGroup* const group, std::vector<std::function<void()>>& funcs);
+
+    // runs tasks from the group on the calling thread until every task in the group has finished
+    void wait(CTaskGroup* const group);
+
+    // runs a single queued task on the calling thread, only tasks from group if one is given. returns false if there was nothing to run
+    bool tryRunTask(CTaskGroup* const group = nullptr);
+
+    inline const uint32_t getWorkerCount() const { return static_cast<uint32_t>(workers.size()); };
+
+private:
+    struct Task_t
+    {
+        std::function<void()> func;
+        CTaskGroup* group;
+    };
+
+    struct Worker_t
+    {
+        std::mutex mutex;
+        std::deque<Task_t> tasks;
+    };
+
+    bool popTask(Task_t& task, const CTaskGroup* const group);
+    void pushTask(Worker_t* const worker, Task_t&& task);
+    void runTask(Task_t& task);
+    void wakeWorkers(const uint32_t taskCount);
+    void wakeGroupWaiters(const CTaskGroup* const group);
+    void workerThread(const uint32_t workerIdx);
+
+    std::vector<std::unique_ptr<Worker_t>> workers;
+    std::vector<std::thread> threads;
+
+    std::atomic<uint32_t> nextWorker; // round robin for tasks submitted from outside of the pool
+    std::atomic<uint32_t> queuedTasks; // only changed while holding the lock of the worker the task is queued on
+    std::atomic<uint32_t> sleepingWorkers; // submitting only takes wakeMutex when a worker is asleep
+    std::atomic<bool> shutdown;
+
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition; // idle workers
+    std::condition_variable waitCondition; // threads waiting on a group
+};
+
+// created on first use with a worker for every hardware thread
+CTaskScheduler* const GetTaskScheduler();
+
+// set of tasks that can be waited on or cancelled together
+class CTaskGroup
+{
+public:
+    CTaskGroup() : pendingTasks(0u), queuedTasks(0u), numWaiters(0u), cancelled(false) {};
+    ~CTaskGroup()
+    {
+        wait();
+    }
+
+    CTaskGroup(const CTaskGroup&) = delete;
+    CTaskGroup& operator=(const CTaskGroup&) = delete;
+
+    inline void run(std::function<void()>&& func) { GetTaskScheduler()->submit(this, std::move(func)); };
+    inline void runBatch(std::vector<std::function<void()>>& funcs) { GetTaskScheduler()->submitBatch(this, funcs); };
+
+    inline void wait() { GetTaskScheduler()->wait(this); };
+
+    // tasks that haven't started yet are skipped, running tasks can poll isCancelled to stop early
+    inline void cancel() { cancelled = true; };
+    inline void reset() { cancelled = false; };
+
+    inline const bool isCancelled() const { return cancelled; };
+    inline const bool isDone() const { return pendingTasks == 0u; };
+
+private:
+    friend class CTaskScheduler;
+
+    std::atomic<uint32_t> pendingTasks;
+    std::atomic<uint32_t> queuedTasks; // tasks that haven't been picked up yet
+    std::atomic<uint32_t> numWaiters; // threads asleep in wait, new tasks only wake them if there are any
+    std::atomic<bool> cancelled;
+};
+
+// runs a list of tasks on the shared task scheduler, using at most maxThreads workers at once
 class CParallelTask
 {
 public:
-    CParallelTask(const uint32_t maxThreads) : maxConcurrentThreads(maxThreads) {}
+    CParallelTask(const uint32_t maxThreads) : numTasks(0u), nextTask(0u), maxConcurrentThreads(std::max(maxThreads, 1u)) {}
 
+    // tasks have to be added before execute is called
     template <typename Function, typename... Args>
     void addTask(Function&& func, const uint32_t count, Args&&... args)
     {
+        std::unique_lock<std::mutex> lock(queueMutex);
+
         for (uint32_t i = 0; i < count; ++i)
         {
-            auto task = [func = std::forward<Function>(func), args = std::make_tuple(std::forward<Args>(args)...)]() mutable
+            tasks.emplace_back([func, args = std::make_tuple(args...)]() mutable
             {
                 std::apply(func, args);
-            };
-
-            std::unique_lock<std::mutex> lock(queueMutex);
-            tasks.push(std::move(task));
+            });
         }
+
+        numTasks = static_cast<uint32_t>(tasks.size());
     }
 
     void execute()
     {
-        for (uint32_t i = 0; i < maxConcurrentThreads; ++i)
-        {
-            threads.emplace_back([this]() { this->workerThread(); });
-        }
+        const uint32_t runnerCount = std::min(maxConcurrentThreads, static_cast<uint32_t>(tasks.size()));
+
+        // each runner claims tasks from the list until it is empty, this keeps the thread limit without a lock per task
+        std::vector<std::function<void()>> runners;
+        runners.reserve(runnerCount);
+
+        for (uint32_t i = 0; i < runnerCount; ++i)
+            runners.emplace_back([this]() { this->runTasks(); });
+
+        group.runBatch(runners);
     }
 
     void wait()
     {
-        for (auto& thread : threads)
-        {
-            thread.join();
-        }
+        group.wait();
+        group.reset();
+
+        tasks.clear();
+        numTasks = 0u;
+        nextTask = 0u;
+    }
 
-        threads.clear();
+    // tasks that haven't been started yet will not be run
+    void cancel()
+    {
+        group.cancel();
     }
 
     const uint32_t getRemainingTasks()
     {
-        std::unique_lock<std::mutex> lock(queueMutex);
-        return static_cast<uint32_t>(tasks.size());
+        return numTasks - std::min(nextTask.load(), numTasks.load());
     }
 
 private:
-    std::vector<CThread> threads;
-    std::queue<std::function<void()>> tasks;
-    std::mutex queueMutex;
-    uint32_t maxConcurrentThreads;
-
-    void workerThread()
+    void runTasks()
     {
-        while (true)
+        while (!group.isCancelled())
         {
-            std::function<void()> task;
-            {
-                std::unique_lock<std::mutex> lock(queueMutex);
-                if (!tasks.empty())
-                {
-                    task = std::move(tasks.front());
-                    tasks.pop();
-                }
-                else
-                {
-                    break;
-                }
-            }
+            const uint32_t taskIdx = nextTask++;
+            if (taskIdx >= numTasks)
+                break;
 
-            task();
+            tasks[taskIdx]();
         }
     }
-};
\ No newline at end of file
+
+    std::vector<std::function<void()>> tasks;
+    std::mutex queueMutex;
+
+    std::atomic<uint32_t> numTasks;
+    std::atomic<uint32_t> nextTask;
+    uint32_t maxConcurrentThreads;
+
+    CTaskGroup group;
+};
@@ -383,27 +383,62 @@ public:
 	std::vector<AssetLookup_t> v_assets;
 	std::map<uint32_t, AssetTypeBinding_t> m_assetTypeBindings;
 
+	// guid -> asset index kept alongside v_assets, assets should be added through AddAsset so both stay in sync
+	std::unordered_map<uint64_t, CAsset*> m_assetGuidIndex;
+	mutable std::shared_mutex m_assetIndexMutex;
+
 	// map of pak crc to status of whether the pak has already been loaded
 	std::unordered_map<uint64_t, bool> m_pakLoadStatusMap;
+	std::mutex m_pakLoadStatusMutex;
 
 	std::unordered_map<std::string, uint8_t> m_patchMasterEntries;
 
 	CAssetContainer* m_pakPatchMaster;
 
-	CAsset* const FindAssetByGUID(const uint64_t guid)
+	void AddAsset(const uint64_t guid, CAsset* const asset)
+	{
+		std::unique_lock<std::shared_mutex> lock(m_assetIndexMutex);
+
+		v_assets.push_back({ guid, asset });
+
+		// same as searching v_assets, the earlier entry with a guid is the one that gets found
+		m_assetGuidIndex.try_emplace(guid, asset);
+	}
+
+	// v_assets gets reordered by the post load sort, rebuild so duplicate guids still resolve to the first entry in v_assets.
+	// m_assetIndexMutex has to be held exclusively by the caller
+	void RebuildAssetGuidIndex()
 	{
-		const auto it = std::ranges::find(v_assets, guid, &AssetLookup_t::m_guid);
-		return it != v_assets.end()
-			? it->m_asset : nullptr;
+		m_assetGuidIndex.clear();
+		m_assetGuidIndex.reserve(v_assets.size());
+
+		for (const AssetLookup_t& lookup : v_assets)
+			m_assetGuidIndex.try_emplace(lookup.m_guid, lookup.m_asset);
+	}
+
+	CAsset* const FindAssetByGUID(const uint64_t guid) const
+	{
+		std::shared_lock<std::shared_mutex> lock(m_assetIndexMutex);
+
+		const auto it = m_assetGuidIndex.find(guid);
+		return it != m_assetGuidIndex.end()
+			? it->second : nullptr;
 	}
 
 	template<typename T>
-	T* const FindAssetByGUID(const uint64_t guid)
+	T* const FindAssetByGUID(const uint64_t guid) const
 	{
-		const auto it = std::ranges::find(v_assets, guid, &AssetLookup_t::m_guid);
-		return it != v_assets.end()
-			&& it->m_asset->GetAssetContainerType() == CAsset::ContainerType::PAK
-			? static_cast<T*>(it->m_asset) : nullptr;
+		CAsset* const asset = FindAssetByGUID(guid);
+		return asset
+			&& asset->GetAssetContainerType() == CAsset::ContainerType::PAK
+			? static_cast<T*>(asset) : nullptr;
+	}
+
+	// records a pak crc as loaded, returns false if it was already recorded. paks can be loaded in parallel so this locks
+	bool ClaimPakLoad(const uint64_t crc)
+	{
+		std::lock_guard<std::mutex> lock(m_pakLoadStatusMutex);
+		return m_pakLoadStatusMap.emplace(crc, true).second;
 	}
 
 	void ClearAssetData()
@@ -415,6 +450,8 @@ public:
 		v_assets.clear();
 		v_assets.shrink_to_fit();
 
+		m_assetGuidIndex.clear();
+
 		for (CAssetContainer* container : v_assetContainers)
 		{
 			delete container;
@@ -143,7 +143,7 @@ const bool CMilesAudioBank::ParseFromHeader()
 
 			sourceAsset->SetContainerName(GetStreamingFileNameForSource(sourceAssetData));
 
-			g_assetData.v_assets.push_back({ sourceAsset->GetAssetGUID(), sourceAsset });
+			g_assetData.AddAsset(sourceAsset->GetAssetGUID(), sourceAsset);
 		}
 		break;
 	}
@@ -185,7 +185,7 @@ const bool CMilesAudioBank::ParseFromHeader()
 
 			sourceAsset->SetContainerName(GetStreamingFileNameForSource(sourceAssetData));
 
-			g_assetData.v_assets.push_back({ sourceAsset->GetAssetGUID(), sourceAsset });
+			g_assetData.AddAsset(sourceAsset->GetAssetGUID(), sourceAsset);
 		}
 
 		break;
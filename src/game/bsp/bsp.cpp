@@ -5,6 +5,7 @@
 #include <core/render/dx.h>
 #include <game/rtech/assets/material.h>
 #include <game/rtech/assets/texture.h>
+#include <core/utils/textwriter.h>
 
 extern CDXParentHandler* g_dxHandler;
 extern std::unique_ptr<char[]> GetWrapAssetData(CAsset* const asset, uint64_t* outSize);
@@ -536,21 +537,26 @@ CDXDrawData* CBSPData::ConstructPreviewData()
 }
 
 // very temp
-void CBSPData::Export(std::ofstream* out)
+void CBSPData::Export(CTextWriter* out)
 {
-	UNUSED(out);
 	const float3* positionsLump = reinterpret_cast<float3*>(GetLumpData(LUMP_VERTEXES).get());
 	const float3* normalsLump = reinterpret_cast<float3*>(GetLumpData(LUMP_VERTNORMALS).get());
 	const uint16_t* indicesLump = reinterpret_cast<uint16_t*>(GetLumpData(LUMP_MESH_INDICES).get());
 
 	for (int i = 0; i < l.numVertPositions; ++i)
 	{
-		*out << (std::format("v {} {} {}\n", positionsLump[i].x, positionsLump[i].y, positionsLump[i].z));
+		*out << "v ";
+		out->WriteShortest(positionsLump[i].x) << " ";
+		out->WriteShortest(positionsLump[i].y) << " ";
+		out->WriteShortest(positionsLump[i].z) << "\n";
 	}
 
 	for (int i = 0; i < l.numVertNormals; ++i)
 	{
-		*out << (std::format("vn {} {} {}\n", normalsLump[i].x, normalsLump[i].y, normalsLump[i].z));
+		*out << "vn ";
+		out->WriteShortest(normalsLump[i].x) << " ";
+		out->WriteShortest(normalsLump[i].y) << " ";
+		out->WriteShortest(normalsLump[i].z) << "\n";
 	}
 
 	//for (int i = LUMP_VERTS_UNLIT; i <= LUMP_VERTS_UNLIT_TS; ++i)
@@ -564,46 +570,48 @@ void CBSPData::Export(std::ofstream* out)
 
 	//}
 
+	// looking these up copies a shared_ptr, so only do it once instead of for every vertex
+	const std::shared_ptr<char[]> modelsLump = GetLumpData(LUMP_MODELS);
+	const std::shared_ptr<char[]> meshesLump = GetLumpData(LUMP_MESHES);
+	const std::shared_ptr<char[]> materialSortLump = GetLumpData(LUMP_MATERIAL_SORT);
+
 	for (int i = 0; i < l.numModels; ++i)
 	{
-		dmodel_t* model = &reinterpret_cast<dmodel_t*>(GetLumpData(LUMP_MODELS).get())[i];
+		dmodel_t* model = &reinterpret_cast<dmodel_t*>(modelsLump.get())[i];
 
 		for (int j = model->firstMesh; j < (model->firstMesh + model->meshCount); ++j)
 		{
-			dmesh_t* mesh = &reinterpret_cast<dmesh_t*>(GetLumpData(LUMP_MESHES).get())[j];
+			dmesh_t* mesh = &reinterpret_cast<dmesh_t*>(meshesLump.get())[j];
 
 			if (mesh->triCount <= 0)
 				continue;
 
-			const dmaterialsort_t* mtlSort = &reinterpret_cast<dmaterialsort_t*>(GetLumpData(LUMP_MATERIAL_SORT).get())[mesh->mtlSortIdx];
+			const dmaterialsort_t* mtlSort = &reinterpret_cast<dmaterialsort_t*>(materialSortLump.get())[mesh->mtlSortIdx];
 			
 			const int meshVertType = mesh->flags & 0x600;
 			const int meshVertLumpId = GetVertexLumpIdByMeshFlag(meshVertType);
 
 			const UINT vertexStride = GetVertexStrideByLumpId(meshVertLumpId);
+			const std::shared_ptr<char[]> vertexLump = GetLumpData(meshVertLumpId);
 
-			std::string faceString = "";
+			// every face starts on a new line, so the last face of a mesh has no line ending
 			int vertWriteIndex = 0;
 			for (int k = mesh->firstIdx; k < mesh->firstIdx + (mesh->triCount * 3); ++k)
 			{
 				const int index = indicesLump[k] + mtlSort->firstVertex;
 
-				const uint32_t* vertPointer = reinterpret_cast<uint32_t*>(GetLumpData(meshVertLumpId).get() + (vertexStride * index));
+				const uint32_t* vertPointer = reinterpret_cast<uint32_t*>(vertexLump.get() + (vertexStride * index));
 
 				const uint32_t posIdx = vertPointer[0];
 				const uint32_t nmlIdx = vertPointer[1];
 
 				if ((vertWriteIndex % 3) == 0)
-				{
-					*out << (faceString) << "\n";
-					faceString = "f";
-				}
+					*out << "\nf";
 
-				faceString += std::format(" {}//{}", posIdx + 1, nmlIdx + 1);
+				*out << " " << (posIdx + 1) << "//" << (nmlIdx + 1);
 
 				vertWriteIndex++;
 			}
-			*out << (faceString);
 		}
 	}
 }
\ No newline at end of file
@@ -78,6 +78,7 @@ struct dmesh_t
 };
 
 class CPakAsset;
+class CTextWriter;
 class CDXDrawData;
 struct ID3D11ShaderResourceView;
 struct ID3D11Buffer;
@@ -96,7 +97,7 @@ public:
 
 	CDXDrawData* ConstructPreviewData();
 
-	void Export(std::ofstream* out);
+	void Export(CTextWriter* out);
 
 	const std::shared_ptr<char[]> GetLumpData(int lumpId) const
 	{
@@ -731,19 +731,21 @@ bool ExportSourceModelAsset(CAsset* const asset, const int setting)
     exportPath.append(std::format("{}.mdl", modelStem));    
 
     const ModelParsedData_t* const parsedData = srcMdlAsset->GetParsedData();
+    const uint8_t lodMask = GetModelLODMask(g_ExportSettings.exportModelLodSetting, parsedData->lods.size());
+
     switch (settingFixup)
     {
     case eModelExportSetting::MODEL_CAST:
     {
-        return ExportModelCast(parsedData, exportPath, asset->GetAssetGUID());
+        return ExportModelCast(parsedData, lodMask, exportPath, asset->GetAssetGUID());
     }
     case eModelExportSetting::MODEL_RMAX:
     {
-        return ExportModelRMAX(parsedData, exportPath);
+        return ExportModelRMAX(parsedData, lodMask, exportPath);
     }
     case eModelExportSetting::MODEL_SMD:
     {
-        return ExportModelSMD(parsedData, exportPath);
+        return ExportModelSMD(parsedData, lodMask, exportPath);
     }
     default:
     {
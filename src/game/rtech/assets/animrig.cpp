@@ -1,5 +1,6 @@
 #include <pch.h>
 #include <game/rtech/assets/rson.h>
+#include <core/utils/textwriter.h>
 #include <game/rtech/assets/animrig.h>
 #include <game/rtech/assets/animseq.h>
 
@@ -150,9 +151,9 @@ static bool ExportRawAnimRigAsset(CPakAsset* const asset, const AnimRigAsset* co
     // make a manifest of this assets dependencies
     exportPath.replace_extension(".rson");
 
-    StreamIO depOut(exportPath.string(), eStreamIOMode::Write);
-    WriteRSONDependencyArray(*depOut.W(), "seqs", animRigAsset->animSeqs, animRigAsset->numAnimSeqs);
-    depOut.close();
+    CTextWriter depOut(exportPath);
+    WriteRSONDependencyArray(depOut, "seqs", animRigAsset->animSeqs, animRigAsset->numAnimSeqs);
+    depOut.Close();
 
     return true;
 }
@@ -221,15 +222,17 @@ bool ExportAnimRigAsset(CAsset* const asset, const int setting)
 
     exportPath.append(std::format("{}.rrig", rigStem));
 
+    const uint8_t lodMask = GetModelLODMask(g_ExportSettings.exportModelLodSetting, parsedData->lods.size());
+
     switch (setting)
     {
     case eAnimRigExportSetting::ANIMRIG_CAST:
     {
-        return ExportModelCast(parsedData, exportPath, asset->GetAssetGUID());
+        return ExportModelCast(parsedData, lodMask, exportPath, asset->GetAssetGUID());
     }
     case eAnimRigExportSetting::ANIMRIG_RMAX:
     {
-        return ExportModelRMAX(parsedData, exportPath);
+        return ExportModelRMAX(parsedData, lodMask, exportPath);
     }
     case eAnimRigExportSetting::ANIMRIG_RRIG:
     {
@@ -237,7 +240,7 @@ bool ExportAnimRigAsset(CAsset* const asset, const int setting)
     }
     case eAnimRigExportSetting::ANIMRIG_SMD:
     {
-        return ExportModelSMD(parsedData, exportPath);
+        return ExportModelSMD(parsedData, lodMask, exportPath);
     }
     default:
     {
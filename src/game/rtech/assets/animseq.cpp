@@ -233,8 +233,14 @@ bool ExportAnimSeqFromAsset(const std::filesystem::path& exportPath, const std::
 			return false;
 		}
 
-		std::atomic<uint32_t> remainingSeqs = 0; // we don't actually need thread safe here
+		const int exportSetting = aseqAssetBinding->second.e.exportSetting;
+
+		std::atomic<uint32_t> remainingSeqs = 0;
 		const ProgressBarEvent_t* const seqExportProgress = g_pImGuiHandler->AddProgressBarEvent("Exporting Sequences..", static_cast<uint32_t>(numAnimSeqs), &remainingSeqs, true);
+
+		// rigs can have thousands of sequences, hand them to the shared pool so idle export threads can pick them up
+		CExportOutputRecorder* const outputRecorder = GetExportOutputRecorder();
+		CTaskGroup seqTasks;
 		for (int i = 0; i < numAnimSeqs; i++)
 		{
 			const uint64_t guid = animSeqs[i].guid;
@@ -256,10 +262,17 @@ bool ExportAnimSeqFromAsset(const std::filesystem::path& exportPath, const std::
 
 			outputPath.replace_filename(std::filesystem::path(animSeqAsset->name).filename());
 
-			ExportAnimSeqAsset(animSeq, aseqAssetBinding->second.e.exportSetting, animSeqAsset, outputPath, name, bones);
+			seqTasks.run([animSeq, exportSetting, animSeqAsset, seqPath = outputPath, name, bones, outputRecorder, &remainingSeqs]()
+				{
+					const CExportOutputScope outputScope(outputRecorder);
+					ExportAnimSeqAsset(animSeq, exportSetting, animSeqAsset, seqPath, name, bones);
 
-			++remainingSeqs;
+					++remainingSeqs;
+				});
 		}
+
+		// this thread helps with the sequences while it waits
+		seqTasks.wait();
 		g_pImGuiHandler->FinishProgressBarEvent(seqExportProgress);
 	}
 
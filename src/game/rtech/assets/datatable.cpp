@@ -1,5 +1,6 @@
 #include <pch.h>
 #include <game/rtech/assets/datatable.h>
+#include <core/utils/textwriter.h>
 #include <thirdparty/imgui/imgui.h>
 
 void LoadDatatableAsset(CAssetContainer* const pak, CAsset* const asset)
@@ -154,8 +155,7 @@ bool ExportCSVDatatableAsset(CPakAsset* const asset, const DatatableAsset* const
 
     exportPath.replace_extension(".csv");
 
-    StreamIO outFile(exportPath.string(), eStreamIOMode::Write);
-    std::ofstream& out = *outFile.W();
+    CTextWriter out(exportPath);
 
     // set up the header row
     for (int i = 0; i < dtblAsset->numColumns; i++)
@@ -178,7 +178,7 @@ bool ExportCSVDatatableAsset(CPakAsset* const asset, const DatatableAsset* const
             case DatatableColumType_t::Bool:
             {
                 const bool& data = *reinterpret_cast<const bool* const>(row + column->rowOffset);
-                out << (data ? "true" : "false");
+                out.WriteBool(data);
 
                 break;
             }
@@ -241,7 +241,7 @@ bool ExportCSVDatatableAsset(CPakAsset* const asset, const DatatableAsset* const
         out << (i == (dtblAsset->numColumns - 1) ? "" : ",");
     }
 
-    outFile.close();
+    out.Close();
 
     return true;
 }
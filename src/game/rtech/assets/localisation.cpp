@@ -1,6 +1,7 @@
 #include <pch.h>
 #include <game/rtech/assets/localisation.h>
 #include <game/rtech/cpakfile.h>
+#include <core/utils/textwriter.h>
 
 extern ExportSettings_t g_ExportSettings;
 
@@ -21,7 +22,8 @@ void LoadLocalisationAsset(CAssetContainer* pak, CAsset* asset)
 
 std::string EscapeLocalisationString(const std::string& str)
 {
-    std::stringstream outStream;
+    std::string outString;
+    outString.reserve(str.length());
 
     for (int i = 0; i < str.length(); ++i)
     {
@@ -44,7 +46,7 @@ std::string EscapeLocalisationString(const std::string& str)
 
             for (int j = 0; j < numBytes; ++j)
             {
-                outStream << str.at(i + j);
+                outString.push_back(str.at(i + j));
             }
 
             // add numBytes-1 to the char index
@@ -58,32 +60,37 @@ std::string EscapeLocalisationString(const std::string& str)
         case '\0':
             break;
         case '\t':
-            outStream << "\\t";
+            outString.append("\\t");
             break;
         case '\n':
-            outStream << "\\n";
+            outString.append("\\n");
             break;
         case '\r':
-            outStream << "\\r";
+            outString.append("\\r");
         case '\"':
-            outStream << "\\\"";
+            outString.append("\\\"");
             break;
         default:
         {
             if (!std::isprint(c))
             {
                 Log("non printable char @ %i/%lld\n", i, str.length());
-                outStream << std::hex << std::setfill('0') << std::setw(2) << "\\x" << (int)c;
+
+                char hexChars[2] = {};
+                const std::to_chars_result result = std::to_chars(hexChars, hexChars + sizeof(hexChars), static_cast<int>(c), 16);
+
+                outString.append("\\x");
+                outString.append(hexChars, result.ptr);
             }
             else
-                outStream << c;
+                outString.push_back(c);
 
             break;
         }
         }
     }
 
-    return outStream.str();
+    return outString;
 }
 
 static const char* const s_PathPrefixLOCL = s_AssetTypePaths.find(AssetType_t::LOCL)->second;
@@ -114,7 +121,7 @@ bool ExportLocalisationAsset(CAsset* const asset, const int setting)
     exportPath.append(loclAsset->fileName); // likely quicker than "exportPath.append(localizationPath.stem().string());"
     exportPath.replace_extension(".locl");
 
-    std::ofstream ofs(exportPath, std::ios::out | std::ios::binary);
+    CTextWriter ofs(exportPath);
 
     ofs << "\"" << loclAsset->fileName << "\"\n{\n";
 
@@ -134,12 +141,13 @@ bool ExportLocalisationAsset(CAsset* const asset, const int setting)
         // windows utf-16 support sucks so convert to multibyte utf8
         WideCharToMultiByte(CP_UTF8, 0, wideString.c_str(), static_cast<int>(wideString.length()), &multiByteString[0], static_cast<int>(multiByteString.length()), (LPCCH)NULL, NULL);
 
-        ofs << "\t\"" << std::hex << entry->hash << "\" \"" << EscapeLocalisationString(multiByteString).c_str() << "\"\n"; // use the .c_str() function here now so it gets null terminated properly (if there's extra data or it's cut off, there will no longer be a [NUL] character in the file.
+        ofs << "\t\"";
+        ofs.WriteHex(entry->hash) << "\" \"" << EscapeLocalisationString(multiByteString).c_str() << "\"\n"; // use the .c_str() function here now so it gets null terminated properly (if there's extra data or it's cut off, there will no longer be a [NUL] character in the file.
     }
 
     ofs << "}";
 
-    ofs.close();
+    ofs.Close();
 
     return true;
 }
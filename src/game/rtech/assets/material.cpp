@@ -975,6 +975,7 @@ bool ExportMaterialStruct(const MaterialAsset* const materialAsset,
 
     exportPath.replace_extension(".json");
     std::ofstream ofs(exportPath, std::ios::out);
+    RecordExportOutput(exportPath);
 
     // [rika]: some material names (notably r2 materials) use '\\' instead of '/'
     std::string materialName(materialAsset->name);
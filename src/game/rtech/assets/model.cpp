@@ -4,6 +4,7 @@
 #include <game/rtech/assets/texture.h>
 #include <game/rtech/assets/material.h>
 #include <game/rtech/assets/rson.h>
+#include <core/utils/textwriter.h>
 #include <game/rtech/assets/animseq.h>
 #include <game/rtech/utils/bvh/bvh.h>
 #include <game/rtech/utils/bsp/bspflags.h>
@@ -18,7 +19,17 @@ extern CDXParentHandler* g_dxHandler;
 extern CBufferManager g_BufferManager;
 extern ExportSettings_t g_ExportSettings;
 
-static void ParseModelVertexData_v8(CPakAsset* const asset, ModelAsset* const modelAsset)
+// marks the lods picked by lodSetting as parsed, returns the ones that still need parsing
+// must be called with the model's vertexDataMutex held
+static uint8_t ClaimModelLODs(ModelAsset* const modelAsset, const uint32_t lodSetting, const size_t lodCount)
+{
+    const uint8_t lodMask = GetModelLODMask(lodSetting, lodCount) & ~modelAsset->vertexDataLodMask;
+    modelAsset->vertexDataLodMask |= lodMask;
+
+    return lodMask;
+}
+
+static void ParseModelVertexData_v8(CPakAsset* const asset, ModelAsset* const modelAsset, const uint32_t lodSetting)
 {
     UNUSED(asset);
     char* const pDataBuffer = modelAsset->vertDataPermanent;
@@ -51,6 +62,10 @@ static void ParseModelVertexData_v8(CPakAsset* const asset, ModelAsset* const mo
     if (pVVC && (pVVC->id != MODEL_VERTEX_COLOR_FILE_ID))
         return;
 
+    const uint8_t lodMask = ClaimModelLODs(modelAsset, lodSetting, pVTX->numLODs);
+    if (!lodMask)
+        return;
+
     ModelParsedData_t* const parsedData = modelAsset->GetParsedData();
 
     parsedData->lods.resize(pVTX->numLODs);
@@ -69,6 +84,9 @@ static void ParseModelVertexData_v8(CPakAsset* const asset, ModelAsset* const mo
 
     for (int lodIdx = 0; lodIdx < pVTX->numLODs; lodIdx++)
     {
+        if (!(lodMask & (1 << lodIdx)))
+            continue;
+
         int lodMeshCount = 0;
 
         ModelLODData_t& lodData = parsedData->lods.at(lodIdx);
@@ -217,7 +235,7 @@ static void ParseModelVertexData_v8(CPakAsset* const asset, ModelAsset* const mo
 
 const uint8_t s_VertexDataBaseBoneMap[8] = { 0, 1, 2, 3, 4, 5, 6, 7 };
 
-static void ParseModelVertexData_v9(CPakAsset* const asset, ModelAsset* const modelAsset)
+static void ParseModelVertexData_v9(CPakAsset* const asset, ModelAsset* const modelAsset, const uint32_t lodSetting)
 {
     const std::unique_ptr<char[]> pStreamed = modelAsset->vertDataStreamed.size > 0 ? asset->getStarPakData(modelAsset->vertDataStreamed.offset, modelAsset->vertDataStreamed.size, false) : nullptr; // probably smarter to check the size inside getStarPakData but whatever!
     char* const pDataBuffer = pStreamed.get() ? pStreamed.get() : modelAsset->vertDataPermanent;
@@ -235,6 +253,11 @@ static void ParseModelVertexData_v9(CPakAsset* const asset, ModelAsset* const mo
     if (vgHdr->lodCount == 0)
         return;
 
+    // [rika]: all lods share one buffer here, so this only saves parsing
+    const uint8_t lodMask = ClaimModelLODs(modelAsset, lodSetting, vgHdr->lodCount);
+    if (!lodMask)
+        return;
+
     ModelParsedData_t* const parsedData = modelAsset->GetParsedData();
 
     parsedData->studiohdr.hwDataSize = vgHdr->dataSize; // [rika]: set here, makes things easier. if we use the value from ModelAssetHeader it will be aligned 4096, making it slightly oversized.
@@ -258,12 +281,15 @@ static void ParseModelVertexData_v9(CPakAsset* const asset, ModelAsset* const mo
     const r5::studiohdr_v8_t* const pStudioHdr = reinterpret_cast<r5::studiohdr_v8_t*>(modelAsset->data);
 
     parsedData->bodyParts.resize(pStudioHdr->numbodyparts);
-    parsedData->meshVertexData.resize(vgHdr->meshCount);
+    parsedData->meshVertexData.resize(parsedData->meshVertexData.size() + vgHdr->meshCount);
 
     const uint8_t* boneMap = vgHdr->boneStateChangeCount ? vgHdr->pBoneMap() : s_VertexDataBaseBoneMap; // does this model have remapped bones? use default map if not
 
     for (int lodLevel = 0; lodLevel < vgHdr->lodCount; lodLevel++)
     {
+        if (!(lodMask & (1 << lodLevel)))
+            continue;
+
         int lodMeshCount = 0;
 
         ModelLODData_t& lodData = parsedData->lods.at(lodLevel);
@@ -376,12 +402,9 @@ static void ParseModelVertexData_v9(CPakAsset* const asset, ModelAsset* const mo
     parsedData->meshVertexData.shrink();
 }
 
-static void ParseModelVertexData_v12_1(CPakAsset* const asset, ModelAsset* const modelAsset)
+static void ParseModelVertexData_v12_1(CPakAsset* const asset, ModelAsset* const modelAsset, const uint32_t lodSetting)
 {
-    const std::unique_ptr<char[]> pStreamed = asset->getStarPakData(modelAsset->vertDataStreamed.offset, modelAsset->vertDataStreamed.size, false);
-    char* const pDataBuffer = pStreamed.get();
-
-    if (!pDataBuffer)
+    if (!asset->getStarPak(false) || modelAsset->vertDataStreamed.size == 0)
     {
         Log("%s loaded with no vertex data\n", modelAsset->name);
         return;
@@ -391,6 +414,10 @@ static void ParseModelVertexData_v12_1(CPakAsset* const asset, ModelAsset* const
 
     const r5::studiohdr_v12_1_t* const pStudioHdr = reinterpret_cast<r5::studiohdr_v12_1_t*>(modelAsset->data);
 
+    const uint8_t lodMask = ClaimModelLODs(modelAsset, lodSetting, pStudioHdr->lodCount);
+    if (!lodMask)
+        return;
+
     const uint8_t* boneMap = pStudioHdr->boneStateCount ? pStudioHdr->pBoneStates() : s_VertexDataBaseBoneMap; // does this model have remapped bones? use default map if not
 
     parsedData->lods.resize(pStudioHdr->lodCount);
@@ -402,7 +429,15 @@ static void ParseModelVertexData_v12_1(CPakAsset* const asset, ModelAsset* const
     {
         const r5::studio_hw_groupdata_v12_1_t* group = pStudioHdr->pLODGroup(groupIdx);
 
-        const vg::rev2::VertexGroupHeader_t* grouphdr = reinterpret_cast<const vg::rev2::VertexGroupHeader_t*>(pDataBuffer + group->dataOffset);
+        // groups that only hold lods we don't want are never read from the starpak
+        if (!(group->lodMap & lodMask))
+            continue;
+
+        const AssetDataView_t groupData = asset->getStarPakView(modelAsset->vertDataStreamed.offset + group->dataOffset, group->dataSize, false);
+        if (!groupData.IsValid())
+            continue;
+
+        const vg::rev2::VertexGroupHeader_t* grouphdr = reinterpret_cast<const vg::rev2::VertexGroupHeader_t*>(groupData.data);
 
         uint8_t lodIdx = 0;
         for (uint16_t lodLevel = 0; lodLevel < pStudioHdr->lodCount; lodLevel++)
@@ -414,6 +449,12 @@ static void ParseModelVertexData_v12_1(CPakAsset* const asset, ModelAsset* const
             if (!(grouphdr->lodMap & (1 << lodLevel)))
                 continue;
 
+            if (!(lodMask & (1 << lodLevel)))
+            {
+                lodIdx++;
+                continue;
+            }
+
             assert(static_cast<uint8_t>(lodIdx) < grouphdr->lodCount);
 
             const vg::rev2::ModelLODHeader_t* lod = grouphdr->pLod(lodIdx);
@@ -537,12 +578,9 @@ static void ParseModelVertexData_v12_1(CPakAsset* const asset, ModelAsset* const
     parsedData->meshVertexData.shrink();
 }
 
-static void ParseModelVertexData_v14(CPakAsset* const asset, ModelAsset* const modelAsset)
+static void ParseModelVertexData_v14(CPakAsset* const asset, ModelAsset* const modelAsset, const uint32_t lodSetting)
 {
-    const std::unique_ptr<char[]> pStreamed = asset->getStarPakData(modelAsset->vertDataStreamed.offset, modelAsset->vertDataStreamed.size, false);
-    char* const pDataBuffer = pStreamed.get();
-
-    if (!pDataBuffer)
+    if (!asset->getStarPak(false) || modelAsset->vertDataStreamed.size == 0)
     {
         Log("%s loaded with no vertex data\n", modelAsset->name);
         return;
@@ -552,6 +590,10 @@ static void ParseModelVertexData_v14(CPakAsset* const asset, ModelAsset* const m
 
     const r5::studiohdr_v14_t* const pStudioHdr = reinterpret_cast<r5::studiohdr_v14_t*>(modelAsset->data);
 
+    const uint8_t lodMask = ClaimModelLODs(modelAsset, lodSetting, pStudioHdr->lodCount);
+    if (!lodMask)
+        return;
+
     const uint8_t* boneMap = pStudioHdr->boneStateCount ? pStudioHdr->pBoneStates() : s_VertexDataBaseBoneMap; // does this model have remapped bones? use default map if not
 
     parsedData->lods.resize(pStudioHdr->lodCount);
@@ -563,7 +605,15 @@ static void ParseModelVertexData_v14(CPakAsset* const asset, ModelAsset* const m
     {
         const r5::studio_hw_groupdata_v12_1_t* group = pStudioHdr->pLODGroup(groupIdx);
 
-        const vg::rev3::VertexGroupHeader_t* grouphdr = reinterpret_cast<const vg::rev3::VertexGroupHeader_t*>(pDataBuffer + group->dataOffset);
+        // groups that only hold lods we don't want are never read from the starpak
+        if (!(group->lodMap & lodMask))
+            continue;
+
+        const AssetDataView_t groupData = asset->getStarPakView(modelAsset->vertDataStreamed.offset + group->dataOffset, group->dataSize, false);
+        if (!groupData.IsValid())
+            continue;
+
+        const vg::rev3::VertexGroupHeader_t* grouphdr = reinterpret_cast<const vg::rev3::VertexGroupHeader_t*>(groupData.data);
 
         uint8_t lodIdx = 0;
         for (uint16_t lodLevel = 0; lodLevel < pStudioHdr->lodCount; lodLevel++)
@@ -575,6 +625,12 @@ static void ParseModelVertexData_v14(CPakAsset* const asset, ModelAsset* const m
             if (!(grouphdr->lodMap & (1 << lodLevel)))
                 continue;
 
+            if (!(lodMask & (1 << lodLevel)))
+            {
+                lodIdx++;
+                continue;
+            }
+
             assert(static_cast<uint8_t>(lodIdx) < grouphdr->lodCount);
 
             const vg::rev3::ModelLODHeader_t* lod = grouphdr->pLod(lodIdx);
@@ -699,12 +755,9 @@ static void ParseModelVertexData_v14(CPakAsset* const asset, ModelAsset* const m
     parsedData->meshVertexData.shrink();
 }
 
-static void ParseModelVertexData_v16(CPakAsset* const asset, ModelAsset* const modelAsset)
+static void ParseModelVertexData_v16(CPakAsset* const asset, ModelAsset* const modelAsset, const uint32_t lodSetting)
 {
-    const std::unique_ptr<char[]> pStreamed = asset->getStarPakData(modelAsset->vertDataStreamed.offset, modelAsset->vertDataStreamed.size, false);
-    char* const pDataBuffer = pStreamed.get();
-
-    if (!pDataBuffer)
+    if (!asset->getStarPak(false) || modelAsset->vertDataStreamed.size == 0)
     {
         Log("%s loaded with no vertex data\n", modelAsset->name);
         return;
@@ -714,6 +767,10 @@ static void ParseModelVertexData_v16(CPakAsset* const asset, ModelAsset* const m
 
     const r5::studiohdr_v16_t* const pStudioHdr = reinterpret_cast<r5::studiohdr_v16_t*>(modelAsset->data);
 
+    const uint8_t lodMask = ClaimModelLODs(modelAsset, lodSetting, pStudioHdr->lodCount);
+    if (!lodMask)
+        return;
+
     const uint8_t* boneMap = pStudioHdr->boneStateCount ? pStudioHdr->pBoneStates() : s_VertexDataBaseBoneMap; // does this model have remapped bones? use default map if not
 
     parsedData->lods.resize(pStudioHdr->lodCount);
@@ -725,6 +782,10 @@ static void ParseModelVertexData_v16(CPakAsset* const asset, ModelAsset* const m
     {
         const r5::studio_hw_groupdata_v16_t* group = pStudioHdr->pLODGroup(groupIdx);
 
+        // groups that only hold lods we don't want are never read from the starpak or decompressed
+        if (!(group->lodMap & lodMask))
+            continue;
+
         std::unique_ptr<char[]> dcmpBuf = nullptr;
 
         // decompress buffer
@@ -732,19 +793,19 @@ static void ParseModelVertexData_v16(CPakAsset* const asset, ModelAsset* const m
         {
         case eCompressionType::NONE:
         {
-            dcmpBuf = std::make_unique<char[]>(group->dataSizeDecompressed);
-            std::memcpy(dcmpBuf.get(), pStreamed.get() + group->dataOffset, group->dataSizeDecompressed);
+            dcmpBuf = asset->getStarPakData(modelAsset->vertDataStreamed.offset + group->dataOffset, group->dataSizeDecompressed, false);
             break;
         }
         case eCompressionType::PAKFILE:
         case eCompressionType::SNOWFLAKE:
         case eCompressionType::OODLE:
         {
-            std::unique_ptr<char[]> cmpBuf = std::make_unique<char[]>(group->dataSizeCompressed);
-            std::memcpy(cmpBuf.get(), pStreamed.get() + group->dataOffset, group->dataSizeCompressed);
+            const AssetDataView_t cmpData = asset->getStarPakView(modelAsset->vertDataStreamed.offset + group->dataOffset, group->dataSizeCompressed, false);
+            if (!cmpData.IsValid())
+                break;
 
             uint64_t dataSizeDecompressed = group->dataSizeDecompressed; // this is cringe, can't  be const either, so awesome
-            dcmpBuf = RTech::DecompressStreamedBuffer(std::move(cmpBuf), dataSizeDecompressed, group->dataCompression);
+            dcmpBuf = RTech::DecompressStreamedBuffer(cmpData.data, dataSizeDecompressed, group->dataCompression);
 
             break;
         }
@@ -752,6 +813,9 @@ static void ParseModelVertexData_v16(CPakAsset* const asset, ModelAsset* const m
             break;
         }
 
+        if (!dcmpBuf)
+            continue;
+
         const vg::rev4::VertexGroupHeader_t* grouphdr = reinterpret_cast<vg::rev4::VertexGroupHeader_t*>(dcmpBuf.get());
 
         uint8_t lodIdx = 0;
@@ -764,6 +828,12 @@ static void ParseModelVertexData_v16(CPakAsset* const asset, ModelAsset* const m
             if (!(grouphdr->lodMap & (1 << lodLevel)))
                 continue;
 
+            if (!(lodMask & (1 << lodLevel)))
+            {
+                lodIdx++;
+                continue;
+            }
+
             assert(static_cast<uint8_t>(lodIdx) < grouphdr->lodCount);
 
             const vg::rev4::ModelLODHeader_t* lod = grouphdr->pLod(lodIdx);
@@ -941,6 +1011,75 @@ static void ParseModelTextureData_v16(ModelParsedData_t* const parsedData)
         parsedData->skins.emplace_back(pStudioHdr->pSkinName_V16(i), pStudioHdr->pSkinFamily(i));
 }
 
+// parses the model's geometry the first time it's needed, models that are never previewed or exported never touch their vertex data
+// only the lods picked by lodSetting are parsed, later calls asking for more lods parse the missing ones
+// safe to call from multiple threads, callers wait for any parse in progress to finish.
+// returns a shared lock on the parsed data, keep it for as long as the geometry is being read: parsing more lods can reallocate meshes and vertex data
+[[nodiscard]] static std::shared_lock<std::shared_mutex> ParseModelVertexData(CPakAsset* const asset, ModelAsset* const modelAsset, const uint32_t lodSetting)
+{
+    std::unique_lock<std::shared_mutex> lock(modelAsset->vertexDataMutex);
+
+    switch (modelAsset->version)
+    {
+    case eMDLVersion::VERSION_8:
+    {
+        ParseModelVertexData_v8(asset, modelAsset, lodSetting);
+        break;
+    }
+    case eMDLVersion::VERSION_9:
+    case eMDLVersion::VERSION_10:
+    case eMDLVersion::VERSION_11:
+    case eMDLVersion::VERSION_12:
+    {
+        ParseModelVertexData_v9(asset, modelAsset, lodSetting);
+        break;
+    }
+    case eMDLVersion::VERSION_12_1:
+    case eMDLVersion::VERSION_12_2:
+    case eMDLVersion::VERSION_12_3:
+    case eMDLVersion::VERSION_12_4:
+    case eMDLVersion::VERSION_12_5:
+    case eMDLVersion::VERSION_13:
+    case eMDLVersion::VERSION_13_1:
+    {
+        ParseModelVertexData_v12_1(asset, modelAsset, lodSetting);
+        break;
+    }
+    case eMDLVersion::VERSION_14:
+    case eMDLVersion::VERSION_14_1:
+    case eMDLVersion::VERSION_15:
+    {
+        ParseModelVertexData_v14(asset, modelAsset, lodSetting);
+        break;
+    }
+    case eMDLVersion::VERSION_16:
+    case eMDLVersion::VERSION_17:
+    case eMDLVersion::VERSION_18:
+    case eMDLVersion::VERSION_19:
+    {
+        ParseModelVertexData_v16(asset, modelAsset, lodSetting);
+        break;
+    }
+    default:
+    {
+        assertm(false, "unaccounted asset version, will cause major issues!");
+        break;
+    }
+    }
+
+    // the lods we asked for stay parsed, so nothing is lost between dropping the exclusive lock and taking the shared one
+    lock.unlock();
+
+    return std::shared_lock<std::shared_mutex>(modelAsset->vertexDataMutex);
+}
+
+// lods picked by lodSetting that have actually been parsed, the lowest lod depends on the lod count so this needs the vertex data parsed first
+// must be called with the model's vertexDataMutex held
+static uint8_t GetParsedModelLODMask(ModelAsset* const modelAsset, const uint32_t lodSetting)
+{
+    return GetModelLODMask(lodSetting, modelAsset->GetParsedData()->lods.size()) & modelAsset->vertexDataLodMask;
+}
+
 void LoadModelAsset(CAssetContainer* const pak, CAsset* const asset)
 {
     UNUSED(pak);
@@ -961,7 +1100,6 @@ void LoadModelAsset(CAssetContainer* const pak, CAsset* const asset)
         ParseModelBoneData_v8(mdlAsset->GetParsedData());
         ParseModelAttachmentData_v8(mdlAsset->GetParsedData());
         ParseModelTextureData_v8(mdlAsset->GetParsedData());
-        ParseModelVertexData_v8(pakAsset, mdlAsset);
         ParseModelSequenceData_NoStall(mdlAsset->GetParsedData(), reinterpret_cast<char* const>(mdlAsset->data));
         break;
     }
@@ -976,7 +1114,6 @@ void LoadModelAsset(CAssetContainer* const pak, CAsset* const asset)
         ParseModelBoneData_v8(mdlAsset->GetParsedData());
         ParseModelAttachmentData_v8(mdlAsset->GetParsedData());
         ParseModelTextureData_v8(mdlAsset->GetParsedData());
-        ParseModelVertexData_v9(pakAsset, mdlAsset);
         ParseModelSequenceData_NoStall(mdlAsset->GetParsedData(), reinterpret_cast<char* const>(mdlAsset->data));
         break;
     }
@@ -992,7 +1129,6 @@ void LoadModelAsset(CAssetContainer* const pak, CAsset* const asset)
         ParseModelBoneData_v12_1(mdlAsset->GetParsedData());
         ParseModelAttachmentData_v8(mdlAsset->GetParsedData());
         ParseModelTextureData_v8(mdlAsset->GetParsedData());
-        ParseModelVertexData_v12_1(pakAsset, mdlAsset);
         ParseModelSequenceData_Stall<r5::mstudioseqdesc_v8_t>(mdlAsset->GetParsedData(), reinterpret_cast<char* const>(mdlAsset->data));
         break;
     }
@@ -1005,7 +1141,6 @@ void LoadModelAsset(CAssetContainer* const pak, CAsset* const asset)
         ParseModelBoneData_v12_1(mdlAsset->GetParsedData());
         ParseModelAttachmentData_v8(mdlAsset->GetParsedData());
         ParseModelTextureData_v8(mdlAsset->GetParsedData());
-        ParseModelVertexData_v12_1(pakAsset, mdlAsset);
         ParseModelSequenceData_Stall<r5::mstudioseqdesc_v8_t>(mdlAsset->GetParsedData(), reinterpret_cast<char* const>(mdlAsset->data));
         break;
     }
@@ -1019,7 +1154,6 @@ void LoadModelAsset(CAssetContainer* const pak, CAsset* const asset)
         ParseModelBoneData_v12_1(mdlAsset->GetParsedData());
         ParseModelAttachmentData_v8(mdlAsset->GetParsedData());
         ParseModelTextureData_v8(mdlAsset->GetParsedData());
-        ParseModelVertexData_v14(pakAsset, mdlAsset);
         ParseModelSequenceData_Stall<r5::mstudioseqdesc_v8_t>(mdlAsset->GetParsedData(), reinterpret_cast<char* const>(mdlAsset->data));
         break;
     }
@@ -1033,7 +1167,6 @@ void LoadModelAsset(CAssetContainer* const pak, CAsset* const asset)
         ParseModelBoneData_v16(mdlAsset->GetParsedData());
         ParseModelAttachmentData_v16(mdlAsset->GetParsedData());
         ParseModelTextureData_v16(mdlAsset->GetParsedData());
-        ParseModelVertexData_v16(pakAsset, mdlAsset);
         ParseModelSequenceData_Stall<r5::mstudioseqdesc_v16_t>(mdlAsset->GetParsedData(), reinterpret_cast<char* const>(mdlAsset->data));
         break;
     }
@@ -1046,7 +1179,6 @@ void LoadModelAsset(CAssetContainer* const pak, CAsset* const asset)
         ParseModelBoneData_v16(mdlAsset->GetParsedData());
         ParseModelAttachmentData_v16(mdlAsset->GetParsedData());
         ParseModelTextureData_v16(mdlAsset->GetParsedData());
-        ParseModelVertexData_v16(pakAsset, mdlAsset);
         ParseModelSequenceData_Stall<r5::mstudioseqdesc_v18_t>(mdlAsset->GetParsedData(), reinterpret_cast<char* const>(mdlAsset->data));
         break;
     }
@@ -1059,7 +1191,6 @@ void LoadModelAsset(CAssetContainer* const pak, CAsset* const asset)
         ParseModelBoneData_v19(mdlAsset->GetParsedData());
         ParseModelAttachmentData_v16(mdlAsset->GetParsedData());
         ParseModelTextureData_v16(mdlAsset->GetParsedData());
-        ParseModelVertexData_v16(pakAsset, mdlAsset);
         ParseModelSequenceData_Stall<r5::mstudioseqdesc_v18_t>(mdlAsset->GetParsedData(), reinterpret_cast<char* const>(mdlAsset->data));
         break;
     }
@@ -1149,7 +1280,11 @@ void PostLoadModelAsset(CAssetContainer* const pak, CAsset* const asset)
         animSeq->parentModel = !animSeq->parentModel ? mdlAsset : animSeq->parentModel;
     }
 
-    // draw data
+    // [rika]: draw data is created on first preview, since it needs the vertex data to be parsed
+}
+
+static void CreateModelDrawData(ModelAsset* const mdlAsset)
+{
     ModelParsedData_t* const parsedData = mdlAsset->GetParsedData();
 
     if (parsedData->lods.empty())
@@ -1189,10 +1324,10 @@ static bool ExportRawModelAsset(const ModelAsset* const modelAsset, std::filesys
     // make a manifest of this assets dependencies
     exportPath.replace_extension(".rson");
 
-    StreamIO depOut(exportPath.string(), eStreamIOMode::Write);
-    WriteRSONDependencyArray(*depOut.W(), "rigs", modelAsset->animRigs, modelAsset->numAnimRigs);
-    WriteRSONDependencyArray(*depOut.W(), "seqs", modelAsset->animSeqs, modelAsset->numAnimSeqs);
-    depOut.close();
+    CTextWriter depOut(exportPath);
+    WriteRSONDependencyArray(depOut, "rigs", modelAsset->animRigs, modelAsset->numAnimRigs);
+    WriteRSONDependencyArray(depOut, "seqs", modelAsset->animSeqs, modelAsset->numAnimSeqs);
+    depOut.Close();
 
     // [rika]: should we export both starpak and rpak data?
     switch (modelAsset->version)
@@ -1440,13 +1575,11 @@ bool ExportModelAsset(CAsset* const asset, const int setting)
     CPakAsset* const pakAsset = static_cast<CPakAsset*>(asset);
     assertm(pakAsset, "Asset should be valid.");
 
-    const ModelAsset* const modelAsset = reinterpret_cast<ModelAsset*>(pakAsset->extraData());
+    ModelAsset* const modelAsset = reinterpret_cast<ModelAsset*>(pakAsset->extraData());
     assertm(modelAsset, "Extra data should be valid at this point.");
     if (!modelAsset)
         return false;
 
-    std::unique_ptr<char[]> streamedData = pakAsset->getStarPakData(modelAsset->vertDataStreamed.offset, modelAsset->vertDataStreamed.size, false);
-
     assertm(modelAsset->name, "No name for model.");
 
     // Create exported path + asset path.
@@ -1488,35 +1621,54 @@ bool ExportModelAsset(CAsset* const asset, const int setting)
         auto aseqAssetBinding = g_assetData.m_assetTypeBindings.find('qesa');
         assertm(aseqAssetBinding != g_assetData.m_assetTypeBindings.end(), "Unable to find asset type binding for \"aseq\" assets");
 
+        const int exportSetting = aseqAssetBinding->second.e.exportSetting;
+
+        // same as rig sequences, spread over the shared pool instead of exporting them all on this thread
+        CExportOutputRecorder* const outputRecorder = GetExportOutputRecorder();
+        CTaskGroup seqTasks;
         for (int i = 0; i < parsedData->NumLocalSeq(); i++)
         {
             const seqdesc_t* const seqdesc = parsedData->LocalSeq(i);
 
             outputPath.replace_filename(seqdesc->szlabel);
 
-            ExportSeqDesc(aseqAssetBinding->second.e.exportSetting, seqdesc, outputPath, modelAsset->name, modelAsset->GetRig(), RTech::StringToGuid(seqdesc->szlabel));
+            seqTasks.run([exportSetting, seqdesc, seqPath = outputPath, modelAsset, outputRecorder]() mutable
+                {
+                    const CExportOutputScope outputScope(outputRecorder);
+                    ExportSeqDesc(exportSetting, seqdesc, seqPath, modelAsset->name, modelAsset->GetRig(), RTech::StringToGuid(seqdesc->szlabel));
+                });
         }
+
+        seqTasks.wait();
     }
 
     exportPath.append(std::format("{}.rmdl", modelStem));
 
+    // read once, the setting can be changed from the ui while this export is running
+    const uint32_t lodSetting = g_ExportSettings.exportModelLodSetting;
+
     switch (setting)
     {
+        // [rika]: only the formats that need geometry parse it, and only the raw export reads the streamed vertex data
         case eModelExportSetting::MODEL_CAST:
         {
-            return ExportModelCast(parsedData, exportPath, asset->GetAssetGUID());
+            const std::shared_lock<std::shared_mutex> vertexDataLock = ParseModelVertexData(pakAsset, modelAsset, lodSetting);
+            return ExportModelCast(parsedData, GetParsedModelLODMask(modelAsset, lodSetting), exportPath, asset->GetAssetGUID());
         }
         case eModelExportSetting::MODEL_RMAX:
         {
-            return ExportModelRMAX(parsedData, exportPath);
+            const std::shared_lock<std::shared_mutex> vertexDataLock = ParseModelVertexData(pakAsset, modelAsset, lodSetting);
+            return ExportModelRMAX(parsedData, GetParsedModelLODMask(modelAsset, lodSetting), exportPath);
         }
         case eModelExportSetting::MODEL_RMDL:
         {
-            return ExportRawModelAsset(modelAsset, exportPath, streamedData.get());
+            const AssetDataView_t streamedData = modelAsset->vertDataStreamed.size > 0 ? pakAsset->getStarPakView(modelAsset->vertDataStreamed.offset, modelAsset->vertDataStreamed.size, false) : AssetDataView_t();
+            return ExportRawModelAsset(modelAsset, exportPath, streamedData.data);
         }
         case eModelExportSetting::MODEL_SMD:
         {
-            return ExportModelSMD(parsedData, exportPath);
+            const std::shared_lock<std::shared_mutex> vertexDataLock = ParseModelVertexData(pakAsset, modelAsset, lodSetting);
+            return ExportModelSMD(parsedData, GetParsedModelLODMask(modelAsset, lodSetting), exportPath);
         }
         case eModelExportSetting::MODEL_STL_VALVE_PHYSICS:
         {
@@ -1555,6 +1707,13 @@ void* PreviewModelAsset(CAsset* const asset, const bool firstFrameForAsset)
     if (!modelAsset)
         return nullptr;
 
+    if (!modelAsset->drawData)
+    {
+        // every lod is parsed after this, so the geometry can't change again and later frames can read it without the lock
+        const std::shared_lock<std::shared_mutex> vertexDataLock = ParseModelVertexData(pakAsset, modelAsset, eModelExportLod::MDL_LOD_ALL);
+        CreateModelDrawData(modelAsset);
+    }
+
     CDXDrawData* const drawData = modelAsset->drawData;
     if (!drawData)
         return nullptr;
@@ -415,9 +415,11 @@ public:
 	int numAnimRigs;
 	int numAnimSeqs;
 
-	CDXDrawData* drawData;
+	CDXDrawData* drawData = nullptr;
 
 	ModelParsedData_t parsedData;
+	std::shared_mutex vertexDataMutex; // geometry is parsed the first time the model is previewed or exported, not on load. parsing holds it exclusively, reading the parsed geometry holds it shared
+	uint8_t vertexDataLodMask = 0; // lods that have been parsed so far
 
 	eMDLVersion version; // like asset version, but takes between version revisions into consideration
 
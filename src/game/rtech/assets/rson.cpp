@@ -1,6 +1,7 @@
 #include <pch.h>
 #include <game/rtech/assets/rson.h>
 #include <game/rtech/cpakfile.h>
+#include <core/utils/textwriter.h>
 #include <thirdparty/imgui/imgui.h>
 
 extern ExportSettings_t g_ExportSettings;
@@ -25,10 +26,10 @@ void LoadRSONAsset(CAssetContainer* const container, CAsset* const asset)
         return;
     }
 
-    std::stringstream out;
+    CTextWriter out(&rsonAsset->rawText);
     RSONAssetNode_t rootNode(rsonAsset);
     rootNode.R_ParseNodeValues(out, 0); // store raw text so we can preview or export it
-    rsonAsset->rawText = out.str();
+    out.Close();
 
     pakAsset->setExtraData(rsonAsset);
 }
@@ -119,8 +120,8 @@ void InitRSONAssetType()
     REGISTER_TYPE(type);
 }
 
-// recursively parses all node values out of the rson node tree into our stringstream
-void RSONAssetNode_t::R_ParseNodeValues(std::stringstream& out, const size_t indentIdx) const
+// recursively parses all node values out of the rson node tree into our text writer
+void RSONAssetNode_t::R_ParseNodeValues(CTextWriter& out, const size_t indentIdx) const
 {
 	const std::string indentation = GetIndentation(indentIdx);
 
@@ -192,7 +193,7 @@ void RSONAssetNode_t::R_ParseNodeValues(std::stringstream& out, const size_t ind
 	R_WriteNodeValue(out, values, indentation, indentIdx);
 }
 
-void RSONAssetNode_t::R_WriteNodeValue(std::stringstream& out, RSONNodeValue_t val, const std::string& indentation, const size_t indentIdx) const
+void RSONAssetNode_t::R_WriteNodeValue(CTextWriter& out, RSONNodeValue_t val, const std::string& indentation, const size_t indentIdx) const
 {
 	switch (this->type & 0x1ff)
 	{
@@ -250,7 +251,7 @@ void RSONAssetNode_t::R_WriteNodeValue(std::stringstream& out, RSONNodeValue_t v
 	}
 	case eRSONFieldType::RSON_BOOLEAN:
 	{
-		out << std::boolalpha << val.valueBool << "\n";
+		out.WriteBool(val.valueBool) << "\n";
 		return;
 	}
 	case eRSONFieldType::RSON_INTEGER:
@@ -277,7 +278,7 @@ void RSONAssetNode_t::R_WriteNodeValue(std::stringstream& out, RSONNodeValue_t v
 	}
 }
 
-void WriteRSONDependencyArray(std::ofstream& out, const char* const name, const AssetGuid_t* const dependencies, const int count)
+void WriteRSONDependencyArray(CTextWriter& out, const char* const name, const AssetGuid_t* const dependencies, const int count)
 {
     out << name << ":\n[\n";
 
@@ -291,7 +292,10 @@ void WriteRSONDependencyArray(std::ofstream& out, const char* const name, const
         if (asset)
             out << "\t" << asset->GetAssetName() << "\n";
         else
-            out << "\t" << std::hex << dependencies[i].guid << "\n";
+        {
+            out << "\t";
+            out.WriteHex(dependencies[i].guid) << "\n";
+        }
     }
 
     out << "]\n";
@@ -2,6 +2,8 @@
 
 #include <game/rtech/utils/utils.h>
 
+class CTextWriter;
+
 enum eRSONFieldType : int
 {
 	RSON_NULL = 0x1,
@@ -68,8 +70,8 @@ public:
 	RSONAssetNode_t* nextPeer;
 	RSONAssetNode_t* prevPeer; // unsure if ever written to disk
 
-	void R_ParseNodeValues(std::stringstream& out, const size_t indentIdx) const;
-	void R_WriteNodeValue(std::stringstream& out, RSONNodeValue_t val, const std::string& indentation, const size_t indentIdx) const;
+	void R_ParseNodeValues(CTextWriter& out, const size_t indentIdx) const;
+	void R_WriteNodeValue(CTextWriter& out, RSONNodeValue_t val, const std::string& indentation, const size_t indentIdx) const;
 
 	FORCEINLINE const bool IsArray() const
 	{
@@ -94,4 +96,4 @@ public:
 };
 
 union AssetGuid_t;
-void WriteRSONDependencyArray(std::ofstream& out, const char* const name, const AssetGuid_t* const dependencies, const int count);
\ No newline at end of file
+void WriteRSONDependencyArray(CTextWriter& out, const char* const name, const AssetGuid_t* const dependencies, const int count);
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include <game/rtech/assets/settings.h>
 #include <game/rtech/cpakfile.h>
 #include <game/rtech/utils/utils.h>
+#include <core/utils/textwriter.h>
 #include <thirdparty/imgui/imgui.h>
 
 void LoadSettingsAsset(CAssetContainer* pak, CAsset* asset)
@@ -61,10 +62,10 @@ struct DynamicArrayData_t
 	int arrayOffset;
 };
 
-void SettingsAsset::R_WriteSetFileArray(std::string& out, const size_t indentLevel, const char* valuePtr,
+void SettingsAsset::R_WriteSetFileArray(CTextWriter& out, const size_t indentLevel, const char* valuePtr,
 	const size_t arrayElemCount, const SettingsLayoutAsset& subLayout)
 {
-	out += "[\n";
+	out << "[\n";
 
 	const size_t layoutSize = subLayout.totalLayoutSize;
 	const size_t fieldCount = subLayout.layoutFields.size();
@@ -74,62 +75,67 @@ void SettingsAsset::R_WriteSetFileArray(std::string& out, const size_t indentLev
 	for (uint32_t i = 0; i < arrayElemCount; ++i)
 	{
 		const char* elemValues = reinterpret_cast<const char*>(valuePtr) + (i * layoutSize);
-		out += indentation + "\t{\n";
+		out << indentation << "\t{\n";
 
 		for (size_t j = 0; j < fieldCount; ++j)
 		{
 			const SettingsField& subField = subLayout.layoutFields[j];
-			out += indentation + "\t\t" + "\"" + subField.fieldName + "\": ";
+			out << indentation << "\t\t\"" << subField.fieldName << "\": ";
 
 			R_WriteSetFile(out, indentLevel+2, elemValues, &subLayout , &subField);
 
 			const char* const commaChar = j != (fieldCount - 1) ? ",\n" : "\n";
-			out += commaChar;
+			out << commaChar;
 		}
 
-		out += indentation + "\t}";
+		out << indentation << "\t}";
 
 		if (fieldCount)
 		{
 			const char* const commaChar = i != (arrayElemCount - 1) ? ",\n" : "\n";
-			out += commaChar;
+			out << commaChar;
 		}
 	}
 
-	out += indentation + "]";
+	out << indentation << "]";
 }
 
-void SettingsAsset::R_WriteSetFile(std::string& out, const size_t indentLevel, const char* valData,
+void SettingsAsset::R_WriteSetFile(CTextWriter& out, const size_t indentLevel, const char* valData,
 	const SettingsLayoutAsset* layout, const SettingsField* const field)
 {
 	switch (field->dataType)
 	{
 	case eSettingsFieldType::ST_BOOL:
 	{
-		out.append((valData[field->valueOffset]) ? "true" : "false");
+		out.WriteBool(valData[field->valueOffset] != 0);
 		break;
 	}
 	case eSettingsFieldType::ST_INTEGER:
 	{
-		out.append(std::format("{:d}", *reinterpret_cast<const int*>(&valData[field->valueOffset])));
+		out << *reinterpret_cast<const int*>(&valData[field->valueOffset]);
 		break;
 	}
 	case eSettingsFieldType::ST_FLOAT:
 	{
-		out.append(std::format("{:f}", *reinterpret_cast<const float*>(&valData[field->valueOffset])));
+		out.WriteFixed(*reinterpret_cast<const float*>(&valData[field->valueOffset]));
 		break;
 	}
 	case eSettingsFieldType::ST_FLOAT2:
 	{
 		const float* floatValues = reinterpret_cast<const float*>(&valData[field->valueOffset]);
-		out.append(std::format("\"<{:f},{:f}>\"", floatValues[0], floatValues[1]));
+		out << "\"<";
+		out.WriteFixed(floatValues[0]) << ",";
+		out.WriteFixed(floatValues[1]) << ">\"";
 
 		break;
 	}
 	case eSettingsFieldType::ST_FLOAT3:
 	{
 		const float* floatValues = reinterpret_cast<const float*>(&valData[field->valueOffset]);
-		out.append(std::format("\"<{:f},{:f},{:f}>\"", floatValues[0], floatValues[1], floatValues[2]));
+		out << "\"<";
+		out.WriteFixed(floatValues[0]) << ",";
+		out.WriteFixed(floatValues[1]) << ",";
+		out.WriteFixed(floatValues[2]) << ">\"";
 
 		break;
 	}
@@ -138,7 +144,7 @@ void SettingsAsset::R_WriteSetFile(std::string& out, const size_t indentLevel, c
 	case eSettingsFieldType::ST_ASSET_2:
 	{
 		const char* const charBuf = *(const char**)&valData[field->valueOffset];
-		out.append(std::format("\"{:s}\"", charBuf));
+		out << "\"" << charBuf << "\"";
 		break;
 	}
 	case eSettingsFieldType::ST_ARRAY:
@@ -161,7 +167,7 @@ void SettingsAsset::R_WriteSetFile(std::string& out, const size_t indentLevel, c
 	}
 }
 
-void SettingsAsset::R_WriteSetFile(std::string& out, const size_t indentLevel, const char* valData, const SettingsLayoutAsset* layout)
+void SettingsAsset::R_WriteSetFile(CTextWriter& out, const size_t indentLevel, const char* valData, const SettingsLayoutAsset* layout)
 {
 	const std::string indentation = GetIndentation(indentLevel);
 	const size_t numLayoutFields = layout->layoutFields.size();
@@ -169,39 +175,38 @@ void SettingsAsset::R_WriteSetFile(std::string& out, const size_t indentLevel, c
 	for (size_t i = 0; i < numLayoutFields; ++i)
 	{
 		const SettingsField* const field = &layout->layoutFields.at(i);
-		out += indentation + "\"" + field->fieldName + "\": ";
+		out << indentation << "\"" << field->fieldName << "\": ";
 
 		R_WriteSetFile(out, indentLevel, valData, layout, field);
 
 		const char* const commaChar = i != (numLayoutFields-1) ? ",\n" : "\n";
-		out += commaChar;
+		out << commaChar;
 	}
 }
 
-void SettingsAsset::R_WriteModNames(std::string& out) const
+void SettingsAsset::R_WriteModNames(CTextWriter& out) const
 {
-	out += "\t\"$modNames\": [\n";
+	out << "\t\"$modNames\": [\n";
 
 	for (uint32_t i = 0; i < modNameCount; i++)
 	{
 		const char* const commaChar = i != (modNameCount - 1) ? "," : "";
-		out += std::string("\t\t\"") + modNames[i] + "\"" + commaChar + "\n";
+		out << "\t\t\"" << modNames[i] << "\"" << commaChar << "\n";
 	}
 
-	out += "\t]";
+	out << "\t]";
 }
 
-void SettingsAsset::R_WriteModValues(std::string& out, const SettingsLayoutAsset* const layout) const
+void SettingsAsset::R_WriteModValues(CTextWriter& out, const SettingsLayoutAsset* const layout) const
 {
-	out += "\t\"$modValues\": [\n";
+	out << "\t\"$modValues\": [\n";
 
 	for (uint32_t i = 0; i < modValuesCount; i++)
 	{
 		const SettingsMod_s* const modValue = &modValues[i];
-		out += std::format("\t\t{{ // originally mapped to offset {:d}\n", modValue->valueOffset);
+		out << "\t\t{ // originally mapped to offset " << modValue->valueOffset << "\n";
 
-		out += std::format("\t\t\t\"index\": {:d},\n\t\t\t\"type\": \"{:s}\",\n\t\t\t",
-			modValue->nameIndex, g_settingsModType[modValue->type]);
+		out << "\t\t\t\"index\": " << modValue->nameIndex << ",\n\t\t\t\"type\": \"" << g_settingsModType[modValue->type] << "\",\n\t\t\t";
 
 		SettingsLayoutFindByOffsetResult_s searchResult;
 		const bool foundField = SettingsFieldFinder_FindFieldByAbsoluteOffset(layout, modValue->valueOffset, searchResult);
@@ -212,38 +217,42 @@ void SettingsAsset::R_WriteModValues(std::string& out, const SettingsLayoutAsset
 			{
 			case SettingsModType_e::kIntAdd:
 			case SettingsModType_e::kIntMultiply:
-				out += std::format("\"value\": {:d},\n", modValue->value.intValue);
+				out << "\"value\": " << modValue->value.intValue << ",\n";
 				break;
 			case SettingsModType_e::kFloatAdd:
 			case SettingsModType_e::kFloatMultiply:
-				out += std::format("\"value\": {:f},\n", modValue->value.floatValue);
+				out << "\"value\": ";
+				out.WriteFixed(modValue->value.floatValue) << ",\n";
 				break;
 			case SettingsModType_e::kBool:
-				out += std::format("\"value\": {:s},\n", modValue->value.boolValue ? "true" : "false");
+				out << "\"value\": ";
+				out.WriteBool(modValue->value.boolValue) << ",\n";
 				break;
 			case SettingsModType_e::kNumber:
+				out << "\"value\": ";
+
 				if (searchResult.field->dataType == eSettingsFieldType::ST_INTEGER)
-					out += std::format("\"value\": {:d},\n", modValue->value.intValue);
+					out << modValue->value.intValue << ",\n";
 				else
-					out += std::format("\"value\": {:f},\n", modValue->value.floatValue);
+					out.WriteFixed(modValue->value.floatValue) << ",\n";
 				break;
 			case SettingsModType_e::kString:
-				out += std::format("\"value\": \"{:s}\",\n", &stringData[modValue->value.stringOffset]);
+				out << "\"value\": \"" << &stringData[modValue->value.stringOffset] << "\",\n";
 				break;
 			}
 
-			out += std::format("\t\t\t\"field\": \"{:s}\"\n", searchResult.fieldAccessPath);
+			out << "\t\t\t\"field\": \"" << searchResult.fieldAccessPath << "\"\n";
 		}
 		else
 		{
-			out += "// FAILURE( !!! SETTINGS FIELD NOT FOUND !!! )\n";
+			out << "// FAILURE( !!! SETTINGS FIELD NOT FOUND !!! )\n";
 		}
 
 		const char* const commaChar = i != (modValuesCount - 1) ? "," : "";
-		out += std::string("\t\t}") + commaChar + "\n";
+		out << "\t\t}" << commaChar << "\n";
 	}
 
-	out += "\t]";
+	out << "\t]";
 }
 
 static bool RenderSettingsAsset(CPakAsset* const asset, std::string& stringStream)
@@ -254,34 +263,38 @@ static bool RenderSettingsAsset(CPakAsset* const asset, std::string& stringStrea
 
 	const SettingsLayoutAsset* const layout = reinterpret_cast<SettingsLayoutAsset*>(settingsAsset->layoutAsset->extraData());
 
-	stringStream += std::string("{\n") + "\t\"layoutAsset\": \"" + layout->name + "\",\n";
+	CTextWriter out(&stringStream);
+
+	out << "{\n\t\"layoutAsset\": \"" << layout->name << "\",\n";
 
 	if (settingsAsset->uniqueId)
-		stringStream += std::format("\t\"uniqueId\": {:d},\n", settingsAsset->uniqueId);
+		out << "\t\"uniqueId\": " << settingsAsset->uniqueId << ",\n";
 
-	stringStream += "\t\"settings\": {\n";
+	out << "\t\"settings\": {\n";
 
 	// Recursively write the .set file contents into the string stream
-	settingsAsset->R_WriteSetFile(stringStream, 2, (const char*)settingsAsset->valueData, layout);
+	settingsAsset->R_WriteSetFile(out, 2, (const char*)settingsAsset->valueData, layout);
 
-	stringStream += "\t}";
+	out << "\t}";
 
 	if (settingsAsset->modNameCount)
 	{
-		stringStream += ",\n";
-		settingsAsset->R_WriteModNames(stringStream);
+		out << ",\n";
+		settingsAsset->R_WriteModNames(out);
 	}
 
 	if (settingsAsset->modValuesCount)
 	{
-		stringStream += ",\n";
-		settingsAsset->R_WriteModValues(stringStream, layout);
+		out << ",\n";
+		settingsAsset->R_WriteModValues(out, layout);
 	}
 
 	if (settingsAsset->modFlags)
-		stringStream += std::format(",\n\t\"$modFlags\": {:d}\n", settingsAsset->modFlags);
+		out << ",\n\t\"$modFlags\": " << settingsAsset->modFlags << "\n";
+
+	out << "\n}";
+	out.Close();
 
-	stringStream += "\n}";
 	FixSlashes(stringStream);
 
 	return true;
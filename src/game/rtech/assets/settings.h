@@ -1,6 +1,8 @@
 #pragma once
 #include <game/rtech/assets/settings_layout.h>
 
+class CTextWriter;
+
 enum SettingsModType_e : unsigned short
 {
 	kIntAdd = 0x0,
@@ -131,11 +133,11 @@ public:
 		return reinterpret_cast<char*>(valueData) + valueOffset;
 	}
 
-	void R_WriteSetFile(std::string& out, const size_t indentLevel, const char* valueData, const SettingsLayoutAsset* layout);
-	void R_WriteSetFile(std::string& out, const size_t indentLevel, const char* valueData, const SettingsLayoutAsset* layout, const SettingsField* const field);
+	void R_WriteSetFile(CTextWriter& out, const size_t indentLevel, const char* valueData, const SettingsLayoutAsset* layout);
+	void R_WriteSetFile(CTextWriter& out, const size_t indentLevel, const char* valueData, const SettingsLayoutAsset* layout, const SettingsField* const field);
 
-	void R_WriteSetFileArray(std::string& out, const size_t indentLevel, const char* valData, const size_t arrayElemCount, const SettingsLayoutAsset& subLayout);
+	void R_WriteSetFileArray(CTextWriter& out, const size_t indentLevel, const char* valData, const size_t arrayElemCount, const SettingsLayoutAsset& subLayout);
 
-	void R_WriteModNames(std::string& out) const;
-	void R_WriteModValues(std::string& out, const SettingsLayoutAsset* const layout) const;
+	void R_WriteModNames(CTextWriter& out) const;
+	void R_WriteModValues(CTextWriter& out, const SettingsLayoutAsset* const layout) const;
 };
\ No newline at end of file
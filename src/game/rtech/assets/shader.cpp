@@ -525,6 +525,7 @@ static void ExportShaderMetaData(const ShaderAsset* const shaderAsset, std::file
 {
 	exportPath.replace_extension(".json");
 	std::ofstream ofs(exportPath, std::ios::out);
+	RecordExportOutput(exportPath);
 
 	ofs << "{\n";
 
@@ -366,9 +366,9 @@ std::shared_ptr<CTexture> CreateTextureFromMip(CPakAsset* const asset, const Tex
     if (!mip->isLoaded)
         return nullptr;
 
-    std::unique_ptr<char[]> txtrData = GetTextureDataForMip(asset, mip, format, arrayIdx);
+    const AssetDataView_t txtrData = GetTextureViewForMip(asset, mip, format, arrayIdx);
 
-    return std::move(g_dxHandler->CreateRenderTexture(txtrData.get(), mip->slicePitch, mip->width, mip->height, format, 1u, 1u));
+    return std::move(g_dxHandler->CreateRenderTexture(txtrData.data, mip->slicePitch, mip->width, mip->height, format, 1u, 1u));
 };
 
 struct TexturePreviewData_t
@@ -781,7 +781,7 @@ bool ExportPngTextureAsset(CPakAsset* const asset, const TextureAsset* const txt
         {
             // Grab highest mip.
             const TextureMip_t* const mip = &txtrAsset->mipArray[txtrAsset->mipArray.size() - 1];
-            std::unique_ptr<char[]> txtrData = GetTextureDataForMip(asset, mip, s_PakToDxgiFormat[txtrAsset->imgFormat], arrayIdx);
+            const AssetDataView_t txtrData = GetTextureViewForMip(asset, mip, s_PakToDxgiFormat[txtrAsset->imgFormat], arrayIdx);
 
             if (txtrAsset->arraySize > 1)
             {
@@ -789,7 +789,7 @@ bool ExportPngTextureAsset(CPakAsset* const asset, const TextureAsset* const txt
                 exportPath.replace_filename(fileName).concat(suffix);
             }
 
-            std::unique_ptr<CTexture> exportTexture = std::make_unique<CTexture>(txtrData.get(), mip->slicePitch, mip->width, mip->height, s_PakToDxgiFormat[txtrAsset->imgFormat], 1u, 1u);
+            std::unique_ptr<CTexture> exportTexture = std::make_unique<CTexture>(txtrData.data, mip->slicePitch, mip->width, mip->height, s_PakToDxgiFormat[txtrAsset->imgFormat], 1u, 1u);
 
             NormalRecalc(isNormal, exportTexture.get());
 
@@ -810,13 +810,13 @@ bool ExportPngTextureAsset(CPakAsset* const asset, const TextureAsset* const txt
                 if (!mip->isLoaded)
                     return false;
                 
-                std::unique_ptr<char[]> txtrData = GetTextureDataForMip(asset, mip, s_PakToDxgiFormat[txtrAsset->imgFormat], arrayIdx);
+                const AssetDataView_t txtrData = GetTextureViewForMip(asset, mip, s_PakToDxgiFormat[txtrAsset->imgFormat], arrayIdx);
 
                 // Label levels properly.
                 std::string suffix = txtrAsset->arraySize > 1 ? std::format("_{:03}_level{}.png", arrayIdx, i) : std::format("_level{}.png", i);
                 exportPath.replace_filename(fileName).concat(suffix);
 
-                std::unique_ptr<CTexture> exportTexture = std::make_unique<CTexture>(txtrData.get(), mip->slicePitch, mip->width, mip->height, s_PakToDxgiFormat[txtrAsset->imgFormat], 1u, 1u);
+                std::unique_ptr<CTexture> exportTexture = std::make_unique<CTexture>(txtrData.data, mip->slicePitch, mip->width, mip->height, s_PakToDxgiFormat[txtrAsset->imgFormat], 1u, 1u);
 
                 NormalRecalc(isNormal, exportTexture.get());
 
@@ -855,6 +855,7 @@ static void ExportTextureMetaData(const TextureAsset* const txtrAsset, std::file
 {
     exportPath.replace_extension(".json");
     std::ofstream ofs(exportPath, std::ios::out);
+    RecordExportOutput(exportPath);
 
     ofs << "{\n";
 
@@ -912,7 +913,7 @@ bool ExportDdsTextureAsset(CPakAsset* const asset, const TextureAsset* const txt
         {
             // Grab highest mip.
             const TextureMip_t* const mip = &txtrAsset->mipArray[txtrAsset->mipArray.size() - 1];
-            std::unique_ptr<char[]> txtrData = GetTextureDataForMip(asset, mip, s_PakToDxgiFormat[txtrAsset->imgFormat], arrayIdx);
+            const AssetDataView_t txtrData = GetTextureViewForMip(asset, mip, s_PakToDxgiFormat[txtrAsset->imgFormat], arrayIdx);
 
             if (txtrAsset->arraySize > 1)
             {
@@ -920,7 +921,7 @@ bool ExportDdsTextureAsset(CPakAsset* const asset, const TextureAsset* const txt
                 exportPath.replace_filename(fileName).concat(suffix);
             }
 
-            std::unique_ptr<CTexture> exportTexture = std::make_unique<CTexture>(txtrData.get(), mip->slicePitch, mip->width, mip->height, s_PakToDxgiFormat[txtrAsset->imgFormat], 1u, 1u);
+            std::unique_ptr<CTexture> exportTexture = std::make_unique<CTexture>(txtrData.data, mip->slicePitch, mip->width, mip->height, s_PakToDxgiFormat[txtrAsset->imgFormat], 1u, 1u);
 
             NormalRecalc(isNormal, exportTexture.get());
 
@@ -941,13 +942,13 @@ bool ExportDdsTextureAsset(CPakAsset* const asset, const TextureAsset* const txt
                 if (!mip->isLoaded)
                     return false;
 
-                std::unique_ptr<char[]> txtrData = GetTextureDataForMip(asset, mip, s_PakToDxgiFormat[txtrAsset->imgFormat], arrayIdx);
+                const AssetDataView_t txtrData = GetTextureViewForMip(asset, mip, s_PakToDxgiFormat[txtrAsset->imgFormat], arrayIdx);
 
                 // Label levels properly.
                 std::string suffix = txtrAsset->arraySize > 1 ? std::format("_{:03}_level{}.dds", arrayIdx, i) : std::format("_level{}.dds", i);
                 exportPath.replace_filename(fileName).concat(suffix);
 
-                std::unique_ptr<CTexture> exportTexture = std::make_unique<CTexture>(txtrData.get(), mip->slicePitch, mip->width, mip->height, s_PakToDxgiFormat[txtrAsset->imgFormat], 1u, 1u);
+                std::unique_ptr<CTexture> exportTexture = std::make_unique<CTexture>(txtrData.data, mip->slicePitch, mip->width, mip->height, s_PakToDxgiFormat[txtrAsset->imgFormat], 1u, 1u);
 
                 NormalRecalc(isNormal, exportTexture.get());
 
@@ -973,9 +974,12 @@ bool ExportDdsTextureAsset(CPakAsset* const asset, const TextureAsset* const txt
                 if (!mip->isLoaded)
                     return false;
 
-                std::unique_ptr<char[]> mipData = GetTextureDataForMip(asset, mip, s_PakToDxgiFormat[txtrAsset->imgFormat], arrayIdx);
+                // uncompressed mips from a mapped starpak are copied straight into the staging buffer
+                const AssetDataView_t mipData = GetTextureViewForMip(asset, mip, s_PakToDxgiFormat[txtrAsset->imgFormat], arrayIdx);
+                if (!mipData.IsValid())
+                    return false;
 
-                memcpy_s(pCurrent, mip->slicePitch, mipData.get(), mip->slicePitch); // copy this mip's data into txtr data
+                memcpy_s(pCurrent, mip->slicePitch, mipData.data, mip->slicePitch); // copy this mip's data into txtr data
                 pCurrent += mip->slicePitch; // adjust our current position
             }
         }
@@ -1071,9 +1075,74 @@ void InitTextureAssetType()
     REGISTER_TYPE(type);
 }
 
-std::unique_ptr<char[]> UnswizlePS4(const TextureMip_t* const mip, const DXGI_FORMAT format, std::unique_ptr<char[]> txtrData)
+// big mips are unswizzled in bands of rows on the shared task pool, each band writes about this much
+static constexpr size_t s_UnswizzleJobSize = 1024ull * 1024ull;
+
+// runs unswizzleRows(first, last) over numRows rows, split into jobs if there's enough to be worth it
+template <typename Func>
+static void UnswizzleRows(const int numRows, const size_t rowSize, const Func& unswizzleRows)
 {
-    std::unique_ptr<char[]> txtrDataOut = std::make_unique<char[]>(mip->sizeSingle);
+    const int rowsPerJob = static_cast<int>(std::max<size_t>(1ull, s_UnswizzleJobSize / std::max<size_t>(1ull, rowSize)));
+    if (numRows <= rowsPerJob)
+    {
+        unswizzleRows(0, numRows);
+        return;
+    }
+
+    // rows never write to the same place, so jobs don't need to sync
+    CTaskGroup unswizzleJobs;
+    for (int row = 0; row < numRows; row += rowsPerJob)
+    {
+        const int lastRow = std::min(row + rowsPerJob, numRows);
+        unswizzleJobs.run([&unswizzleRows, row, lastRow]() { unswizzleRows(row, lastRow); });
+    }
+
+    // only helps with this group's rows, callers can hold their own locks across this
+    unswizzleJobs.wait();
+}
+
+// ps4 mips are stored in tiles of 8x8 blocks, tiles are in row order and the blocks within a tile are in morton order.
+// every even block in morton order is followed by the block to the right of it, so whole tiles are copied as 32 pairs of blocks using a table of where each pair ends up.
+// elementSize is the size of a block (or pixel) in bytes when it's known at compile time, otherwise it's 0 and vp is used
+template <size_t elementSize>
+static void UnswizzleTileRowsPS4(const char* const src, char* const dst, const size_t vp, const int blocksX, const int blocksY, const uint8_t* const tileX, const uint8_t* const tileY, const size_t* const pairOffsets, const int firstTileRow, const int lastTileRow)
+{
+    const size_t size = elementSize ? elementSize : vp;
+
+    const int tilesX = (blocksX + 7) / 8;
+    const size_t tileSize = 64ull * size;
+    const size_t rowPitch = static_cast<size_t>(blocksX) * size;
+
+    for (int ty = firstTileRow; ty < lastTileRow; ty++)
+    {
+        const char* tileSrc = src + (static_cast<size_t>(ty) * tilesX * tileSize);
+        const bool fullTileRow = (ty + 1) * 8 <= blocksY;
+
+        for (int tx = 0; tx < tilesX; tx++, tileSrc += tileSize)
+        {
+            char* const tileDst = dst + (static_cast<size_t>(ty) * 8ull * rowPitch) + (static_cast<size_t>(tx) * 8ull * size);
+
+            if (fullTileRow && (tx + 1) * 8 <= blocksX)
+            {
+                for (int i = 0; i < 32; i++)
+                    memcpy(tileDst + pairOffsets[i], tileSrc + (i * 2ull * size), 2ull * size);
+
+                continue;
+            }
+
+            // tiles on the right and bottom edge hang over the mip, blocks outside of it are skipped
+            for (int i = 0; i < 64; i++)
+            {
+                if (tx * 8 + tileX[i] < blocksX && ty * 8 + tileY[i] < blocksY)
+                    memcpy(tileDst + (tileY[i] * rowPitch) + (tileX[i] * size), tileSrc + (i * size), size);
+            }
+        }
+    }
+}
+
+std::unique_ptr<char[]> UnswizlePS4(const TextureMip_t* const mip, const DXGI_FORMAT format, const char* const txtrData)
+{
+    std::unique_ptr<char[]> txtrDataOut = std::make_unique_for_overwrite<char[]>(mip->sizeSingle);
 
     const uint8_t bpp = static_cast<uint8_t>(CTexture::GetBpp(format));
     int vp = (bpp * 2);
@@ -1085,43 +1154,91 @@ std::unique_ptr<char[]> UnswizlePS4(const TextureMip_t* const mip, const DXGI_FO
     const int blocksX = mip->width / pixbl;
     const int blocksY = mip->height / pixbl;
 
-    char tmp[16]; // copy data to unswizzle into here
-    int offset = 0; // offset into swizzled texture data
+    // everything past the unswizzled blocks is left zeroed
+    const size_t unswizzledSize = std::min<size_t>(static_cast<size_t>(vp) * blocksX * blocksY, mip->sizeSingle);
+    memset(txtrDataOut.get() + unswizzledSize, 0, mip->sizeSingle - unswizzledSize);
+
+    // position of each block within a tile, and where each pair of blocks goes relative to the tile's first block
+    uint8_t tileX[64];
+    uint8_t tileY[64];
+    size_t pairOffsets[32];
 
-    // parsing in 8x8 chunks of blocks
-    // bx block chunk x
-    // by block chunk y
-    for (int by = 0; by < (blocksY + 7) / 8; by++)
+    for (int i = 0; i < 64; i++)
     {
-        for (int bx = 0; bx < (blocksX + 7) / 8; bx++)
-        {
-            for (int i = 0; i < 64; i++)
-            {
-                const int mr = CTexture::Morton(i, 8, 8);
-                const int y = mr / 8; // local y coord within chunk
-                const int x = mr % 8; // local x coord within chunk
+        const int mr = CTexture::Morton(i, 8, 8);
+        tileY[i] = static_cast<uint8_t>(mr / 8); // local y coord within chunk
+        tileX[i] = static_cast<uint8_t>(mr % 8); // local x coord within chunk
 
-                if (bx * 8 + x < blocksX && by * 8 + y < blocksY)
-                {
-                    memcpy(tmp, txtrData.get() + offset, vp);
+        if ((i % 2) == 0)
+            pairOffsets[i / 2] = (tileY[i] * static_cast<size_t>(blocksX) * vp) + (tileX[i] * static_cast<size_t>(vp));
+    }
 
-                    const int dstIdx = (vp) * ((by * 8 + y) * blocksX + bx * 8 + x);
-                    memcpy(txtrDataOut.get() + dstIdx, tmp, vp);
-                }
+    const char* const src = txtrData;
+    char* const dst = txtrDataOut.get();
 
-                offset += vp;
+    const auto unswizzleRows = [src, dst, vp, blocksX, blocksY, &tileX, &tileY, &pairOffsets](const int firstTileRow, const int lastTileRow)
+        {
+            switch (vp)
+            {
+            case 1:
+                UnswizzleTileRowsPS4<1>(src, dst, vp, blocksX, blocksY, tileX, tileY, pairOffsets, firstTileRow, lastTileRow);
+                break;
+            case 2:
+                UnswizzleTileRowsPS4<2>(src, dst, vp, blocksX, blocksY, tileX, tileY, pairOffsets, firstTileRow, lastTileRow);
+                break;
+            case 4:
+                UnswizzleTileRowsPS4<4>(src, dst, vp, blocksX, blocksY, tileX, tileY, pairOffsets, firstTileRow, lastTileRow);
+                break;
+            case 8:
+                UnswizzleTileRowsPS4<8>(src, dst, vp, blocksX, blocksY, tileX, tileY, pairOffsets, firstTileRow, lastTileRow);
+                break;
+            case 16:
+                UnswizzleTileRowsPS4<16>(src, dst, vp, blocksX, blocksY, tileX, tileY, pairOffsets, firstTileRow, lastTileRow);
+                break;
+            default:
+                UnswizzleTileRowsPS4<0>(src, dst, vp, blocksX, blocksY, tileX, tileY, pairOffsets, firstTileRow, lastTileRow);
+                break;
             }
-        }
-    }
+        };
+
+    // parsing in 8x8 chunks of blocks, one row of chunks at a time
+    const int tilesX = (blocksX + 7) / 8;
+    const int tilesY = (blocksY + 7) / 8;
+
+    UnswizzleRows(tilesY, static_cast<size_t>(tilesX) * 64ull * vp, unswizzleRows);
 
     return std::move(txtrDataOut);
 }
 
 #ifdef SWITCH_SWIZZLE
-std::unique_ptr<char[]> UnswizleSwitch(const TextureMip_t* const mip, const DXGI_FORMAT format, std::unique_ptr<char[]> txtrData)
+// switch mips are stored in gobs (64 bytes by 8 rows) made of 32 16 byte units, gobs are stacked into sectors that are chunksPerSectorY gobs tall.
+// when the mip is made of whole sectors every unit lands inside the mip, so each gob is copied a unit at a time using a table of where each unit ends up.
+static void UnswizzleSectorRowsSwitch(const char* const src, char* const dst, const size_t rowPitch, const int sectorsX, const int chunksPerSectorY, const size_t* const unitOffsets, const int firstSectorRow, const int lastSectorRow)
 {
-    std::unique_ptr<char[]> txtrDataOut = std::make_unique<char[]>(mip->sizeSingle);
+    constexpr size_t unitSize = 16ull;
+    constexpr size_t gobSize = unitSize * 32ull;
+
+    const size_t sectorSize = gobSize * chunksPerSectorY;
 
+    for (int sy = firstSectorRow; sy < lastSectorRow; sy++)
+    {
+        const char* gobSrc = src + (static_cast<size_t>(sy) * sectorsX * sectorSize);
+
+        for (int sx = 0; sx < sectorsX; sx++)
+        {
+            for (int gob = 0; gob < chunksPerSectorY; gob++, gobSrc += gobSize)
+            {
+                char* const gobDst = dst + ((static_cast<size_t>(sy) * chunksPerSectorY + gob) * 8ull * rowPitch) + (static_cast<size_t>(sx) * 64ull);
+
+                for (int i = 0; i < 32; i++)
+                    memcpy(gobDst + unitOffsets[i], gobSrc + (i * unitSize), unitSize);
+            }
+        }
+    }
+}
+
+std::unique_ptr<char[]> UnswizleSwitch(const TextureMip_t* const mip, const DXGI_FORMAT format, const char* const txtrData)
+{
     const uint8_t bpp = static_cast<uint8_t>(CTexture::GetBpp(format));
     int vp = (bpp * 2);
 
@@ -1154,6 +1271,49 @@ std::unique_ptr<char[]> UnswizleSwitch(const TextureMip_t* const mip, const DXGI
         break;
     }
 
+    // the table path needs whole 16 byte units, and sectors that don't hang over the edge of the mip.
+    // sectors that do hang over write into the next row (or past the mip), those are left to the loop below so the result stays the same.
+    if (vp * chunksPerSectorX == 16 && chunksPerSectorY > 0)
+    {
+        const int sectorsX = IALIGN(blocksX / s_SwizzleChunkSizeSwitchX, chunksPerSectorX) / chunksPerSectorX;
+        const int sectorsY = IALIGN(blocksY / s_SwizzleChunkSizeSwitchY, chunksPerSectorY) / chunksPerSectorY;
+
+        if (sectorsX * chunksPerSectorX * s_SwizzleChunkSizeSwitchX == blocksX && sectorsY * chunksPerSectorY == blocksY / s_SwizzleChunkSizeSwitchY)
+        {
+            std::unique_ptr<char[]> txtrDataOut = std::make_unique_for_overwrite<char[]>(mip->sizeSingle);
+
+            const size_t rowPitch = static_cast<size_t>(blocksX) * vp;
+
+            // rows past the last whole gob are never written, same as the loop below
+            const size_t unswizzledSize = std::min<size_t>(rowPitch * sectorsY * chunksPerSectorY * s_SwizzleChunkSizeSwitchY, mip->sizeSingle);
+            memset(txtrDataOut.get() + unswizzledSize, 0, mip->sizeSingle - unswizzledSize);
+
+            size_t unitOffsets[32];
+            for (int i = 0; i < 32; i++)
+            {
+                const int mr = s_SwitchSwizzleLUT[i]; // morton pattern ?
+                const int y = mr / 4; // local y coord within chunk
+                const int x = mr % 4; // local x coord within chunk
+
+                unitOffsets[i] = (y * rowPitch) + (x * 16ull);
+            }
+
+            const char* const src = txtrData;
+            char* const dst = txtrDataOut.get();
+
+            const auto unswizzleRows = [src, dst, rowPitch, sectorsX, chunksPerSectorY, &unitOffsets](const int firstSectorRow, const int lastSectorRow)
+                {
+                    UnswizzleSectorRowsSwitch(src, dst, rowPitch, sectorsX, chunksPerSectorY, unitOffsets, firstSectorRow, lastSectorRow);
+                };
+
+            UnswizzleRows(sectorsY, rowPitch * chunksPerSectorY * s_SwizzleChunkSizeSwitchY, unswizzleRows);
+
+            return std::move(txtrDataOut);
+        }
+    }
+
+    std::unique_ptr<char[]> txtrDataOut = std::make_unique<char[]>(mip->sizeSingle);
+
     char tmp[16]; // copy data to unswizzle into here
     int offset = 0;
 
@@ -1173,7 +1333,7 @@ std::unique_ptr<char[]> UnswizleSwitch(const TextureMip_t* const mip, const DXGI
                         const int y = mr / 4; // local y coord within chunk
                         const int x = mr % 4; // local x coord within chunk
 
-                        memcpy(tmp, txtrData.get() + offset, vp);
+                        memcpy(tmp, txtrData + offset, vp);
 
                         const int globalY = (by * chunksPerSectorY + blockYIdx) * 8 + y;
                         const int globalX = (bx * 4 + x) * chunksPerSectorX + blockXIdx;
@@ -1192,26 +1352,26 @@ std::unique_ptr<char[]> UnswizleSwitch(const TextureMip_t* const mip, const DXGI
 }
 #endif
 
-std::unique_ptr<char[]> GetTextureDataForMip(CPakAsset* const asset, const TextureMip_t* const mip, const DXGI_FORMAT format, const size_t arrayIndex)
+AssetDataView_t GetTextureViewForMip(CPakAsset* const asset, const TextureMip_t* const mip, const DXGI_FORMAT format, const size_t arrayIndex)
 {
     // [rika]: I swapped back to size (from slicePitch) because it's the size of the mip on disk, and we just create a new buffer anyways if it's compressed. saves some allocation of bytes.
-    std::unique_ptr<char[]> txtrData;
+    AssetDataView_t txtrData;
     switch (mip->type)
     {
     case eTextureMipType::RPak:
     {
-        txtrData = std::make_unique<char[]>(mip->sizeSingle);
-        memcpy_s(txtrData.get(), mip->sizeSingle, mip->assetPtr.ptr + (mip->sizeSingle * arrayIndex), mip->sizeSingle);
+        // permanent mips live in the pak's pages for as long as the pak is loaded, no need to copy them
+        txtrData = AssetDataView_t(mip->assetPtr.ptr + (mip->sizeSingle * arrayIndex), mip->sizeSingle);
         break;
     }
     case eTextureMipType::StarPak:
     {
-        txtrData = asset->getStarPakData(mip->assetPtr.offset + (mip->sizeSingle * arrayIndex), mip->sizeSingle, false);
+        txtrData = asset->getStarPakView(mip->assetPtr.offset + (mip->sizeSingle * arrayIndex), mip->sizeSingle, false);
         break;
     }
     case eTextureMipType::OptStarPak:
     {
-        txtrData = asset->getStarPakData(mip->assetPtr.offset + (mip->sizeSingle * arrayIndex), mip->sizeSingle, true);
+        txtrData = asset->getStarPakView(mip->assetPtr.offset + (mip->sizeSingle * arrayIndex), mip->sizeSingle, true);
         break;
     }
     default:
@@ -1219,10 +1379,18 @@ std::unique_ptr<char[]> GetTextureDataForMip(CPakAsset* const asset, const Textu
         break;
     }
 
+    if (!txtrData.IsValid())
+        return {};
+
     if (mip->compType != eCompressionType::NONE)
     {
+        // decode straight out of the source data, a mapped starpak doesn't need to be copied into a buffer first
         uint64_t slicePitch = mip->slicePitch;
-        txtrData = RTech::DecompressStreamedBuffer(std::move(txtrData), slicePitch, mip->compType);
+        std::unique_ptr<char[]> dcmpData = RTech::DecompressStreamedBuffer(txtrData.data, slicePitch, mip->compType);
+
+        // oodle streams that aren't actually compressed come back empty, keep the source data in that case
+        if (dcmpData)
+            txtrData = AssetDataView_t(std::move(dcmpData), slicePitch);
     }
 
     if (mip->swizzle != eTextureSwizzle::SWIZZLE_NONE)
@@ -1231,13 +1399,13 @@ std::unique_ptr<char[]> GetTextureDataForMip(CPakAsset* const asset, const Textu
         {
         case eTextureSwizzle::SWIZZLE_PS4:
         {
-            txtrData = UnswizlePS4(mip, format, std::move(txtrData));
+            txtrData = AssetDataView_t(UnswizlePS4(mip, format, txtrData.data), mip->slicePitch);
             break;
         }
 #ifdef SWITCH_SWIZZLE
         case eTextureSwizzle::SWIZZLE_SWITCH:
         {
-            txtrData = UnswizleSwitch(mip, format, std::move(txtrData));
+            txtrData = AssetDataView_t(UnswizleSwitch(mip, format, txtrData.data), mip->slicePitch);
             break;
         }
 #endif
@@ -1246,5 +1414,12 @@ std::unique_ptr<char[]> GetTextureDataForMip(CPakAsset* const asset, const Textu
         }
     }
 
-    return std::move(txtrData);
+    return txtrData;
+}
+
+std::unique_ptr<char[]> GetTextureDataForMip(CPakAsset* const asset, const TextureMip_t* const mip, const DXGI_FORMAT format, const size_t arrayIndex)
+{
+    AssetDataView_t txtrData = GetTextureViewForMip(asset, mip, format, arrayIndex);
+
+    return txtrData.Release();
 }
\ No newline at end of file
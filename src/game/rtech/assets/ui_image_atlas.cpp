@@ -3,6 +3,7 @@
 #include <game/rtech/assets/texture.h>
 
 #include <core/render/dx.h>
+#include <core/render/pngwriter.h>
 #include <thirdparty/imgui/imgui.h>
 
 extern ExportSettings_t g_ExportSettings;
@@ -142,26 +143,150 @@ void PostLoadUIImageAtlasAsset(CAssetContainer* const pak, CAsset* const asset)
         pakAsset->SetAssetNameFromCache();
     }
 
+    uiAsset->format = s_PakToDxgiFormat[txtrAsset->imgFormat];
+
+    // the atlas texture itself is only loaded once it gets previewed or exported, see UIImageAtlasAsset::GetRawTexture
+    assertm(uiAsset->format != DXGI_FORMAT::DXGI_FORMAT_UNKNOWN, "unknown format");
+}
+
+// decoded atlases are big and most of them are never looked at, so only this much is kept around at once.
+// the least recently used atlases are released when we go over, they get loaded again if they're needed after that.
+static constexpr size_t s_UIAtlasResidentBudget = 512ull * 1024ull * 1024ull;
+
+static std::mutex s_UIAtlasResidentMutex;
+static std::list<UIImageAtlasAsset*> s_UIAtlasResident; // most recently used at the front
+static size_t s_UIAtlasResidentTotal = 0ull;
+
+// marks the atlas as most recently used and updates how much it has resident, releasing other atlases if we're over budget
+// the caller has to hold atlas->txtrMutex
+static void UIAtlas_MarkResident(UIImageAtlasAsset* const atlas)
+{
+    const size_t residentSize = (atlas->rawTxtr ? atlas->rawTxtr->GetSlicePitch() : 0ull) + (atlas->convertedTxtr ? atlas->convertedTxtr->GetSlicePitch() : 0ull);
+
+    std::lock_guard<std::mutex> lock(s_UIAtlasResidentMutex);
+
+    const auto it = std::find(s_UIAtlasResident.begin(), s_UIAtlasResident.end(), atlas);
+    if (it != s_UIAtlasResident.end())
+        s_UIAtlasResident.splice(s_UIAtlasResident.begin(), s_UIAtlasResident, it);
+    else
+        s_UIAtlasResident.push_front(atlas);
+
+    s_UIAtlasResidentTotal = s_UIAtlasResidentTotal - atlas->residentSize + residentSize;
+    atlas->residentSize = residentSize;
+
+    auto victimIt = s_UIAtlasResident.end();
+    while (s_UIAtlasResidentTotal > s_UIAtlasResidentBudget && victimIt != s_UIAtlasResident.begin())
+    {
+        --victimIt;
+        UIImageAtlasAsset* const victim = *victimIt;
+
+        // atlases that are being loaded on another thread are skipped, anything already using the textures keeps its own reference
+        if (victim == atlas || !victim->txtrMutex.try_lock())
+            continue;
+
+        victim->rawTxtr.reset();
+        victim->convertedTxtr.reset();
+
+        s_UIAtlasResidentTotal -= victim->residentSize;
+        victim->residentSize = 0ull;
+
+        victim->txtrMutex.unlock();
+
+        victimIt = s_UIAtlasResident.erase(victimIt);
+    }
+}
+
+static std::shared_ptr<CTexture> UIAtlas_LoadRawTexture(const UIImageAtlasAsset* const atlas)
+{
+    if (atlas->format == DXGI_FORMAT::DXGI_FORMAT_UNKNOWN)
+        return nullptr;
+
+    CPakAsset* const textureAsset = g_assetData.FindAssetByGUID<CPakAsset>(atlas->atlasGUID);
+    assertm(textureAsset, "Asset should be valid.");
+
+    if (!textureAsset)
+        return nullptr;
+
+    const TextureAsset* const txtrAsset = reinterpret_cast<TextureAsset*>(textureAsset->extraData());
+    assertm(txtrAsset, "Extra data should be valid.");
+
     assertm(txtrAsset->mipArray.size() >= 1, "Mip array should at least contain idx 0.");
-    TextureMip_t* const highestMip = &txtrAsset->mipArray[0];
+    const TextureMip_t* const highestMip = &txtrAsset->mipArray[0];
 
-    uiAsset->format = s_PakToDxgiFormat[txtrAsset->imgFormat];
+    std::unique_ptr<char[]> txtrData = GetTextureDataForMip(textureAsset, highestMip, atlas->format); // parse texture through this mip function instead of copying, that way if swizzling is present it gets fixed.
+
+    return std::make_shared<CTexture>(txtrData.get(), highestMip->slicePitch, highestMip->width, highestMip->height, atlas->format, 1u, 1u);
+}
+
+UIImageAtlasAsset::~UIImageAtlasAsset()
+{
+    ReleaseTextures();
+}
+
+const DXGI_FORMAT UIImageAtlasAsset::GetConvertedFormat() const
+{
+    return IsSRGB(format) ? DXGI_FORMAT_R8G8B8A8_UNORM_SRGB : DXGI_FORMAT_R8G8B8A8_UNORM;
+}
+
+std::shared_ptr<CTexture> UIImageAtlasAsset::GetRawTexture()
+{
+    std::lock_guard<std::mutex> lock(txtrMutex);
+
+    if (!rawTxtr)
+        rawTxtr = UIAtlas_LoadRawTexture(this);
+
+    if (!rawTxtr)
+        return nullptr;
+
+    UIAtlas_MarkResident(this);
 
-    if (uiAsset->format == DXGI_FORMAT::DXGI_FORMAT_UNKNOWN)
+    return rawTxtr;
+}
+
+std::shared_ptr<CTexture> UIImageAtlasAsset::GetConvertedTexture()
+{
+    std::lock_guard<std::mutex> lock(txtrMutex);
+
+    if (!convertedTxtr)
     {
-        assertm(false, "unknown format");
-        return;
+        if (!rawTxtr)
+            rawTxtr = UIAtlas_LoadRawTexture(this);
+
+        if (!rawTxtr)
+            return nullptr;
+
+        // Convert to respective srgb non srgb format for texture slicing.
+        // the decode jobs this waits on never take txtrMutex, and the wait only runs those jobs, so holding it here is fine.
+        std::shared_ptr<CTexture> converted = std::make_shared<CTexture>(reinterpret_cast<const char*>(rawTxtr->GetPixels()), rawTxtr->GetSlicePitch(), rawTxtr->GetWidth(), rawTxtr->GetHeight(), format, 1u, 1u);
+
+        if (converted->ConvertToFormat(GetConvertedFormat()))
+            convertedTxtr = std::move(converted);
     }
 
-    std::unique_ptr<char[]> txtrData = GetTextureDataForMip(textureAsset, highestMip, uiAsset->format); // parse texture through this mip function instead of copying, that way if swizzling is present it gets fixed.
+    UIAtlas_MarkResident(this);
+
+    return convertedTxtr;
+}
+
+void UIImageAtlasAsset::ReleaseTextures()
+{
+    std::lock_guard<std::mutex> lock(txtrMutex);
+
+    rawTxtr.reset();
+    convertedTxtr.reset();
+
+    // most atlases are never loaded, don't touch the resident list for those
+    if (residentSize == 0ull)
+        return;
+
+    std::lock_guard<std::mutex> residentLock(s_UIAtlasResidentMutex);
 
-    // Only raw needs SRV.
-    uiAsset->rawTxtr = std::make_shared<CTexture>(txtrData.get(), highestMip->slicePitch, highestMip->width, highestMip->height, uiAsset->format, 1u, 1u);
-    uiAsset->rawTxtr->CreateShaderResourceView(g_dxHandler->GetDevice());
+    const auto it = std::find(s_UIAtlasResident.begin(), s_UIAtlasResident.end(), this);
+    if (it != s_UIAtlasResident.end())
+        s_UIAtlasResident.erase(it);
 
-    // Convert to respective srgb non srgb format for texture slicing later.
-    uiAsset->convertedTxtr = std::make_shared<CTexture>(txtrData.get(), highestMip->slicePitch, highestMip->width, highestMip->height, uiAsset->format, 1u, 1u);
-    uiAsset->convertedTxtr->ConvertToFormat(IsSRGB(uiAsset->format) ? DXGI_FORMAT_R8G8B8A8_UNORM_SRGB : DXGI_FORMAT_R8G8B8A8_UNORM); // Convert in advance to non compressed format for preview.
+    s_UIAtlasResidentTotal -= residentSize;
+    residentSize = 0ull;
 }
 
 struct UITexturePreviewData_t
@@ -260,23 +385,32 @@ void* PreviewUIImageAtlasAsset(CAsset* const asset, const bool firstFrameForAsse
     // TODO: parse and preview into render size
     auto CreateTextureForImage = [](UIImageAtlasAsset* const uiAsset, const UIAtlasImage* const uiImage) -> std::shared_ptr<CTexture>
     {
-        assertm(uiAsset->rawTxtr, "Atlas texture wasn't created yet.");
-        assertm(uiAsset->convertedTxtr, "Converted atlas texture wasn't created yet.");
-
-        if (!uiAsset->rawTxtr || !uiAsset->convertedTxtr)
-            return nullptr;
-
         // This will be the main texture.
         if (uiImage->width == uiAsset->width && uiImage->height == uiImage->height)
-            return uiAsset->rawTxtr;
+        {
+            // Only raw needs SRV.
+            std::shared_ptr<CTexture> rawTxtr = uiAsset->GetRawTexture();
+            assertm(rawTxtr, "Atlas texture couldn't be loaded.");
+
+            if (rawTxtr && !rawTxtr->GetSRV())
+                rawTxtr->CreateShaderResourceView(g_dxHandler->GetDevice());
+
+            return rawTxtr;
+        }
 
         // invalid image
         if (!uiImage->width || !uiImage->height)
             return nullptr;
 
+        const std::shared_ptr<CTexture> convertedTxtr = uiAsset->GetConvertedTexture();
+        assertm(convertedTxtr, "Converted atlas texture couldn't be created.");
+
+        if (!convertedTxtr)
+            return nullptr;
+
         // Create texture / shader and get slice for image.
-        std::shared_ptr<CTexture> txtrData = std::make_shared<CTexture>(nullptr, 0u, uiImage->width, uiImage->height, (IsSRGB(uiAsset->format) ? DXGI_FORMAT_R8G8B8A8_UNORM_SRGB : DXGI_FORMAT_R8G8B8A8_UNORM), 1u, 1u);
-        txtrData->CopySourceTextureSlice(uiAsset->convertedTxtr.get(), static_cast<size_t>(uiImage->posX), static_cast<size_t>(uiImage->posY), uiImage->width, uiImage->height, 0u, 0u);
+        std::shared_ptr<CTexture> txtrData = std::make_shared<CTexture>(nullptr, 0u, uiImage->width, uiImage->height, uiAsset->GetConvertedFormat(), 1u, 1u);
+        txtrData->CopySourceTextureSlice(convertedTxtr.get(), static_cast<size_t>(uiImage->posX), static_cast<size_t>(uiImage->posY), uiImage->width, uiImage->height, 0u, 0u);
         txtrData->CreateShaderResourceView(g_dxHandler->GetDevice());
 
         return txtrData;
@@ -473,6 +607,31 @@ enum eUIImageAtlasExportSetting
     DDS_T,  // DDS (Textures)
 };
 
+// writes one image out of the converted atlas
+static void ExportUIAtlasImage(const UIImageAtlasAsset* const uiAsset, CTexture* const convertedTxtr, const UIAtlasImage* const image, const std::filesystem::path& exportPath, const bool exportPng)
+{
+    const size_t atlasWidth = static_cast<size_t>(convertedTxtr->GetWidth());
+    const size_t atlasHeight = static_cast<size_t>(convertedTxtr->GetHeight());
+
+    // the png writer can take the image straight out of the atlas with the atlas' row pitch, no copy needed
+    if (exportPng && static_cast<size_t>(image->posX) + image->width <= atlasWidth && static_cast<size_t>(image->posY) + image->height <= atlasHeight)
+    {
+        const size_t rowPitch = atlasWidth * 4ull;
+        const uint8_t* const pixels = convertedTxtr->GetPixels() + (image->posY * rowPitch) + (image->posX * 4ull);
+
+        WritePng(exportPath, pixels, rowPitch, image->width, image->height, uiAsset->GetConvertedFormat(), g_ExportSettings.exportPngCompressionSetting);
+        return;
+    }
+
+    std::unique_ptr<CTexture> sliceData = std::make_unique<CTexture>(nullptr, 0u, image->width, image->height, uiAsset->GetConvertedFormat(), 1u, 1u);
+    sliceData->CopySourceTextureSlice(convertedTxtr, static_cast<size_t>(image->posX), static_cast<size_t>(image->posY), image->width, image->height, 0u, 0u);
+
+    if (exportPng)
+        sliceData->ExportAsPng(exportPath);
+    else
+        sliceData->ExportAsDds(exportPath);
+}
+
 //static_assert(s_AssetTypePaths.count(PakAssetType_t::UIMG));
 static const char* const s_PathPrefixUIMG = s_AssetTypePaths.find(AssetType_t::UIMG)->second;
 bool ExportUIImageAtlasAsset(CAsset* const asset, const int setting)
@@ -504,7 +663,11 @@ bool ExportUIImageAtlasAsset(CAsset* const asset, const int setting)
     case eUIImageAtlasExportSetting::PNG_AT:
     case eUIImageAtlasExportSetting::DDS_AT:
     {
-        assertm(uiAsset->rawTxtr, "Atlas was not valid.");
+        const std::shared_ptr<CTexture> rawTxtr = uiAsset->GetRawTexture();
+        assertm(rawTxtr, "Atlas was not valid.");
+
+        if (!rawTxtr)
+            return false;
 
         switch (setting)
         {
@@ -513,7 +676,7 @@ bool ExportUIImageAtlasAsset(CAsset* const asset, const int setting)
             // Add png for file extension.
             exportPath.replace_extension("png");
 
-            if (!uiAsset->rawTxtr->ExportAsPng(exportPath))
+            if (!rawTxtr->ExportAsPng(exportPath))
                 return false;
 
             return true;
@@ -523,7 +686,7 @@ bool ExportUIImageAtlasAsset(CAsset* const asset, const int setting)
             // Add dds for file extension.
             exportPath.replace_extension("dds");
 
-            if (!uiAsset->rawTxtr->ExportAsDds(exportPath))
+            if (!rawTxtr->ExportAsDds(exportPath))
                 return false;
 
             return true;
@@ -532,9 +695,20 @@ bool ExportUIImageAtlasAsset(CAsset* const asset, const int setting)
 
         return false;
     }
+    case eUIImageAtlasExportSetting::PNG_T:
     case eUIImageAtlasExportSetting::DDS_T:
     {
-        assertm(uiAsset->convertedTxtr, "Converted atlas was not valid.");
+        const std::shared_ptr<CTexture> convertedTxtr = uiAsset->GetConvertedTexture();
+        assertm(convertedTxtr, "Converted atlas was not valid.");
+
+        if (!convertedTxtr)
+            return false;
+
+        const bool exportPng = setting == eUIImageAtlasExportSetting::PNG_T;
+
+        // images are written on the shared pool straight out of the converted atlas, paths and directories are set up here first so no two tasks create the same directory
+        CExportOutputRecorder* const outputRecorder = GetExportOutputRecorder();
+        CTaskGroup sliceTasks;
         for (auto it = uiAsset->imageArray.rbegin() + 1; it != uiAsset->imageArray.rend(); ++it) // We skip the last element, this is the main atlas texture.
         {
             // [amos] if either of them are null, the DirectX::CopyRectangle call will crash.
@@ -563,50 +737,16 @@ bool ExportUIImageAtlasAsset(CAsset* const asset, const int setting)
                 assertm(false, "Failed to create export type directory");
                 return false;
             }
-            currentPath.concat(std::format("\\{}.dds", itemPath.filename().string()));
-
-            printf("Format = %d\n", (int)uiAsset->format);
+            currentPath.concat(std::format("\\{}.{}", itemPath.filename().string(), exportPng ? "png" : "dds"));
 
-            std::unique_ptr<CTexture> sliceData = std::make_unique<CTexture>(nullptr, 0u, it->width, it->height, (IsSRGB(uiAsset->format) ? DXGI_FORMAT_R8G8B8A8_UNORM_SRGB : DXGI_FORMAT_R8G8B8A8_UNORM), 1u, 1u);
-            sliceData->CopySourceTextureSlice(uiAsset->convertedTxtr.get(), static_cast<size_t>(it->posX), static_cast<size_t>(it->posY), it->width, it->height, 0u, 0u);
-            sliceData->ExportAsDds(currentPath);
+            sliceTasks.run([uiAsset, &convertedTxtr, image = &*it, imagePath = std::move(currentPath), exportPng, outputRecorder]
+                {
+                    const CExportOutputScope outputScope(outputRecorder);
+                    ExportUIAtlasImage(uiAsset, convertedTxtr.get(), image, imagePath, exportPng);
+                });
         }
 
-        return true;
-    }
-    case eUIImageAtlasExportSetting::PNG_T:
-    {
-        assertm(uiAsset->convertedTxtr, "Converted atlas was not valid.");
-        for (auto it = uiAsset->imageArray.rbegin() + 1; it != uiAsset->imageArray.rend(); ++it) // We skip the last element, this is the main atlas texture.
-        {
-            // [amos] if either of them are null, the DirectX::CopyRectangle call will crash.
-            // the preview function above logs it as N/A so I think we should just skip them.
-            if (!it->width || !it->height)
-                continue;
-
-            std::filesystem::path currentPath = exportPath;
-            std::filesystem::path itemPath = it->path;
-
-            // Setup paths.
-            if (currentPath.has_parent_path())
-                currentPath.append(itemPath.parent_path().string());
-
-            // [amos] Need to remove trailing slash because otherwise std::filesystem::create_directories
-            // will fail with the error message "The operation completed successfully".
-            // See https://developercommunity.visualstudio.com/t/stdfilesystemcreate-directories-returns-false-if-p/278829
-            currentPath = currentPath.parent_path();
-
-            if (!CreateDirectories(currentPath))
-            {
-                assertm(false, "Failed to create export type directory");
-                return false;
-            }
-            currentPath.concat(std::format("\\{}.png", itemPath.filename().string()));
-
-            std::unique_ptr<CTexture> sliceData = std::make_unique<CTexture>(nullptr, 0u, it->width, it->height, (IsSRGB(uiAsset->format) ? DXGI_FORMAT_R8G8B8A8_UNORM_SRGB : DXGI_FORMAT_R8G8B8A8_UNORM), 1u, 1u);
-            sliceData->CopySourceTextureSlice(uiAsset->convertedTxtr.get(), static_cast<size_t>(it->posX), static_cast<size_t>(it->posY), it->width, it->height, 0u, 0u);
-            sliceData->ExportAsPng(currentPath);
-        }
+        sliceTasks.wait();
 
         return true;
     }
@@ -105,7 +105,8 @@ public:
 	UIImageAtlasAsset() = default;
 	UIImageAtlasAsset(UIImageAtlasAssetHeader_v10_t* hdr) : widthRatio(hdr->widthRatio), heightRatio(hdr->heightRatio), width(hdr->width), height(hdr->height), textureCount(hdr->textureCount), unkCount(hdr->unkCount),
 		textureOffsets(hdr->textureOffsets), textureDimensions(hdr->textureDimensions), unk(hdr->unk), textureHashes(hdr->textureHashes), textureNames(hdr->textureNames), atlasGUID(hdr->atlasGUID),
-		rawTxtr(nullptr), convertedTxtr(nullptr), format(DXGI_FORMAT_UNKNOWN) {};
+		format(DXGI_FORMAT_UNKNOWN), rawTxtr(nullptr), convertedTxtr(nullptr), residentSize(0ull) {};
+	~UIImageAtlasAsset();
 
 	float widthRatio;
 	float heightRatio;
@@ -129,9 +130,20 @@ public:
 
 	uint64_t atlasGUID;
 
-	//
-	std::shared_ptr<CTexture> rawTxtr;
-	std::shared_ptr<CTexture> convertedTxtr;
+	// the atlas texture is only loaded and decoded the first time it's needed, not when the pak is loaded.
+	// least recently used atlases are released again when too many are resident, so hold on to the returned pointer while using it.
+	std::shared_ptr<CTexture> GetRawTexture();
+	std::shared_ptr<CTexture> GetConvertedTexture(); // R8G8B8A8, srgb if the atlas is
+	void ReleaseTextures();
+
+	const DXGI_FORMAT GetConvertedFormat() const;
+
 	DXGI_FORMAT format;
 	std::vector<UIAtlasImage> imageArray;
+
+	// guards the textures below, use the functions above instead of these
+	std::mutex txtrMutex;
+	std::shared_ptr<CTexture> rawTxtr;
+	std::shared_ptr<CTexture> convertedTxtr;
+	size_t residentSize; // size of the textures above that counts towards the resident budget
 };
\ No newline at end of file
@@ -175,9 +175,9 @@ bool ExportWrapAsset(CAsset* const asset, const int setting)
     // needs some stuff to be finished first
     /*case eWrapAssetParsedDataType::BSP:
     {
-        StreamIO wrapOut;
+        CTextWriter wrapOut(exportPath);
 
-        if (!wrapOut.open(exportPath.string(), eStreamIOMode::Write))
+        if (!wrapOut.IsOpen())
         {
             assertm(false, "Failed to open file for write.");
             return false;
@@ -185,9 +185,9 @@ bool ExportWrapAsset(CAsset* const asset, const int setting)
 
         CBSPData* bspData = reinterpret_cast<CBSPData*>(wrapAsset->parsedData);
 
-        bspData->Export(wrapOut.W());
+        bspData->Export(&wrapOut);
 
-        wrapOut.close();
+        wrapOut.Close();
 
         break;
     }*/
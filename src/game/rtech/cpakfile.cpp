@@ -4,8 +4,10 @@
 
 #include <game/rtech/utils/utils.h>
 #include <thirdparty/imgui/misc/imgui_utility.h>
+#include <thirdparty/oodle/oodle2.h>
 
 //CGlobalPakData g_pakData;
+StarPakIOStats_t g_starpakIOStats;
 
 #if defined(PAKLOAD_PATCHING_ANY)
 CPakFile::CPakFile() : m_pPatchDataHeader(nullptr), m_pPatchFileHeaders(nullptr), patchDataBuffer(nullptr), patchStreamCursor(nullptr), m_pAssetsRaw(nullptr), m_pAssetsInternal(nullptr), m_pDependentAssets(nullptr),
@@ -94,6 +96,42 @@ const bool CPakFile::ParseFileBuffer(const std::string& path)
     return true;
 }
 
+const bool CPakFile::ReadFileHeaderInfo(const std::string& path, FileHeaderInfo_t* const info)
+{
+    CRandomAccessFile file;
+    if (!file.open(path))
+        return false;
+
+    char headerBuf[std::max({ sizeof(PakHdr_v6_t), sizeof(PakHdr_v7_t), sizeof(PakHdr_v8_t) })] = {};
+    const uint64_t headerReadSize = std::min(static_cast<uint64_t>(sizeof(headerBuf)), file.size());
+    if (headerReadSize < sizeof(int) + sizeof(short) || !file.read(headerBuf, 0ull, headerReadSize))
+        return false;
+
+    const short version = reinterpret_cast<const short*>(headerBuf)[2];
+
+    std::unique_ptr<PakHdr_t> header = nullptr;
+    switch (version)
+    {
+    case 6:
+        header = std::make_unique<PakHdr_t>(reinterpret_cast<const PakHdr_v6_t*>(headerBuf));
+        break;
+    case 7:
+        header = std::make_unique<PakHdr_t>(reinterpret_cast<const PakHdr_v7_t*>(headerBuf));
+        break;
+    case 8:
+        header = std::make_unique<PakHdr_t>(reinterpret_cast<const PakHdr_v8_t*>(headerBuf));
+        break;
+    default:
+        return false;
+    }
+
+    info->crc = header->crc;
+    info->dcmpSize = static_cast<uint64_t>(header->dcmpSize);
+    info->patchCount = header->patchCount;
+
+    return true;
+}
+
 const bool CPakFile::ParsePakFileHeader(const char* buf)
 {
     // pak should be definitely valid by now
@@ -146,45 +184,14 @@ const bool CPakFile::LoadNonPatched()
         this->firstPageIdx = m_pPatchDataHeader->patchPageCount;
     }
 
-    // if there are any mandatory streaming files
-    if (m_pHeader->streamingFilesBufSize)
-    {
-        // var contains the size of the buffer containing streaming file paths
-        int remainingLength = m_pHeader->streamingFilesBufSize;
-        while (remainingLength > 0)
-        {
-            const std::string streamingFilePath = reinterpret_cast<char*>(buf + offset);
-            std::filesystem::path fileInfo(streamingFilePath);
-
-            ParseStreamedFile(fileInfo.filename().string(), false);
-            const int length = static_cast<int>(streamingFilePath.length());
+    // streaming file paths are stored right after each other, mandatory first then optional
+    const char* const streamingFilePaths = buf + offset;
+    offset += m_pHeader->streamingFilesBufSize;
 
-            // add to offset so we can get the next path on the next iteration
-            offset += static_cast<size_t>(length + 1);
-            // subtract length + 1 from remaining length so we can terminate when the entire buffer has been found
-            remainingLength -= length + 1;
-        }
-    }
+    const char* const optStreamingFilePaths = buf + offset;
+    offset += m_pHeader->optStreamingFilesBufSize;
 
-    // if there are any optional streaming files
-    if (m_pHeader->optStreamingFilesBufSize)
-    {
-        // var contains the size of the buffer containing "opt" streaming file paths
-        int remainingLength = m_pHeader->optStreamingFilesBufSize;
-        while (remainingLength > 0)
-        {
-            std::string streamingFilePath = reinterpret_cast<char*>(buf + offset);
-            std::filesystem::path fileInfo(streamingFilePath);
-
-            ParseStreamedFile(fileInfo.filename().string(), true);
-            const int length = static_cast<int>(streamingFilePath.length());
-
-            // add to offset so we can get the next path on the next iteration
-            offset += static_cast<size_t>(length + 1);
-            // subtract length + 1 from remaining length so we can terminate when the entire buffer has been found
-            remainingLength -= length + 1;
-        }
-    }
+    ParseStreamedFiles(streamingFilePaths, m_pHeader->streamingFilesBufSize, optStreamingFilePaths, m_pHeader->optStreamingFilesBufSize);
 
     m_pSegmentHeaders = reinterpret_cast<PakSegmentHdr_t*>(buf + offset);
 
@@ -295,13 +302,6 @@ const bool CPakFile::LoadNonPatched()
 template<class PakHdr, class PakAsset>
 const bool CPakFile::LoadAndPatchPakFileData()
 {
-    if (g_assetData.m_pakLoadStatusMap.count(header()->crc) != 0)
-    {
-        Log("Pakfile '%s' failed to load because its CRC was already recorded as being loaded.\n", m_FilePath.c_str());
-
-        return false;
-    }
-
     // if this is not consistent across patches.. uhm?
     const short pakVersion = header()->version;
 
@@ -350,8 +350,10 @@ const bool CPakFile::LoadAndPatchPakFileData()
         // Save the initialised pak load state into the chain's loaded pakfiles vector.
         pakChain.at(static_cast<size_t>(i + 1)) = loadState;
 
-        if(patchPakHdr->crc != 0 && g_assetData.m_pakLoadStatusMap.count(patchPakHdr->crc) == 0)
-            g_assetData.m_pakLoadStatusMap.emplace(patchPakHdr->crc, true);
+        // claiming only keeps the patch from being loaded as a pak of its own later on. it can already be claimed if it was also
+        // picked for loading by itself, this chain still needs its data either way, so the result doesn't matter here
+        if(patchPakHdr->crc != 0)
+            static_cast<void>(g_assetData.ClaimPakLoad(patchPakHdr->crc));
     }
 
     std::shared_ptr<char[]> combinedPakDataBuffer = std::make_shared<char[]>(combinedPakBufferSize);
@@ -431,51 +433,289 @@ const bool CPakFile::LoadAndPatchPakFileData()
     ParsePakFileHeader(m_Buf.get(), pakVersion);
     ResetHeaders();
 
-    if (header()->streamingFilesBufSize)
+    ParseStreamedFiles(header()->GetStreamingFilePaths(), header()->streamingFilesBufSize, header()->GetOptStreamingFilePaths(), header()->optStreamingFilesBufSize);
+
+    ProcessAssets();
+    return true;
+}
+#endif // #if defined(PAKLOAD_PATCHING_V8)  || defined(PAKLOAD_PATCHING_V7)
+
+// reads a file front to back on its own thread in fixed size chunks, so a pak can be decoded while the rest of it is still being read.
+// this is a dedicated thread and not a scheduler task, the decoder blocks on it and could otherwise end up waiting on a task that never runs.
+class CPakFileChunkReader
+{
+public:
+    static constexpr uint64_t chunkSize = 0x400000; // 4MB
+    static constexpr size_t maxQueuedChunks = 4;
+
+    struct Chunk_t
+    {
+        std::unique_ptr<char[]> data;
+        uint64_t size;
+    };
+
+    CPakFileChunkReader(const CRandomAccessFile* const file, const uint64_t startOffset, const uint64_t endOffset) : pFile(file), offset(startOffset), end(endOffset), readFailed(false), stopped(false), finished(false), waitMs(0.0),
+        readerThread([this]() { this->readChunks(); })
+    {
+    }
+
+    ~CPakFileChunkReader()
     {
-        // var contains the size of the buffer containing streaming file paths
-        int remainingLength = header()->streamingFilesBufSize;
-        size_t offset = 0;
-        while (remainingLength > 0)
         {
-            const std::string streamingFilePath = header()->GetStreamingFilePaths() + offset;
-            std::filesystem::path fileInfo(streamingFilePath);
+            std::unique_lock<std::mutex> lock(chunkMutex);
+            stopped = true;
+        }
 
-            ParseStreamedFile(fileInfo.filename().string(), false);
-            const int length = static_cast<int>(streamingFilePath.length());
+        chunkCondition.notify_all();
+        // readerThread is joined when it is destroyed
+    }
 
-            // add to offset so we can get the next path on the next iteration
-            offset += static_cast<size_t>(length + 1);
-            // subtract length + 1 from remaining length so we can terminate when the entire buffer has been found
-            remainingLength -= length + 1;
+    // blocks until the next chunk has been read, returns false once the whole range has been read or if reading failed
+    bool next(Chunk_t& chunk)
+    {
+        const auto waitStart = std::chrono::high_resolution_clock::now();
+
+        std::unique_lock<std::mutex> lock(chunkMutex);
+        chunkCondition.wait(lock, [this]() { return !chunks.empty() || finished; });
+
+        waitMs += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - waitStart).count();
+
+        if (chunks.empty())
+            return false;
+
+        chunk = std::move(chunks.front());
+        chunks.pop();
+
+        lock.unlock();
+        chunkCondition.notify_all();
+
+        return true;
+    }
+
+    inline const bool failed() const { return readFailed; };
+
+    // time spent waiting on the disk
+    inline const double waitTime() const { return waitMs; };
+
+private:
+    void readChunks()
+    {
+        while (offset < end)
+        {
+            {
+                std::unique_lock<std::mutex> lock(chunkMutex);
+                chunkCondition.wait(lock, [this]() { return chunks.size() < maxQueuedChunks || stopped; });
+
+                if (stopped)
+                    break;
+            }
+
+            const uint64_t size = std::min(chunkSize, end - offset);
+
+            Chunk_t chunk = { std::make_unique<char[]>(size), size };
+            if (!pFile->read(chunk.data.get(), offset, size))
+            {
+                readFailed = true;
+                break;
+            }
+
+            offset += size;
+
+            {
+                std::unique_lock<std::mutex> lock(chunkMutex);
+                chunks.push(std::move(chunk));
+            }
+
+            chunkCondition.notify_all();
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(chunkMutex);
+            finished = true;
+        }
+
+        chunkCondition.notify_all();
+    }
+
+    const CRandomAccessFile* const pFile;
+    uint64_t offset;
+    const uint64_t end;
+
+    std::queue<Chunk_t> chunks;
+    std::mutex chunkMutex;
+    std::condition_variable chunkCondition;
+
+    std::atomic<bool> readFailed;
+    bool stopped;
+    bool finished;
+
+    double waitMs;
+
+    // last so it is joined before anything it uses is destroyed
+    CThread readerThread;
+};
+
+// decodes an rtech encoded pak while it is read, the decoder picks up where it left off each time more data is available.
+// compressed data goes through a ring buffer, the decoder indexes its input through m_inputMask so it handles the wrap itself
+static bool StreamDecodeRTechPakFile(CPakFileChunkReader& reader, const PakHdr_t* const header, char* const dcmpBuf, const uint64_t fileSize)
+{
+    // the decoder reads up to 16 bytes at a time past its position, keep some padding behind the input buffer
+    constexpr uint64_t inputPadding = 0x40;
+
+    const uint64_t inputSize = std::min(static_cast<uint64_t>(header->cmpSize), fileSize);
+    const uint64_t initSize = std::min(header->pakHdrSize + 0x40, inputSize); // enough for the decoder to read the stream header
+
+    CPakFileChunkReader::Chunk_t chunk = {};
+    if (!reader.next(chunk) || chunk.size < initSize)
+        return false;
+
+    // the stream header tells us how big the blocks are, so set the decoder up from a copy of the start before picking the ring size
+    std::unique_ptr<char[]> initBuf = std::make_unique_for_overwrite<char[]>(initSize + inputPadding);
+    memcpy(initBuf.get(), chunk.data.get(), initSize);
+    memset(initBuf.get() + initSize, 0, inputPadding);
+
+    RTech::PakDecompressContext_t context = {};
+    const uint64_t decodeSize = RTech::InitPakDecoder(&context, reinterpret_cast<const uint8_t*>(initBuf.get()), PAK_DECODE_MASK, header->cmpSize, 0, header->pakHdrSize);
+
+    context.m_outputMask = PAK_DECODE_MASK;
+    context.m_outputBuf = uint64_t(dcmpBuf);
+
+    // the decoder needs a whole compressed block in the buffer before it decodes it, and the ring has to be a multiple of the input block size.
+    // streams that are one big block (or close to it) just get a buffer for the whole file
+    uint64_t ringSize = inputSize;
+    uint64_t ringMask = PAK_DECODE_MASK;
+    if (context.m_inputInvMask != PAK_DECODE_MASK)
+    {
+        const uint64_t blockSize = std::max(context.m_inputInvMask, std::min(context.m_outputInvMask, inputSize)) + 1ull;
+        if (blockSize <= inputSize / 8ull)
+        {
+            uint64_t windowSize = CPakFileChunkReader::chunkSize;
+            while (windowSize < blockSize * 4ull)
+                windowSize <<= 1ull;
+
+            if (windowSize < inputSize)
+            {
+                ringSize = windowSize;
+                ringMask = windowSize - 1ull;
+            }
         }
     }
 
-    // if there are any optional streaming files
-    if (header()->optStreamingFilesBufSize)
+    std::unique_ptr<char[]> inputBuf = std::make_unique_for_overwrite<char[]>(ringSize + inputPadding);
+    memset(inputBuf.get() + ringSize, 0, inputPadding);
+
+    context.m_inputBuf = uint64_t(inputBuf.get());
+    context.m_inputMask = ringMask;
+
+    // copies read data in at its file position, wrapping around the ring
+    const auto writeInput = [&](uint64_t pos, const char* data, uint64_t size)
     {
-        // var contains the size of the buffer containing "opt" streaming file paths
-        int remainingLength = header()->optStreamingFilesBufSize;
-        size_t offset = 0;
-        while (remainingLength > 0)
+        while (size > 0ull)
         {
-            std::string streamingFilePath = header()->GetOptStreamingFilePaths() + offset;
-            std::filesystem::path fileInfo(streamingFilePath);
+            const uint64_t ringPos = pos & ringMask;
+            const uint64_t copySize = std::min(size, ringSize - ringPos);
+            memcpy(inputBuf.get() + ringPos, data, copySize);
 
-            ParseStreamedFile(fileInfo.filename().string(), true);
-            const int length = static_cast<int>(streamingFilePath.length());
+            // reads near the end of the ring run into the padding, mirror the start of the ring there
+            if (ringMask != PAK_DECODE_MASK && ringPos < inputPadding)
+                memcpy(inputBuf.get() + ringSize + ringPos, data, std::min(copySize, inputPadding - ringPos));
 
-            // add to offset so we can get the next path on the next iteration
-            offset += static_cast<size_t>(length + 1);
-            // subtract length + 1 from remaining length so we can terminate when the entire buffer has been found
-            remainingLength -= length + 1;
+            pos += copySize;
+            data += copySize;
+            size -= copySize;
+        }
+    };
+
+    uint64_t numBytesRead = 0ull;
+    uint64_t chunkPos = 0ull;
+    while (true)
+    {
+        if (chunkPos == chunk.size)
+        {
+            if (!reader.next(chunk))
+                return false;
+
+            chunkPos = 0ull;
+        }
+
+        // anything before the decoder's position has been used, so the ring can be filled up to a full lap ahead of it
+        const uint64_t writeLimit = std::min(inputSize, context.m_fileBytePosition + ringSize);
+        const uint64_t copySize = std::min(chunk.size - chunkPos, writeLimit - std::min(writeLimit, numBytesRead));
+
+        writeInput(numBytesRead, chunk.data.get() + chunkPos, copySize);
+        numBytesRead += copySize;
+        chunkPos += copySize;
+
+        // anything in the file past the compressed stream is not needed
+        if (numBytesRead >= inputSize)
+            chunkPos = chunk.size;
+
+        // returns false until it has decoded everything, it only decodes blocks that have been fully read
+        const uint64_t lastFileBytePosition = context.m_fileBytePosition;
+        if (RTech::DecompressPakFile(&context, numBytesRead, decodeSize))
+        {
+            assertm(decodeSize == context.m_decompSize, "mismatch on decode size.");
+            return true;
+        }
+
+        // no room for more data and the decoder is stuck, the ring is too small for this stream
+        if (copySize == 0ull && numBytesRead < inputSize && context.m_fileBytePosition == lastFileBytePosition)
+        {
+            assertm(false, "pak decode window too small.");
+            return false;
         }
     }
+}
 
-    ProcessAssets();
-    return true;
+// decodes an oodle encoded pak straight into the final buffer, only a chunk or so of compressed data is kept around at a time
+static bool StreamDecodeOodlePakFile(CPakFileChunkReader& reader, const PakHdr_t* const header, char* const dcmpBuf)
+{
+    // [rika]: since dcmpSize is the decompresed pakfile's size, we need the decompresed data size, subtract the pakfile header to get it.
+    const uint64_t decodeSize = header->dcmpSize - header->pakHdrSize;
+    char* const decodeBuf = dcmpBuf + header->pakHdrSize;
+
+    OodleLZDecoder* const decoder = OodleLZDecoder_Create(OodleLZ_Compressor::OodleLZ_Compressor_Invalid, decodeSize, nullptr, 0);
+    if (!decoder)
+        return false;
+
+    // compressed data that hasn't been decoded yet, oodle only decodes whole quanta so some data is usually left over
+    std::vector<char> window;
+    window.reserve(CPakFileChunkReader::chunkSize * 2);
+
+    uint64_t outPos = 0ull;
+    bool decodeFailed = false;
+
+    CPakFileChunkReader::Chunk_t chunk;
+    while (outPos < decodeSize && !decodeFailed && reader.next(chunk))
+    {
+        window.insert(window.end(), chunk.data.get(), chunk.data.get() + chunk.size);
+
+        size_t windowPos = 0;
+        while (outPos < decodeSize)
+        {
+            OodleLZ_DecodeSome_Out decodeOut = {};
+            if (!OodleLZDecoder_DecodeSome(decoder, &decodeOut, decodeBuf, outPos, decodeSize, decodeSize - outPos, window.data() + windowPos, window.size() - windowPos, OodleLZ_FuzzSafe_No, OodleLZ_CheckCRC_No, OodleLZ_Verbosity::OodleLZ_Verbosity_None, OodleLZ_Decode_ThreadPhaseAll))
+            {
+                decodeFailed = true;
+                break;
+            }
+
+            // needs more data
+            if (decodeOut.compBufUsed + decodeOut.decodedCount == 0)
+                break;
+
+            outPos += decodeOut.decodedCount;
+            windowPos += decodeOut.compBufUsed;
+        }
+
+        window.erase(window.begin(), window.begin() + windowPos);
+    }
+
+    OodleLZDecoder_Destroy(decoder);
+
+    assertm(decodeFailed || outPos == decodeSize, "mismatch on decode size.");
+    return !decodeFailed && outPos == decodeSize;
 }
-#endif // #if defined(PAKLOAD_PATCHING_V8)  || defined(PAKLOAD_PATCHING_V7)
 
 const bool CPakFile::ParseFromFile(const std::string& filePath, std::shared_ptr<char[]>& buf)
 {
@@ -483,64 +723,228 @@ const bool CPakFile::ParseFromFile(const std::string& filePath, std::shared_ptr<
     Log("parsing pak file from path: ('%s')\n", filePath.c_str());
 #endif // #if (PAKLOAD_DEBUG >= PAKLOAD_DEBUG_LOG)
 
-    if (!FileSystem::ReadFileData(filePath, &buf))
+    const auto readStart = std::chrono::high_resolution_clock::now();
+
+    CRandomAccessFile file;
+    if (!file.open(filePath))
+        return false;
+
+    // read the header first, it tells us if and how the rest of the file is compressed
+    char headerBuf[std::max({ sizeof(PakHdr_v6_t), sizeof(PakHdr_v7_t), sizeof(PakHdr_v8_t) })] = {};
+    const uint64_t headerReadSize = std::min(static_cast<uint64_t>(sizeof(headerBuf)), file.size());
+    if (headerReadSize < sizeof(int) + sizeof(short) || !file.read(headerBuf, 0ull, headerReadSize))
+        return false;
+
+    const short version = reinterpret_cast<const short*>(headerBuf)[2];
+
+    std::unique_ptr<PakHdr_t> header = nullptr;
+    switch (version)
+    {
+    case 6: // no compression on 6
+        break;
+    case 7:
+        header = std::make_unique<PakHdr_t>(reinterpret_cast<const PakHdr_v7_t*>(headerBuf));
+        break;
+    case 8:
+        header = std::make_unique<PakHdr_t>(reinterpret_cast<const PakHdr_v8_t*>(headerBuf));
+        break;
+    default:
+        return false;
+    }
+
+    if (header && (header->magic != pakFileMagic || file.size() < header->pakHdrSize))
+        return false;
+
+    // not compressed, the file is used as it is
+    if (!header || (header->flags & PAK_HEADER_FLAGS_COMPRESSED) == 0)
+    {
+        buf = std::shared_ptr<char[]>(new char[file.size()]);
+        if (!file.read(buf.get(), 0ull, file.size()))
+            return false;
+
+        m_loadTimes.readMs += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - readStart).count();
+        return true;
+    }
+
+    if ((header->flags & (PAK_HEADER_FLAGS_RTECH_ENCODED | PAK_HEADER_FLAGS_OODLE_ENCODED)) == 0)
+    {
+        assertm(false, "zstd compression unsupported");
         return false;
+    }
+
+    // decode straight into the final buffer while the file is being read
+    // no need to clear it, decodes that come up short are rejected
+    std::shared_ptr<char[]> dcmpBuf = std::shared_ptr<char[]>(new char[header->dcmpSize]);
+    memcpy_s(dcmpBuf.get(), header->pakHdrSize, headerBuf, header->pakHdrSize);
+
+    bool decoded = false;
+    double readWaitMs = 0.0;
+    if (header->flags & PAK_HEADER_FLAGS_RTECH_ENCODED) // standard pakfile compression
+    {
+        CPakFileChunkReader reader(&file, 0ull, file.size());
+        decoded = StreamDecodeRTechPakFile(reader, header.get(), dcmpBuf.get(), file.size()) && !reader.failed();
+        readWaitMs = reader.waitTime();
+    }
+    else
+    {
+        CPakFileChunkReader reader(&file, header->pakHdrSize, file.size());
+        decoded = StreamDecodeOodlePakFile(reader, header.get(), dcmpBuf.get()) && !reader.failed();
+        readWaitMs = reader.waitTime();
+    }
 
-    if (!DecompressFileBuffer(buf.get(), &buf))
+    if (!decoded)
         return false;
 
+    buf = dcmpBuf;
+
+    // reading and decoding overlap, so read time is only the time decoding was stalled on the disk.
+    // patch files are read through here as well, so these add up over the whole chain
+    const double totalMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - readStart).count();
+    m_loadTimes.readMs += readWaitMs;
+    m_loadTimes.decompressMs += std::max(totalMs - readWaitMs, 0.0);
+
     return true;
 }
 
-const bool CPakFile::ParseStreamedFile(const std::string& fileName, bool opt)
+std::unique_ptr<StarPak_t> CPakFile::ParseStreamedFile(const std::string& fileName) const
 {
     // The end of the starpak path buffers is padded with null bytes to get back to (8 byte?) alignment
     // This check isn't entirely necessary, as we will fail out of this function with a null path anyway, however
     // this avoids needlessly performing a disk operation to attempt to open the file.
     if (fileName.length() == 0)
-        return false;
+        return nullptr;
 
 #if (PAKLOAD_DEBUG == PAKLOAD_DEBUG_LOG)
     Log("parsing starpak file from path: ('%s')\n", fileName.c_str());
 #endif // #if (PAKLOAD_DEBUG >= PAKLOAD_DEBUG_LOG)
 
-    struct StarPakStreamEntry_t
-    {
-        uint64_t offset;
-        uint64_t size;
-    };
+    const auto startTime = std::chrono::high_resolution_clock::now();
+
     std::unique_ptr<StarPak_t> pakEntry = std::make_unique<StarPak_t>();
 
     std::string path = std::filesystem::path(m_FilePath).parent_path().string().append("\\" + fileName);
-    pakEntry.get()->filePath = path;
+    pakEntry->filePath = path;
 
-    StreamIO file;
-    if (!file.open(path, eStreamIOMode::Read))
+    // keep one shared handle open for the lifetime of the pak so streamed data reads don't reopen the file every time
+    CRandomAccessFile& file = pakEntry->file;
+    if (!file.open(path))
     {
         Log("failed to find starpak file '%s' on disk, assets may be missing data as a result...\n", fileName.c_str());
-        return false;
+        return nullptr;
     }
 
-    file.seek(file.size() - sizeof(uint64_t));
+    g_starpakIOStats.numOpens++;
 
+    // the stream table sits at the end of the file, followed by the entry count
     uint64_t entryCount = 0;
-    file.read(reinterpret_cast<char*>(&entryCount), sizeof(uint64_t));
-    file.seek(file.size() - sizeof(uint64_t) - (sizeof(StarPakStreamEntry_t) * entryCount));
+    if (file.size() < sizeof(uint64_t) || !file.read(&entryCount, file.size() - sizeof(uint64_t), sizeof(uint64_t)))
+    {
+        Log("failed to read starpak file '%s', assets may be missing data as a result...\n", fileName.c_str());
+        return nullptr;
+    }
 
-    for (uint64_t i = 0; i < entryCount; i++)
+    const uint64_t tableSize = sizeof(StarPakStreamEntry_t) * entryCount;
+    if (entryCount > (file.size() - sizeof(uint64_t)) / sizeof(StarPakStreamEntry_t))
     {
-        StarPakStreamEntry_t entry;
-        file.read(reinterpret_cast<char*>(&entry), sizeof(StarPakStreamEntry_t));
+        Log("starpak file '%s' has an invalid stream table, assets may be missing data as a result...\n", fileName.c_str());
+        return nullptr;
+    }
 
-        // [rika]: we should not being adding invalid starpak entries, these only really appear in pak V6 (possibly a bakery issue?)
-        if (entry.size == 0)
-            continue;
+    // read the whole table in one go, big starpaks have hundreds of thousands of entries
+    std::vector<StarPakStreamEntry_t>& entries = pakEntry->streamEntries;
+    entries.resize(entryCount);
 
-        pakEntry.get()->parsedOffsets.emplace(entry.offset, entry.size);
+    if (entryCount > 0 && !file.read(entries.data(), file.size() - sizeof(uint64_t) - tableSize, tableSize))
+    {
+        Log("failed to read stream table from starpak file '%s', assets may be missing data as a result...\n", fileName.c_str());
+        return nullptr;
     }
 
-    opt ? m_vOptStarPaks.emplace_back(std::move(pakEntry)) : m_vStarPaks.emplace_back(std::move(pakEntry));
-    return true;
+    // [rika]: we should not being adding invalid starpak entries, these only really appear in pak V6 (possibly a bakery issue?)
+    std::erase_if(entries, [](const StarPakStreamEntry_t& entry) { return entry.size == 0; });
+
+    // stable so the first entry for a duplicated offset is the one that gets found
+    std::stable_sort(entries.begin(), entries.end(), [](const StarPakStreamEntry_t& a, const StarPakStreamEntry_t& b) { return a.offset < b.offset; });
+    entries.shrink_to_fit();
+
+    // map the whole starpak so streamed data can be used without copying it, the buffered handle above is kept as a fallback
+    if (UtilsConfig->mapStarpaks && !pakEntry->mappedFile.open(path))
+        Log("failed to map starpak file '%s', falling back on buffered reads...\n", fileName.c_str());
+
+    const std::chrono::duration<double, std::milli> loadTime = std::chrono::high_resolution_clock::now() - startTime;
+    Log("loaded starpak file '%s' (%llu entries) in %.3fms\n", fileName.c_str(), entries.size(), loadTime.count());
+
+    return pakEntry;
+}
+
+void CPakFile::ParseStreamedFiles(const char* const streamingFilePaths, const int streamingFilesBufSize, const char* const optStreamingFilePaths, const int optStreamingFilesBufSize)
+{
+    struct StreamedFileLoad_t
+    {
+        std::string fileName;
+        bool opt;
+
+        std::unique_ptr<StarPak_t> pakEntry;
+    };
+
+    std::vector<StreamedFileLoad_t> streamedFiles;
+
+    const auto addStreamedFiles = [&streamedFiles](const char* const filePaths, const int bufSize, const bool opt)
+    {
+        // var contains the size of the buffer containing streaming file paths
+        int remainingLength = bufSize;
+        size_t offset = 0;
+        while (remainingLength > 0)
+        {
+            const std::string streamingFilePath = filePaths + offset;
+            const int length = static_cast<int>(streamingFilePath.length());
+
+            // padding at the end of the buffer shows up as empty paths
+            if (length > 0)
+                streamedFiles.push_back({ std::filesystem::path(streamingFilePath).filename().string(), opt, nullptr });
+
+            // add to offset so we can get the next path on the next iteration
+            offset += static_cast<size_t>(length + 1);
+            // subtract length + 1 from remaining length so we can terminate when the entire buffer has been found
+            remainingLength -= length + 1;
+        }
+    };
+
+    addStreamedFiles(streamingFilePaths, streamingFilesBufSize, false);
+    addStreamedFiles(optStreamingFilePaths, optStreamingFilesBufSize, true);
+
+    if (streamedFiles.empty())
+        return;
+
+    // starpaks are independent from each other, so load all of them at once
+    if (streamedFiles.size() == 1)
+    {
+        streamedFiles.front().pakEntry = ParseStreamedFile(streamedFiles.front().fileName);
+    }
+    else
+    {
+        CParallelTask parallelLoadTask(std::min(static_cast<uint32_t>(streamedFiles.size()), CThread::GetConCurrentThreads()));
+
+        for (StreamedFileLoad_t& streamedFile : streamedFiles)
+        {
+            parallelLoadTask.addTask([this, &streamedFile]
+                {
+                    streamedFile.pakEntry = ParseStreamedFile(streamedFile.fileName);
+                }, 1u);
+        }
+
+        parallelLoadTask.execute();
+        parallelLoadTask.wait();
+    }
+
+    // add in the order they are listed in the pak, assets index into these lists
+    for (StreamedFileLoad_t& streamedFile : streamedFiles)
+    {
+        if (!streamedFile.pakEntry)
+            continue;
+
+        streamedFile.opt ? m_vOptStarPaks.emplace_back(std::move(streamedFile.pakEntry)) : m_vStarPaks.emplace_back(std::move(streamedFile.pakEntry));
+    }
 }
 
 const bool CPakFile::DecompressFileBuffer(const char* fileBuffer, std::shared_ptr<char[]>* outBuffer)
@@ -949,16 +1353,16 @@ static std::unordered_map<AssetType_t, std::string> s_ParsedPrefixes(63);
 
 void CPakFile::ProcessAssets()
 {
+    const auto processStart = std::chrono::high_resolution_clock::now();
+
     // prepare the parallel task with max threads to be used.
     const uint32_t threadCount = UtilsConfig->parseThreadCount;
     CParallelTask parallelLoadTask(threadCount);
     CParallelTask parallelProcessTask(threadCount);
 
-    std::mutex assetMutex;
-
     // atomic int will ensure we aren't processing the same asset multiple times.
     std::atomic<uint32_t> assetIdx = 0;
-    parallelProcessTask.addTask([this, &assetIdx, &assetMutex, &parallelLoadTask]
+    parallelProcessTask.addTask([this, &assetIdx, &parallelLoadTask]
     {
         const uint32_t cpyAssetCount = static_cast<uint32_t>(assetCount());
         while (assetIdx < cpyAssetCount)
@@ -987,10 +1391,9 @@ void CPakFile::ProcessAssets()
                         it->second.loadFunc(this, asset);
                 }
             }, 1u);
-            
-            // mutex so we can write to m_pakAssets safely.
-            std::lock_guard<std::mutex> lock(assetMutex);
-            g_assetData.v_assets.push_back({ pAsset->guid, asset });
+
+            // locks internally so we can add to the asset list and guid index safely.
+            g_assetData.AddAsset(pAsset->guid, asset);
         }
     }, threadCount);
 
@@ -1013,28 +1416,36 @@ void CPakFile::ProcessAssets()
     parallelLoadTask.execute();
 
     // we pre-sort each pak for post load callbacks by certain priority order.
-    std::sort(g_assetData.v_assets.begin(), g_assetData.v_assets.end(), [](const CGlobalAssetData::AssetLookup_t& a, const CGlobalAssetData::AssetLookup_t& b)
+    // other paks may be adding assets while this one sorts, so hold the asset list lock.
     {
-        const auto itA = std::find(postLoadOrder.begin(), postLoadOrder.end(), a.m_asset->GetAssetType());
-        const auto itB = std::find(postLoadOrder.begin(), postLoadOrder.end(), b.m_asset->GetAssetType());
-
-        // if both types are found in the custom order, compare their positions.
-        if (itA != postLoadOrder.end() && itB != postLoadOrder.end())
+        std::unique_lock<std::shared_mutex> sortLock(g_assetData.m_assetIndexMutex);
+        std::sort(g_assetData.v_assets.begin(), g_assetData.v_assets.end(), [](const CGlobalAssetData::AssetLookup_t& a, const CGlobalAssetData::AssetLookup_t& b)
         {
-            return std::distance(postLoadOrder.begin(), itA) < std::distance(postLoadOrder.begin(), itB);
-        }
+            const auto itA = std::find(postLoadOrder.begin(), postLoadOrder.end(), a.m_asset->GetAssetType());
+            const auto itB = std::find(postLoadOrder.begin(), postLoadOrder.end(), b.m_asset->GetAssetType());
 
-        // handle cases where types are not in the custom order.
-        if (itA == postLoadOrder.end())
-        {
-            return false; // 'a' is placed after 'b'.
-        }
-        else 
-        {
-            return true; // 'b' is placed after 'a'.
-        }
-    });
+            // if both types are found in the custom order, compare their positions.
+            if (itA != postLoadOrder.end() && itB != postLoadOrder.end())
+            {
+                return std::distance(postLoadOrder.begin(), itA) < std::distance(postLoadOrder.begin(), itB);
+            }
+
+            // handle cases where types are not in the custom order.
+            if (itA == postLoadOrder.end())
+            {
+                return false; // 'a' is placed after 'b'.
+            }
+            else 
+            {
+                return true; // 'b' is placed after 'a'.
+            }
+        });
+
+        g_assetData.RebuildAssetGuidIndex();
+    }
 
     parallelLoadTask.wait();
     g_pImGuiHandler->FinishProgressBarEvent(loadAssetsEvent);
+
+    m_loadTimes.processMs += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - processStart).count();
 }
@@ -600,12 +600,105 @@ union AssetPtr_t
     char* ptr;
 };
 
+struct StarPakStreamEntry_t
+{
+    uint64_t offset;
+    uint64_t size;
+};
+
 struct StarPak_t
 {
-    std::unordered_map<uint64_t, size_t> parsedOffsets;
+    // stream table from the end of the starpak, sorted by offset
+    std::vector<StarPakStreamEntry_t> streamEntries;
     std::string filePath;
+
+    // opened once when the starpak is parsed and closed with the owning pak, shared by every asset reading from this starpak
+    CRandomAccessFile file;
+
+    // only mapped when starpak mapping is enabled, streamed data is read straight out of this view when it is open
+    CMappedFile mappedFile;
+
+    const StarPakStreamEntry_t* const FindStreamEntry(const uint64_t offset) const
+    {
+        const auto it = std::lower_bound(streamEntries.begin(), streamEntries.end(), offset, [](const StarPakStreamEntry_t& entry, const uint64_t value) { return entry.offset < value; });
+        if (it == streamEntries.end() || it->offset != offset)
+            return nullptr;
+
+        return &*it;
+    }
+};
+
+// read only view of asset data, either pointing into memory that outlives the view (pak pages, mapped starpaks)
+// or owning a buffer that was allocated for it (buffered starpak reads, decompressed data)
+struct AssetDataView_t
+{
+    AssetDataView_t() : data(nullptr), size(0ull) {};
+    AssetDataView_t(const char* const ptr, const uint64_t len) : data(ptr), size(len) {};
+    AssetDataView_t(std::unique_ptr<char[]> buf, const uint64_t len) : data(buf.get()), size(len), owned(std::move(buf)) {};
+
+    const char* data;
+    uint64_t size;
+
+    std::unique_ptr<char[]> owned;
+
+    inline const bool IsValid() const { return data != nullptr; };
+    inline const bool IsOwned() const { return owned != nullptr; };
+
+    // get a buffer that can be freely modified, only copies if the data is not already ours
+    std::unique_ptr<char[]> Release()
+    {
+        if (!data)
+            return nullptr;
+
+        if (!owned)
+        {
+            owned = std::make_unique<char[]>(size);
+            memcpy(owned.get(), data, size);
+        }
+
+        data = nullptr;
+        size = 0ull;
+
+        return std::move(owned);
+    }
+};
+
+// counters for starpak disk access, so we can see how much io loading and exporting actually does
+struct StarPakIOStats_t
+{
+    std::atomic<uint64_t> numOpens;
+    std::atomic<uint64_t> numReads;
+    std::atomic<uint64_t> numBytesRead;
+    std::atomic<uint64_t> numBytesMapped; // served from a memory mapped starpak, no read was issued for these
+
+    inline void RecordRead(const uint64_t size)
+    {
+        numReads++;
+        numBytesRead += size;
+    }
+
+    inline void RecordMappedAccess(const uint64_t size)
+    {
+        numBytesMapped += size;
+    }
+
+    inline void Reset()
+    {
+        numOpens = 0ull;
+        numReads = 0ull;
+        numBytesRead = 0ull;
+        numBytesMapped = 0ull;
+    }
+
+    inline void LogStats(const char* const context) const
+    {
+        Log("%s: starpak io: %llu opens, %llu reads, %llu bytes read, %llu bytes mapped\n", context, numOpens.load(), numReads.load(), numBytesRead.load(), numBytesMapped.load());
+        UNUSED(context);
+    }
 };
 
+extern StarPakIOStats_t g_starpakIOStats;
+
 #if defined(PAKLOAD_PATCHING_ANY)
 struct SegmentCollection_t
 {
@@ -647,6 +740,14 @@ struct PakLoadedAssetTypeInfo_t
 };
 #endif // #if defined(PAKLOAD_PATCHING_ANY)
 
+// time spent in each stage of loading a pak, read and decompress include any patch files in the chain
+struct PakLoadTimes_t
+{
+    double readMs = 0.0;
+    double decompressMs = 0.0;
+    double processMs = 0.0;
+};
+
 class CPakFile : public CAssetContainer
 {
 public:
@@ -655,7 +756,17 @@ public:
 
     const CAsset::ContainerType GetContainerType() const { return CAsset::ContainerType::PAK; };
 
+    // header fields that are needed before a pak is loaded
+    struct FileHeaderInfo_t
+    {
+        uint64_t crc;
+        uint64_t dcmpSize;
+        short patchCount;
+    };
+
+    // the pak's crc should already have been claimed with CGlobalAssetData::ClaimPakLoad, see ReadFileHeaderInfo
     const bool ParseFileBuffer(const std::string& path);
+    static const bool ReadFileHeaderInfo(const std::string& path, FileHeaderInfo_t* const info); // only reads the header
     static const bool DecompressFileBuffer(const char* fileBuffer, std::shared_ptr<char[]>* outBuffer);
 
 #if defined(PAKLOAD_PATCHING_ANY)
@@ -788,11 +899,14 @@ private:
 
     std::shared_ptr<char[]> m_Buf;
 
+    PakLoadTimes_t m_loadTimes;
+
 private:
 
     // Populates CPakFile members from file
     const bool ParseFromFile(const std::string& filePath, std::shared_ptr<char[]>& buf);
-    const bool ParseStreamedFile(const std::string& fileName, bool opt);
+    std::unique_ptr<StarPak_t> ParseStreamedFile(const std::string& fileName) const;
+    void ParseStreamedFiles(const char* const streamingFilePaths, const int streamingFilesBufSize, const char* const optStreamingFilePaths, const int optStreamingFilesBufSize);
 
 #if defined(PAKLOAD_PATCHING_ANY)
     void ParsePatchEditStream();
@@ -832,6 +946,7 @@ private:
 
 public:
     inline PakHdr_t* header() const { return m_pHeader; };
+    inline const PakLoadTimes_t& loadTimes() const { return m_loadTimes; };
     inline PakAsset_t* internalAssets() const { return m_pAssetsInternal; };
     inline void* rawAsset(const size_t idx) const { return reinterpret_cast<char*>(m_pAssetsRaw) + (header()->pakAssetSize * idx); }
     inline StarPak_t* getStarPak(int idx, bool opt) const
@@ -1067,6 +1182,9 @@ private:
 
     std::shared_ptr<void> m_ExtraData;
 
+    // starpak bytes actually read from disk for this asset, whichever thread asked for them
+    mutable std::atomic<uint64_t> m_starpakBytesRead = 0ull;
+
     // indicates whether this asset has been exported successfully since it was loaded
     // stores the result of whether the last export attempt succeeded
     //bool m_exported;
@@ -1105,6 +1223,8 @@ public:
 
     const int version() { return data()->version; };
 
+    const uint64_t GetStarPakBytesRead() const { return m_starpakBytesRead.load(); };
+
 
     PakAsset_t* const data() { return static_cast<PakAsset_t*>(m_assetData); };
     const PakAsset_t* const data() const { return static_cast<const PakAsset_t*>(m_assetData); };
@@ -1185,11 +1305,11 @@ public:
             return {};
 
         const __int64 seek = opt ? optStarpakOffset() : starpakOffset();
-        const auto it = pakEntry->parsedOffsets.find(seek);
-        if (it == pakEntry->parsedOffsets.end())
+        const StarPakStreamEntry_t* const entry = pakEntry->FindStreamEntry(seek);
+        if (!entry)
             return {};
 
-        return { { it->first, it->second } };
+        return { { entry->offset, entry->size } };
     }
 
     std::unique_ptr<char[]> getStarPakData(const uint64_t offset, const uint64_t size, const bool opt) const
@@ -1201,18 +1321,55 @@ public:
         assertm(offset > 0, "starpak offset can't be zero.");
         assertm(size > 0, "starpak size can't be zero.");
 
-        StreamIO file;
-        if (!file.open(pakEntry->filePath, eStreamIOMode::Read))
-            return nullptr;
+        // copy out of the mapping if we have one, it's already paged in if the data was read before
+        if (pakEntry->mappedFile.contains(offset, size))
+        {
+            std::unique_ptr<char[]> data(new char[size]);
+            memcpy(data.get(), pakEntry->mappedFile.data() + offset, size);
+
+            g_starpakIOStats.RecordMappedAccess(size);
+
+            return data;
+        }
 
-        file.seek(offset);
+        // handle is opened once in CPakFile::ParseStreamedFile, if it failed there is no point trying again
+        if (!pakEntry->file.isOpen())
+            return nullptr;
 
         std::unique_ptr<char[]> data(new char[size]);
-        file.read(data.get(), size);
+        if (!pakEntry->file.read(data.get(), offset, size))
+        {
+            assertm(false, "failed to read starpak data.");
+            return nullptr;
+        }
+
+        g_starpakIOStats.RecordRead(size);
+        m_starpakBytesRead += size;
 
         return data;
     }
 
+    // same as getStarPakData, but hands out a view straight into the starpak when it is memory mapped instead of copying
+    AssetDataView_t getStarPakView(const uint64_t offset, const uint64_t size, const bool opt) const
+    {
+        const StarPak_t* const pakEntry = getStarPak(opt);
+        if (!pakEntry)
+            return {};
+
+        if (pakEntry->mappedFile.contains(offset, size))
+        {
+            g_starpakIOStats.RecordMappedAccess(size);
+
+            return AssetDataView_t(pakEntry->mappedFile.data() + offset, size);
+        }
+
+        // fall back on a buffered read
+        return AssetDataView_t(getStarPakData(offset, size, opt), size);
+    }
+
+    // crc of the pak this asset was loaded from, changes whenever the pak is rebuilt
+    uint64_t getPakCRC() const { return pak()->header()->crc; };
+
     const char* getStarPakName(const bool opt) const
     {
         const StarPak_t* const pakEntry = getStarPak(opt);
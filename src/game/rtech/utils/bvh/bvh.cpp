@@ -302,6 +302,7 @@ inline Vector normal(Vector p1, Vector p2, Vector p3) {
 bool CollisionModel_t::exportSTL(const std::filesystem::path& outPath)
 {
 	std::ofstream out(outPath, std::ios::out | std::ios::binary);
+	RecordExportOutput(outPath);
 
 	if (!out.is_open())
 		return false;
@@ -363,6 +364,7 @@ bool CollisionModel_t::exportSTL(const std::filesystem::path& outPath)
 bool CollisionModel_t::exportOBJ(const std::filesystem::path& outFile)
 {
 	std::ofstream out(outFile, std::ios::out | std::ios::binary);
+	RecordExportOutput(outFile);
 
 	if (!out.is_open())
 		return false;
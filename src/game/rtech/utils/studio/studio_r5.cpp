@@ -317,7 +317,7 @@ namespace r5
 	//
 
 	// uses base datapoints with offsets and interps to get the proper values
-	void CalcBoneQuaternion_DP(const int sectionlength, const uint8_t** panimtrack, const float fFrame, Quaternion& q)
+	void CalcBoneQuaternion_DP(const int sectionlength, const uint8_t** panimtrack, const float fFrame, Quaternion& q, DatapointCursor_t* const cursor)
 	{
 		const uint8_t* ptrack = *reinterpret_cast<const uint8_t** const>(panimtrack);
 
@@ -342,7 +342,7 @@ namespace r5
 		uint32_t remainingFrames = 0;
 
 		const uint32_t prevTarget = prevFrame;
-		CalcBoneSeek_DP(pPackedData, validIdx, remainingFrames, /*valid,*/ prevTarget);
+		CalcBoneSeekCursor_DP(pPackedData, cursor, validIdx, remainingFrames, prevTarget);
 
 		Quaternion q1;
 		AnimQuat32::Unpack(q1, pPackedData[validIdx], &pAxisFixup[prevFrame]);
@@ -457,7 +457,7 @@ namespace r5
 		*panimtrack = reinterpret_cast<const uint8_t*>(pAxisFixup + total);
 	}
 
-	void CalcBonePosition_DP(const int sectionlength, const uint8_t** panimtrack, const float fFrame, Vector& pos)
+	void CalcBonePosition_DP(const int sectionlength, const uint8_t** panimtrack, const float fFrame, Vector& pos, DatapointCursor_t* const cursor)
 	{
 		const uint8_t* ptrack = *reinterpret_cast<const uint8_t** const>(panimtrack);
 
@@ -490,7 +490,7 @@ namespace r5
 		uint32_t remainingFrames = 0;
 
 		const uint32_t prevTarget = prevFrame;
-		CalcBoneSeek_DP(pPackedData, validIdx, remainingFrames, /*valid,*/ prevTarget);
+		CalcBoneSeekCursor_DP(pPackedData, cursor, validIdx, remainingFrames, prevTarget);
 
 		Vector pos1;
 		AnimPos64::Unpack(pos1, pPackedData[validIdx], &pAxisFixup[prevFrame]);
@@ -592,9 +592,17 @@ namespace r5
 		const float scaleComponent = scaleFac ? 0.011048543f : 0.0055242716f;
 		const float scaleFixup = static_cast<float>(1 << scaleFac) * 0.000021924432f;
 
-		const float axis0 = ((static_cast<float>(packedQuat.value0) + 0.5f) * scaleComponent) + (static_cast<float>(axisFixup->adjustment[0]) * scaleFixup);
-		const float axis1 = ((static_cast<float>(packedQuat.value1) + 0.5f) * scaleComponent) + (static_cast<float>(axisFixup->adjustment[1]) * scaleFixup);
-		const float axis2 = ((static_cast<float>(packedQuat.value2) + 0.5f) * scaleComponent) + (static_cast<float>(axisFixup->adjustment[2]) * scaleFixup);
+		// ((value + 0.5) * scaleComponent) + (adjustment * scaleFixup) for all three axes at once, same operations in the same order as doing them one by one
+		const __m128 simd_values = _mm_cvtepi32_ps(_mm_setr_epi32(packedQuat.value0, packedQuat.value1, packedQuat.value2, 0));
+		const __m128 simd_adjustment = _mm_cvtepi32_ps(_mm_setr_epi32(axisFixup->adjustment[0], axisFixup->adjustment[1], axisFixup->adjustment[2], 0));
+		const __m128 simd_axis = AddSIMD(MulSIMD(AddSIMD(simd_values, simd_Four_PointFives), ReplicateX4(scaleComponent)), MulSIMD(simd_adjustment, ReplicateX4(scaleFixup)));
+
+		alignas(16) float axis[4];
+		_mm_store_ps(axis, simd_axis);
+
+		const float axis0 = axis[0];
+		const float axis1 = axis[1];
+		const float axis2 = axis[2];
 
 		float droppedComponent = 0.0f;
 
@@ -654,8 +662,16 @@ namespace r5
 	{
 		const float scaleFac = static_cast<float>(packedPos.scaleFactor + 1);
 
-		pos.x = ((static_cast<float>(axisFixup->adjustment[0]) / 100.0f) + static_cast<float>(packedPos.values[0])) * scaleFac;
-		pos.y = ((static_cast<float>(axisFixup->adjustment[1]) / 100.0f) + static_cast<float>(packedPos.values[1])) * scaleFac;
-		pos.z = ((static_cast<float>(axisFixup->adjustment[2]) / 100.0f) + static_cast<float>(packedPos.values[2])) * scaleFac;
+		// ((adjustment / 100) + value) * scaleFac for all three axes at once
+		const __m128 simd_values = _mm_cvtepi32_ps(_mm_setr_epi32(packedPos.values[0], packedPos.values[1], packedPos.values[2], 0));
+		const __m128 simd_adjustment = _mm_cvtepi32_ps(_mm_setr_epi32(axisFixup->adjustment[0], axisFixup->adjustment[1], axisFixup->adjustment[2], 0));
+		const __m128 simd_pos = MulSIMD(AddSIMD(_mm_div_ps(simd_adjustment, ReplicateX4(100.0f)), simd_values), ReplicateX4(scaleFac));
+
+		alignas(16) float axis[4];
+		_mm_store_ps(axis, simd_pos);
+
+		pos.x = axis[0];
+		pos.y = axis[1];
+		pos.z = axis[2];
 	}
 }
\ No newline at end of file
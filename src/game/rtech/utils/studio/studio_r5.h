@@ -169,9 +169,23 @@ namespace r5
 	void CalcBonePosition(int frame, float s, const mstudio_rle_anim_t* panim, Vector& pos);
 	void CalcBoneScale(int frame, float s, const mstudio_rle_anim_t* panim, Vector& scale, const uint8_t boneFlags);
 
+	// [rika]: where the last seek through a track's datapoints ended up
+	// decoding frames in order with one of these per track only walks the datapoints once, instead of seeking from the first one every frame
+	struct DatapointCursor_t
+	{
+		int validIdx = 0;
+		uint32_t baseFrame = 0u; // first frame covered by the datapoint at validIdx
+
+		inline void Reset()
+		{
+			validIdx = 0;
+			baseFrame = 0u;
+		}
+	};
+
 	// uses 'datapoints' and interpolates from them
-	void CalcBoneQuaternion_DP(int sectionlength, const uint8_t** panimtrack, float fFrame, Quaternion& q);
-	void CalcBonePosition_DP(int sectionlength, const uint8_t** panimtrack, float fFrame, Vector& pos);
+	void CalcBoneQuaternion_DP(int sectionlength, const uint8_t** panimtrack, float fFrame, Quaternion& q, DatapointCursor_t* const cursor = nullptr);
+	void CalcBonePosition_DP(int sectionlength, const uint8_t** panimtrack, float fFrame, Vector& pos, DatapointCursor_t* const cursor = nullptr);
 	void CalcBonePositionVirtual_DP(const int sectionlength, const uint8_t** panimtrack, const float fFrame, Vector& pos);
 	void CalcBoneScale_DP(const int sectionlength, const uint8_t** panimtrack, const float fFrame, Vector& scale);
 
@@ -225,6 +239,29 @@ namespace r5
 		}
 	}
 
+	// [rika]: same result as seeking from the first datapoint, but picks up from the cursor if the target is at or past it
+	template<class PackedType>
+	__forceinline void CalcBoneSeekCursor_DP(const PackedType* const pPackedData, DatapointCursor_t* const cursor, int& validIdx, uint32_t& remainingFrames, const uint32_t targetFrame)
+	{
+		if (!cursor)
+		{
+			validIdx = 0;
+			CalcBoneSeek_DP(pPackedData, validIdx, remainingFrames, targetFrame);
+
+			return;
+		}
+
+		// frames went backwards, start over
+		if (targetFrame < cursor->baseFrame)
+			cursor->Reset();
+
+		validIdx = cursor->validIdx;
+		CalcBoneSeek_DP(pPackedData, validIdx, remainingFrames, targetFrame - cursor->baseFrame);
+
+		cursor->validIdx = validIdx;
+		cursor->baseFrame = targetFrame - remainingFrames;
+	}
+
 	template<class IndexType, class PackedType>
 	__forceinline void CalcBoneInterpFrames_DP(int& prevFrame, int& nextFrame, float& s, const float fFrame, const IndexType total, const int sectionlength, const IndexType* const pFrameIndices, const PackedType** const pPackedData)
 	{
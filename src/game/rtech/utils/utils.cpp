@@ -2247,6 +2247,18 @@ bool RTech::DecompressSnowflake(int64_t param_buffer, uint64_t data_size, uint64
 #pragma warning(pop)
 
 std::unique_ptr<char[]> RTech::DecompressStreamedBuffer(std::unique_ptr<char[]> buf, uint64_t& bufSize, const eCompressionType compType)
+{
+    std::unique_ptr<char[]> outBuf = DecompressStreamedBuffer(static_cast<const char*>(buf.get()), bufSize, compType);
+
+    // oodle data that turns out to not be compressed is passed back as it was
+    if (!outBuf && compType == eCompressionType::OODLE)
+        return std::move(buf);
+
+    return std::move(outBuf);
+}
+
+// input buffer is only read from, so this can decode straight out of mapped starpaks and pak pages
+std::unique_ptr<char[]> RTech::DecompressStreamedBuffer(const char* const buf, uint64_t& bufSize, const eCompressionType compType)
 {
     switch (compType)
     {
@@ -2260,11 +2272,11 @@ std::unique_ptr<char[]> RTech::DecompressStreamedBuffer(std::unique_ptr<char[]>
         // Check if we are compressed first.
         OodleLZ_DecodeSome_Out decodeOut = {};
         std::unique_ptr<char[]> outBuf = std::make_unique<char[]>(bufSize);
-        if (!OodleLZDecoder_DecodeSome(decoder, &decodeOut, outBuf.get(), outPos, bufSize, bufSize - outPos, buf.get() + bufPos, bufSize - bufPos, OodleLZ_FuzzSafe_No, OodleLZ_CheckCRC_No, OodleLZ_Verbosity::OodleLZ_Verbosity_None, OodleLZ_Decode_ThreadPhaseAll))
+        if (!OodleLZDecoder_DecodeSome(decoder, &decodeOut, outBuf.get(), outPos, bufSize, bufSize - outPos, buf + bufPos, bufSize - bufPos, OodleLZ_FuzzSafe_No, OodleLZ_CheckCRC_No, OodleLZ_Verbosity::OodleLZ_Verbosity_None, OodleLZ_Decode_ThreadPhaseAll))
         {
             // Not decompressed.
             OodleLZDecoder_Destroy(decoder);
-            return std::move(buf);
+            return nullptr;
         }
 
         // We already have an initial amount of decompressed data due to the first run.
@@ -2282,7 +2294,7 @@ std::unique_ptr<char[]> RTech::DecompressStreamedBuffer(std::unique_ptr<char[]>
                 break;
 
             // Continue decompressing.
-            OodleLZDecoder_DecodeSome(decoder, &decodeOut, outBuf.get(), outPos, bufSize, bufSize - outPos, buf.get() + bufPos, bufSize - bufPos, OodleLZ_FuzzSafe_No, OodleLZ_CheckCRC_No, OodleLZ_Verbosity::OodleLZ_Verbosity_None, OodleLZ_Decode_ThreadPhaseAll);
+            OodleLZDecoder_DecodeSome(decoder, &decodeOut, outBuf.get(), outPos, bufSize, bufSize - outPos, buf + bufPos, bufSize - bufPos, OodleLZ_FuzzSafe_No, OodleLZ_CheckCRC_No, OodleLZ_Verbosity::OodleLZ_Verbosity_None, OodleLZ_Decode_ThreadPhaseAll);
         }
 
         OodleLZDecoder_Destroy(decoder);
@@ -2291,7 +2303,7 @@ std::unique_ptr<char[]> RTech::DecompressStreamedBuffer(std::unique_ptr<char[]>
 	case eCompressionType::PAKFILE:
 	{
 		RTech::PakDecompressContext_t context = {};
-		const uint64_t decodeSize = RTech::InitPakDecoder(&context, reinterpret_cast<uint8_t*>(buf.get()), PAK_DECODE_MASK, bufSize, 0, 0); // We don't want to skip any data here, hence why no headerSize.
+		const uint64_t decodeSize = RTech::InitPakDecoder(&context, reinterpret_cast<const uint8_t*>(buf), PAK_DECODE_MASK, bufSize, 0, 0); // We don't want to skip any data here, hence why no headerSize.
 
 		std::unique_ptr<char[]> outBuf = std::make_unique<char[]>(decodeSize);
 		context.m_outputMask = PAK_DECODE_MASK;
@@ -2305,7 +2317,7 @@ std::unique_ptr<char[]> RTech::DecompressStreamedBuffer(std::unique_ptr<char[]>
 	case eCompressionType::SNOWFLAKE: // Snowflake will be made prettier when it's working.
 	{
 		std::unique_ptr<char[]> decompState = std::make_unique<char[]>(0x25000);
-		InitSnowflakeDecompState((long long)&decompState.get()[0], reinterpret_cast<int64_t>(buf.get()), bufSize);
+		InitSnowflakeDecompState((long long)&decompState.get()[0], reinterpret_cast<int64_t>(buf), bufSize);
 
 		__int64* editDecompState = (__int64*)&decompState.get()[0];
 		__int64 decodeSize = editDecompState[0x48D3];
@@ -192,6 +192,8 @@ public:
     static __int64 sub_7FF7FC23CD20(unsigned __int8* param_buffer, unsigned int a2);
 
     static std::unique_ptr<char[]> DecompressStreamedBuffer(std::unique_ptr<char[]> buf, uint64_t& bufSize, const eCompressionType compType);
+    // returns nullptr if the data could not be decoded, for oodle this includes data that was never compressed
+    static std::unique_ptr<char[]> DecompressStreamedBuffer(const char* const buf, uint64_t& bufSize, const eCompressionType compType);
 
     static uint64_t __fastcall StringToGuid(const char* str);
     static uint32_t __fastcall StringToUIMGHash(const char* str);
@@ -19,6 +19,13 @@
 #include <functional>
 #include <ranges>
 #include <mutex>
+#include <shared_mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <deque>
+#include <list>
+#include <chrono>
 
 #include <core/utils/utils_general.h>
 #include <core/utils/fileio.h>
@@ -4,6 +4,7 @@
 
 #include <game/rtech/cpakfile.h>
 #include <game/rtech/utils\utils.h>
+#include <core/cache/spillcache.h>
 
 #define ImGuiReadSetting(str, var, a)  if (sscanf_s(line, str, &a) == 1) { var = a; }
 
@@ -77,6 +78,16 @@ static void UtilSettings_ReadLine(ImGuiContext* const ctx, ImGuiSettingsHandler*
         uint32_t i;
         ImGuiReadSetting("ExportThreads=%u", cfg->exportThreadCount, i);
         ImGuiReadSetting("ParseThreads=%u", cfg->parseThreadCount, i);
+        ImGuiReadSetting("MapStarpaks=%u", cfg->mapStarpaks, i);
+        ImGuiReadSetting("ParsedDataStorage=%u", cfg->parsedDataStorage, i);
+        ImGuiReadSetting("ParsedDataBudget=%u", cfg->parsedDataBudget, i);
+        ImGuiReadSetting("ParsedDataSpillBudget=%u", cfg->parsedDataSpillBudget, i);
+
+        if (cfg->parsedDataStorage >= eRamenStorage::RAMEN_STORAGE_COUNT)
+            cfg->parsedDataStorage = eRamenStorage::RAMEN_STORAGE_AUTO;
+
+        CRamen::SetStoragePolicy(static_cast<eRamenStorage>(cfg->parsedDataStorage), static_cast<size_t>(cfg->parsedDataBudget) << 20ull);
+        g_spillCache.SetBudget(static_cast<size_t>(cfg->parsedDataSpillBudget) << 20ull);
     }
 }
 
@@ -88,6 +99,10 @@ static void UtilSettings_WriteAll(ImGuiContext* const ctx, ImGuiSettingsHandler*
     buf->appendf("[%s][utils]\n", handler->TypeName );
     buf->appendf("ExportThreads=%u\n", UtilsConfig->exportThreadCount);
     buf->appendf("ParseThreads=%u\n", UtilsConfig->parseThreadCount);
+    buf->appendf("MapStarpaks=%u\n", UtilsConfig->mapStarpaks);
+    buf->appendf("ParsedDataStorage=%u\n", UtilsConfig->parsedDataStorage);
+    buf->appendf("ParsedDataBudget=%u\n", UtilsConfig->parsedDataBudget);
+    buf->appendf("ParsedDataSpillBudget=%u\n", UtilsConfig->parsedDataSpillBudget);
     buf->append("\n");
 }
 
@@ -116,9 +131,12 @@ static void ExportSettings_ReadLine(ImGuiContext* const ctx, ImGuiSettingsHandle
         ImGuiReadSetting("ExportRigSequences=%i",           settings->exportRigSequences, i);
         ImGuiReadSetting("ExportModelSkin=%i",              settings->exportModelSkin, i);
         ImGuiReadSetting("ExportMaterialTextures=%i",       settings->exportMaterialTextures, i);
+        ImGuiReadSetting("ExportSkipUnchanged=%i",          settings->exportSkipUnchanged, i);
 
         ImGuiReadSetting("ExportTextureNameSetting=%i",     settings->exportTextureNameSetting, i);
+        ImGuiReadSetting("ExportModelLodSetting=%i",        settings->exportModelLodSetting, i);
         ImGuiReadSetting("ExportNormalRecalcSetting=%i",    settings->exportNormalRecalcSetting, i);
+        ImGuiReadSetting("ExportPngCompressionSetting=%i",  settings->exportPngCompressionSetting, i);
     }
 }
 
@@ -134,9 +152,12 @@ static void ExportSettings_WriteAll(ImGuiContext* const ctx, ImGuiSettingsHandle
     buf->appendf("ExportRigSequences=%i\n",         g_ExportSettings.exportRigSequences);
     buf->appendf("ExportModelSkin=%i\n",            g_ExportSettings.exportModelSkin);
     buf->appendf("ExportMaterialTextures=%i\n",     g_ExportSettings.exportMaterialTextures);
+    buf->appendf("ExportSkipUnchanged=%i\n",        g_ExportSettings.exportSkipUnchanged);
 
     buf->appendf("ExportTextureNameSetting=%i\n",   g_ExportSettings.exportTextureNameSetting);
+    buf->appendf("ExportModelLodSetting=%i\n",      g_ExportSettings.exportModelLodSetting);
     buf->appendf("ExportNormalRecalcSetting=%i\n",  g_ExportSettings.exportNormalRecalcSetting);
+    buf->appendf("ExportPngCompressionSetting=%i\n", g_ExportSettings.exportPngCompressionSetting);
 
     // [rika]: there is no reason the other settings could not be saved in the future, it just seemed unneeded to save them for now.
 
@@ -427,6 +448,10 @@ ImGuiHandler::ImGuiHandler()
     // need at least one thread.
     cfg.exportThreadCount = 1u;
     cfg.parseThreadCount = std::max(totalThreadCount >> 1u, 1u);
+    cfg.mapStarpaks = false;
+    cfg.parsedDataStorage = eRamenStorage::RAMEN_STORAGE_AUTO;
+    cfg.parsedDataBudget = 2048u;
+    cfg.parsedDataSpillBudget = 0u;
 
     memset(pbEvents, 0, sizeof(pbEvents));
     for (int8_t i = PB_SIZE - 1; i >= 0; --i) // in reverse order
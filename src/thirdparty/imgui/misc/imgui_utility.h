@@ -83,6 +83,12 @@ public:
     {
         uint32_t parseThreadCount;
         uint32_t exportThreadCount;
+
+        bool mapStarpaks; // memory map starpaks on load instead of reading streamed data through buffers
+
+        uint32_t parsedDataStorage; // eRamenStorage used for parsed model and animation data
+        uint32_t parsedDataBudget; // in megabytes, for RAMEN_STORAGE_AUTO
+        uint32_t parsedDataSpillBudget; // in megabytes, parsed data past this gets spilled to disk. zero to keep everything in memory
     } cfg;
 
     struct FilterSettings_t